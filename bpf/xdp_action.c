@@ -0,0 +1,53 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/** @file
+ * @brief Minimal XDP programs
+ *
+ * XDP programs returning a fixed action, used to measure overhead of
+ * XDP fast path.
+ */
+
+#include <linux/bpf.h>
+#include <linux/if_ether.h>
+#include <bpf/bpf_helpers.h>
+
+/** Pass every packet to the network stack */
+SEC("xdp")
+int
+xdp_pass(struct xdp_md *ctx)
+{
+    return XDP_PASS;
+}
+
+/** Drop every packet */
+SEC("xdp")
+int
+xdp_drop(struct xdp_md *ctx)
+{
+    return XDP_DROP;
+}
+
+/**
+ * Send every packet back via the same interface, swapping source and
+ * destination MAC addresses so that it is accepted by the peer.
+ */
+SEC("xdp")
+int
+xdp_tx(struct xdp_md *ctx)
+{
+    void *data = (void *)(long)ctx->data;
+    void *data_end = (void *)(long)ctx->data_end;
+    struct ethhdr *eth = data;
+    unsigned char tmp[ETH_ALEN];
+
+    if ((void *)(eth + 1) > data_end)
+        return XDP_DROP;
+
+    __builtin_memcpy(tmp, eth->h_source, ETH_ALEN);
+    __builtin_memcpy(eth->h_source, eth->h_dest, ETH_ALEN);
+    __builtin_memcpy(eth->h_dest, tmp, ETH_ALEN);
+
+    return XDP_TX;
+}
+
+char _license[] SEC("license") = "Apache-2.0";
@@ -17,6 +17,8 @@
  *                       - @ref env-peer2peer
  *                       - @ref env-peer2peer_ipv6
  * @param flags          Ethtool reset flags to check.
+ * @param uring          If @c TRUE, send and receive data with io_uring
+ *                       to generate higher load.
  *
  * @par Scenario:
  *
@@ -48,6 +50,7 @@ main(int argc, char **argv)
     net_drv_flow tx_flow = NET_DRV_FLOW_INIT;
     net_drv_flow rx_flow = NET_DRV_FLOW_INIT;
     int flags;
+    te_bool uring;
 
     TEST_START;
     TEST_GET_PCO(iut_rpcs);
@@ -56,6 +59,7 @@ main(int argc, char **argv)
     TEST_GET_ADDR(tst_rpcs, tst_addr);
     TEST_GET_IF(iut_if);
     TEST_GET_BIT_MASK_PARAM(flags, NET_DRV_RESET_FLAGS);
+    TEST_GET_BOOL_PARAM(uring);
 
     if (iut_addr->sa_family == AF_INET6)
     {
@@ -85,6 +89,7 @@ main(int argc, char **argv)
     /* Send errors may happen during reset */
     tx_flow.ignore_send_err = TRUE;
     tx_flow.flow_id = 1;
+    tx_flow.use_uring = uring;
 
     memcpy(&rx_flow, &tx_flow, sizeof(tx_flow));
     rx_flow.flow_id = 2;
@@ -97,12 +102,12 @@ main(int argc, char **argv)
 
     TEST_STEP("Start sending UDP packets from IUT with help of "
               "@b rpc_pattern_sender() and receiving them on Tester "
-              "with help of @b rpc_drain_fd().");
+              "with help of @b rpc_drain_fd(). If @p uring is @c TRUE, "
+              "send and receive packets with io_uring instead.");
     net_drv_flow_start(&tx_flow);
 
-    TEST_STEP("Start sending UDP packets from Tester with help of "
-              "@b rpc_pattern_sender() and receiving them on IUT "
-              "with help of @b rpc_drain_fd().");
+    TEST_STEP("Start sending UDP packets from Tester and receiving "
+              "them on IUT in the same way.");
     net_drv_flow_start(&rx_flow);
 
     TEST_STEP("Wait for a while.");
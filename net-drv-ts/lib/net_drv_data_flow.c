@@ -14,6 +14,13 @@
 #include "tapi_rpc_client_server.h"
 #include "tapi_rpc_unistd.h"
 #include "te_str.h"
+#include "net_drv_rpc.h"
+
+/** Number of writes in flight when io_uring is used for sending */
+#define NET_DRV_FLOW_URING_DEPTH 32
+
+/** Number of receive buffers when io_uring is used for receiving */
+#define NET_DRV_FLOW_URING_BUFS 256
 
 /* See description in net_drv_data_flow.h */
 void
@@ -127,6 +134,24 @@ net_drv_flow_prepare(net_drv_flow *flow)
 void
 net_drv_flow_start(net_drv_flow *flow)
 {
+    if (flow->use_uring)
+    {
+        flow->receiver_rpcs->op = RCF_RPC_CALL;
+        rpc_net_drv_uring_recv(flow->receiver_rpcs, flow->receiver_s,
+                               flow->max_size, NET_DRV_FLOW_URING_BUFS,
+                               TE_SEC2MS(flow->duration + 1), NULL);
+
+        flow->in_progress = TRUE;
+
+        flow->sender_rpcs->op = RCF_RPC_CALL;
+        rpc_net_drv_uring_send(flow->sender_rpcs, flow->sender_s,
+                               flow->min_size, flow->max_size,
+                               NET_DRV_FLOW_URING_DEPTH,
+                               TE_SEC2MS(flow->duration),
+                               flow->ignore_send_err, NULL);
+        return;
+    }
+
     flow->receiver_rpcs->op = RCF_RPC_CALL;
     rpc_drain_fd_duration(flow->receiver_rpcs, flow->receiver_s,
                           flow->max_size, -1,
@@ -139,6 +164,69 @@ net_drv_flow_start(net_drv_flow *flow)
                        &flow->sender_ctx);
 }
 
+/**
+ * Wait until sending/receiving data with io_uring is finished,
+ * check results.
+ *
+ * @param flow    Pointer to net_drv_flow structure describing
+ *                the flow.
+ *
+ * @return @c TRUE on success, @c FALSE otherwise.
+ */
+static te_bool
+flow_finish_uring(net_drv_flow *flow)
+{
+    rcf_rpc_server *sender_rpcs = flow->sender_rpcs;
+    rcf_rpc_server *receiver_rpcs = flow->receiver_rpcs;
+    te_bool success = TRUE;
+    int64_t sent;
+    int64_t read;
+
+    RPC_AWAIT_ERROR(sender_rpcs);
+    sender_rpcs->timeout = TE_SEC2MS(flow->duration + 1);
+    sent = rpc_net_drv_uring_send(sender_rpcs, flow->sender_s,
+                                  flow->min_size, flow->max_size,
+                                  NET_DRV_FLOW_URING_DEPTH,
+                                  TE_SEC2MS(flow->duration),
+                                  flow->ignore_send_err, NULL);
+    if (sent < 0)
+    {
+        ERROR("rpc_net_drv_uring_send() failed on %s with error "
+              RPC_ERROR_FMT, sender_rpcs->name,
+              RPC_ERROR_ARGS(sender_rpcs));
+        success = FALSE;
+        sent = 0;
+    }
+    flow->uring_sent = sent;
+
+    RPC_AWAIT_ERROR(receiver_rpcs);
+    receiver_rpcs->timeout = TE_SEC2MS(flow->duration + 2);
+    read = rpc_net_drv_uring_recv(receiver_rpcs, flow->receiver_s,
+                                  flow->max_size, NET_DRV_FLOW_URING_BUFS,
+                                  TE_SEC2MS(flow->duration + 1), NULL);
+    if (read < 0)
+    {
+        ERROR("rpc_net_drv_uring_recv() failed on %s with error "
+              RPC_ERROR_FMT, receiver_rpcs->name,
+              RPC_ERROR_ARGS(receiver_rpcs));
+        success = FALSE;
+    }
+    else if (read == 0)
+    {
+        ERROR("rpc_net_drv_uring_recv() read no data on %s",
+              receiver_rpcs->name);
+        success = FALSE;
+    }
+    else if (success && read > sent)
+    {
+        ERROR("rpc_net_drv_uring_recv() read too much data on %s",
+              receiver_rpcs->name);
+        success = FALSE;
+    }
+
+    return success;
+}
+
 /* See description in net_drv_data_flow.h */
 void
 net_drv_flow_finish(net_drv_flow *flow)
@@ -153,6 +241,13 @@ net_drv_flow_finish(net_drv_flow *flow)
     rcf_rpc_server *receiver_rpcs = flow->receiver_rpcs;
     int receiver_s = flow->receiver_s;
 
+    if (flow->use_uring)
+    {
+        flow->success = flow_finish_uring(flow);
+        flow->in_progress = FALSE;
+        return;
+    }
+
     RPC_AWAIT_ERROR(sender_rpcs);
     sender_rpcs->timeout = TE_SEC2MS(sender_ctx->duration_sec + 1);
     rc = rpc_pattern_sender(sender_rpcs, sender_s, sender_ctx);
@@ -73,6 +73,12 @@ typedef struct net_drv_flow {
     te_bool ignore_send_err; /**< Whether to ignore send() errors */
     int min_size; /**< Minimum data size passed to send() */
     int max_size; /**< Maximum data dise passed to send() */
+    te_bool use_uring; /**< If @c TRUE, send and receive data with
+                            io_uring (see rpc_net_drv_uring_send() and
+                            rpc_net_drv_uring_recv()) to generate
+                            higher load, otherwise use
+                            rpc_pattern_sender() and
+                            rpc_drain_fd_duration() */
 
     /* Internal data */
     rcf_rpc_server *sender_rpcs; /**< Sender RPC server */
@@ -81,6 +87,7 @@ typedef struct net_drv_flow {
     int receiver_s; /**< Receiver socket */
     tapi_pat_sender sender_ctx; /**< Context for rpc_pattern_sender() */
     te_bool in_progress; /**< Set to @c TRUE while sending is in progress */
+    uint64_t uring_sent; /**< Number of bytes sent with io_uring */
 
     /* Output */
     te_bool success; /**< After net_drv_flow_finish() this field shows
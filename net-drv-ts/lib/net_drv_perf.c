@@ -0,0 +1,2140 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/** @file
+ * @brief Performance tests API
+ *
+ * Implementation of API shared by performance tests.
+ */
+
+/** Log user for this file */
+#define TE_LGR_USER "Library"
+
+#include <ctype.h>
+#include <math.h>
+#ifdef HAVE_JANSSON
+#include <jansson.h>
+#endif
+
+#include "net_drv_perf.h"
+#include "net_drv_ts.h"
+#include "net_drv_rpc.h"
+#include "tapi_test.h"
+#include "tapi_cfg_if.h"
+#include "tapi_cfg_if_chan.h"
+#include "tapi_cfg_if_coalesce.h"
+#include "tapi_cfg_if_rss.h"
+#include "tapi_cfg_base.h"
+#include "tad_common.h"
+#include "te_units.h"
+#include "te_time.h"
+#include "tapi_rpc_unistd.h"
+#include "tapi_ethtool.h"
+#include "te_str.h"
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_if_feature(const char *ta, const char *if_name,
+                            const char *feature_name, te_bool3 value)
+{
+    if (value != TE_BOOL3_UNKNOWN)
+        net_drv_set_if_feature(ta, if_name, feature_name,
+                               value == TE_BOOL3_FALSE ? 0 : 1);
+}
+
+/* See description in net_drv_perf.h */
+const char *
+net_drv_perf_tx_csum_feature(const char *ta, const char *if_name,
+                             int family)
+{
+    const char *feature;
+
+    feature = (family == AF_INET) ?
+              "tx-checksum-ipv4" : "tx-checksum-ipv6";
+    if (!net_drv_req_if_feature_configurable(ta, if_name, feature))
+        feature = "tx-checksum-ip-generic";
+
+    return feature;
+}
+
+/* See description in net_drv_perf.h */
+const char *
+net_drv_perf_tso_feature(int family)
+{
+    return (family == AF_INET) ?
+           "tx-tcp-segmentation" : "tx-tcp6-segmentation";
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_rx_coalesce(const char *ta, const char *if_name,
+                             int rx_coalesce_usecs,
+                             int rx_max_coalesced_frames)
+{
+    te_errno rc;
+
+    if (rx_coalesce_usecs == -1 && rx_max_coalesced_frames == -1)
+        return;
+
+    rc = tapi_cfg_if_coalesce_set(ta, if_name,
+                                  "use_adaptive_rx_coalesce", 0);
+    if (rc != 0)
+        TEST_VERDICT("Failed to set use_adaptive_rx_coalesce, rc=%r", rc);
+
+    if (rx_coalesce_usecs != -1)
+    {
+        CHECK_RC(tapi_cfg_if_coalesce_set_local(ta, if_name,
+                                                "rx_coalesce_usecs",
+                                                rx_coalesce_usecs));
+    }
+    if (rx_max_coalesced_frames != -1)
+    {
+        CHECK_RC(tapi_cfg_if_coalesce_set_local(ta, if_name,
+                                                "rx_max_coalesced_frames",
+                                                rx_max_coalesced_frames));
+    }
+
+    rc = tapi_cfg_if_coalesce_commit(ta, if_name);
+    if (TE_RC_GET_ERROR(rc) == TE_EOPNOTSUPP)
+        TEST_SKIP("Requested Rx coalesce settings are not supported");
+    if (rc != 0)
+        TEST_VERDICT("Failed to set rx_coalesce_usecs, rc=%r", rc);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_ring_size(const char *ta, const char *if_name,
+                           te_bool is_rx, int size)
+{
+    const char *ring = is_rx ? "Rx" : "Tx";
+    te_errno rc;
+
+    if (size == -1)
+        return;
+
+    if (size == 0)
+        rc = tapi_cfg_if_set_ring_size_to_max(ta, if_name, is_rx, NULL);
+    else
+        rc = tapi_cfg_if_set_ring_size(ta, if_name, is_rx, size);
+
+    if (TE_RC_GET_ERROR(rc) == TE_EOPNOTSUPP)
+        TEST_SKIP("Cannot change %s ring size", ring);
+    else if (rc != 0)
+        TEST_VERDICT("Failed to set %s ring size: %r", ring, rc);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_channels(const char *ta, const char *if_name,
+                          int channels)
+{
+    int rx_queues;
+    te_errno rc;
+
+    if (channels == -1)
+        return;
+
+    CHECK_RC(tapi_cfg_if_rss_rx_queues_get(ta, if_name, &rx_queues));
+
+    /*
+     * If number of Rx queues is going to decrease, make sure that
+     * RSS indirection table does not refer to removed queues.
+     */
+    if (rx_queues > channels)
+    {
+        CHECK_RC(tapi_cfg_if_rss_fill_indir_table(ta, if_name,
+                                                  0, 0, channels - 1));
+        CHECK_RC(tapi_cfg_if_rss_hash_indir_commit(ta, if_name, 0));
+    }
+
+    rc = tapi_cfg_if_chan_cur_set(ta, if_name,
+                                  TAPI_CFG_IF_CHAN_COMBINED, channels);
+    if (TE_RC_GET_ERROR(rc) == TE_EOPNOTSUPP)
+        TEST_SKIP("Cannot set number of combined channels");
+    else if (rc != 0)
+        TEST_VERDICT("Failed to set number of combined channels: %r", rc);
+
+    /* Make use of all the Rx queues available after the change. */
+    if (rx_queues < channels)
+    {
+        CHECK_RC(tapi_cfg_if_rss_fill_indir_table(ta, if_name,
+                                                  0, 0, channels - 1));
+        CHECK_RC(tapi_cfg_if_rss_hash_indir_commit(ta, if_name, 0));
+    }
+
+    CHECK_RC(tapi_cfg_if_rss_print_indir_table(ta, if_name, 0));
+}
+
+/**
+ * Add throughput of an interval to time series.
+ *
+ * @param series        Time series.
+ * @param interval      Interval between reports, in seconds.
+ * @param start         Start of the interval, in seconds.
+ * @param end           End of the interval, in seconds.
+ * @param bps           Throughput in the interval, bits per second.
+ */
+static void
+series_add_sample(te_vec *series, unsigned int interval,
+                  double start, double end, double bps)
+{
+    double zero = 0;
+    size_t idx;
+
+    /* Skip final summary which spans the whole test */
+    if (end - start > interval * 1.5)
+        return;
+
+    idx = (size_t)(start / interval + 0.5);
+    while (te_vec_size(series) <= idx)
+        TE_VEC_APPEND(series, zero);
+
+    TE_VEC_GET(double, series, idx) += bps;
+}
+
+/** Parse interval reports from JSON output of iperf3 */
+static te_errno
+parse_iperf3_intervals(const char *output, unsigned int interval,
+                       te_vec *series)
+{
+#ifndef HAVE_JANSSON
+    UNUSED(output);
+    UNUSED(interval);
+    UNUSED(series);
+
+    WARN("Test suite is built without jansson, iperf3 interval "
+         "reports are not parsed");
+    return 0;
+#else
+    json_error_t error;
+    json_t *root;
+    json_t *intervals;
+    json_t *item;
+    json_t *sum;
+    size_t i;
+
+    root = json_loads(output, 0, &error);
+    if (root == NULL)
+    {
+        ERROR("Failed to parse iperf3 JSON output: %s", error.text);
+        return TE_RC(TE_TAPI, TE_EINVAL);
+    }
+
+    intervals = json_object_get(root, "intervals");
+    if (!json_is_array(intervals))
+    {
+        ERROR("There are no interval reports in iperf3 output");
+        json_decref(root);
+        return TE_RC(TE_TAPI, TE_ENOENT);
+    }
+
+    json_array_foreach(intervals, i, item)
+    {
+        sum = json_object_get(item, "sum");
+        if (!json_is_object(sum) ||
+            json_is_true(json_object_get(sum, "omitted")))
+            continue;
+
+        series_add_sample(series, interval,
+                json_number_value(json_object_get(sum, "start")),
+                json_number_value(json_object_get(sum, "end")),
+                json_number_value(json_object_get(sum, "bits_per_second")));
+    }
+
+    json_decref(root);
+    return 0;
+#endif
+}
+
+/** Get multiplier for a rate unit printed by iperf */
+static double
+iperf_rate_mult(const char *unit)
+{
+    switch (unit[0])
+    {
+        case 'K':
+            return 1e3;
+
+        case 'M':
+            return 1e6;
+
+        case 'G':
+            return 1e9;
+
+        case 'T':
+            return 1e12;
+
+        default:
+            return 1;
+    }
+}
+
+/**
+ * Parse interval reports from text output of iperf. Per-stream lines
+ * look like
+ * "[  3]  0.0- 1.0 sec   112 MBytes   941 Mbits/sec ...",
+ * lines with "[SUM]" are skipped since streams are summed up anyway.
+ */
+static te_errno
+parse_iperf_intervals(const char *output, unsigned int interval,
+                      te_vec *series)
+{
+    const char *line = output;
+    const char *next;
+    char buf[256];
+    char bytes_unit[16];
+    char rate_unit[16];
+    double start;
+    double end;
+    double bytes;
+    double rate;
+    size_t len;
+
+    for (; line != NULL && *line != '\0'; line = next)
+    {
+        next = strchr(line, '\n');
+        len = (next == NULL) ? strlen(line) : (size_t)(next - line);
+        if (next != NULL)
+            next++;
+
+        if (len >= sizeof(buf) || line[0] != '[' ||
+            strncmp(line, "[SUM]", strlen("[SUM]")) == 0)
+            continue;
+
+        memcpy(buf, line, len);
+        buf[len] = '\0';
+
+        if (sscanf(buf, "[%*[^]]] %lf-%lf sec %lf %15s %lf %15s",
+                   &start, &end, &bytes, bytes_unit, &rate,
+                   rate_unit) != 6 ||
+            strstr(rate_unit, "bits/sec") == NULL)
+            continue;
+
+        series_add_sample(series, interval, start, end,
+                          rate * iperf_rate_mult(rate_unit));
+    }
+
+    return 0;
+}
+
+/* See description in net_drv_perf.h */
+te_errno
+net_drv_perf_add_intervals(tapi_perf_bench bench, const char *output,
+                           unsigned int interval, te_vec *series)
+{
+    if (output == NULL)
+        return TE_RC(TE_TAPI, TE_ENOENT);
+
+    switch (bench)
+    {
+        case TAPI_PERF_IPERF2:
+            return parse_iperf_intervals(output, interval, series);
+
+        case TAPI_PERF_IPERF3:
+            return parse_iperf3_intervals(output, interval, series);
+
+        default:
+            ERROR("Unsupported perf tool");
+            return TE_RC(TE_TAPI, TE_EOPNOTSUPP);
+    }
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_series_mi_log(te_mi_logger *logger, const char *name,
+                           const te_vec *series)
+{
+    size_t num = te_vec_size(series);
+    double min = 0;
+    double mean = 0;
+    double stdev = 0;
+    double val;
+    size_t i;
+
+    if (num == 0)
+    {
+        WARN("No interval reports for %s", name);
+        return;
+    }
+
+    for (i = 0; i < num; i++)
+    {
+        val = TE_VEC_GET(double, series, i);
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_THROUGHPUT, name,
+                              TE_MI_MEAS_AGGR_SINGLE, val,
+                              TE_MI_MEAS_MULTIPLIER_PLAIN);
+
+        mean += val;
+        if (i == 0 || val < min)
+            min = val;
+    }
+    mean /= num;
+
+    for (i = 0; i < num; i++)
+    {
+        val = TE_VEC_GET(double, series, i) - mean;
+        stdev += val * val;
+    }
+    stdev = sqrt(stdev / num);
+
+    te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+            TE_MI_MEAS(THROUGHPUT, name, MIN, min, PLAIN),
+            TE_MI_MEAS(THROUGHPUT, name, MEAN, mean, PLAIN),
+            TE_MI_MEAS(THROUGHPUT, name, STDEV, stdev, PLAIN)));
+
+    TEST_ARTIFACT("%s throughput over %zu intervals: min %.2f Mbps, "
+                  "mean %.2f Mbps, stddev %.2f Mbps", name, num,
+                  TE_UNITS_DEC_U2M(min), TE_UNITS_DEC_U2M(mean),
+                  TE_UNITS_DEC_U2M(stdev));
+}
+
+/**
+ * Read a file on a host.
+ *
+ * @param rpcs          RPC server.
+ * @param path          Path to the file.
+ * @param str           Where to save file contents.
+ */
+static void
+read_host_file(rcf_rpc_server *rpcs, const char *path, te_string *str)
+{
+    int fd;
+
+    te_string_reset(str);
+
+    fd = rpc_open(rpcs, path, RPC_O_RDONLY, 0);
+    rpc_read_fd2te_string(rpcs, fd, 0, 0, str);
+    rpc_close(rpcs, fd);
+}
+
+/**
+ * Read a file on a host if it exists and is readable.
+ *
+ * @param rpcs          RPC server.
+ * @param path          Path to the file.
+ * @param str           Where to save file contents.
+ *
+ * @return @c TRUE if the file was read, @c FALSE otherwise.
+ */
+static te_bool
+read_host_file_opt(rcf_rpc_server *rpcs, const char *path, te_string *str)
+{
+    int fd;
+
+    te_string_reset(str);
+
+    RPC_AWAIT_ERROR(rpcs);
+    fd = rpc_open(rpcs, path, RPC_O_RDONLY, 0);
+    if (fd < 0)
+        return FALSE;
+
+    rpc_read_fd2te_string(rpcs, fd, 0, 0, str);
+    rpc_close(rpcs, fd);
+
+    return TRUE;
+}
+
+/**
+ * Parse CPU line from /proc/stat which looks like
+ * "cpuN user nice system idle iowait irq softirq steal ...".
+ *
+ * @param line          Line after "cpu" or "cpuN" prefix.
+ * @param time          Where to save CPU time counters.
+ * @param softirq       Where to save softirq time (may be @c NULL).
+ *
+ * @return @c TRUE on success, @c FALSE if line cannot be parsed.
+ */
+static te_bool
+parse_cpu_line(const char *line, net_drv_cpu_time *time,
+               uint64_t *softirq)
+{
+    unsigned long long vals[8] = {};
+    int n;
+
+    n = sscanf(line, "%llu %llu %llu %llu %llu %llu %llu %llu",
+               &vals[0], &vals[1], &vals[2], &vals[3], &vals[4],
+               &vals[5], &vals[6], &vals[7]);
+    if (n < 4)
+        return FALSE;
+
+    /* idle and iowait are not busy time */
+    time->busy = vals[0] + vals[1] + vals[2] + vals[5] + vals[6] +
+                 vals[7];
+    time->total = time->busy + vals[3] + vals[4];
+    if (softirq != NULL)
+        *softirq = vals[6];
+
+    return TRUE;
+}
+
+/** Parse /proc/stat contents */
+static void
+parse_proc_stat(const char *buf, net_drv_cpu_stat *stat)
+{
+    const char *line;
+    net_drv_cpu_time cpu;
+    char *end;
+    char *p;
+
+    te_vec_reset(&stat->cpus);
+
+    for (line = buf; line != NULL && *line != '\0'; line = p)
+    {
+        p = strchr(line, '\n');
+        if (p != NULL)
+            p++;
+
+        if (strncmp(line, "cpu", strlen("cpu")) != 0)
+            continue;
+
+        line += strlen("cpu");
+        if (*line == ' ')
+        {
+            if (!parse_cpu_line(line, &stat->all, &stat->softirq))
+                TEST_FAIL("Failed to parse total CPU times");
+        }
+        else
+        {
+            cpu.id = strtoul(line, &end, 10);
+            if (!parse_cpu_line(end, &cpu, NULL))
+                TEST_FAIL("Failed to parse per-CPU times");
+
+            CHECK_RC(TE_VEC_APPEND(&stat->cpus, cpu));
+        }
+    }
+}
+
+/**
+ * Get sum over all CPUs of a softirq counter from /proc/softirqs
+ * contents.
+ */
+static uint64_t
+get_softirqs(const char *buf, const char *name)
+{
+    const char *p;
+    char *end;
+    uint64_t sum = 0;
+
+    for (p = strstr(buf, name); p != NULL && *p != '\n'; p = end)
+    {
+        while (*p != '\0' && *p != '\n' && !isdigit(*p))
+            p++;
+        if (!isdigit(*p))
+            break;
+
+        sum += strtoull(p, &end, 10);
+    }
+
+    return sum;
+}
+
+/** Get average CPU frequency from /proc/cpuinfo contents */
+static double
+get_cpu_mhz(const char *buf)
+{
+    const char *p;
+    double sum = 0;
+    unsigned int num = 0;
+
+    for (p = strstr(buf, "cpu MHz"); p != NULL;
+         p = strstr(p + 1, "cpu MHz"))
+    {
+        const char *colon = strchr(p, ':');
+
+        if (colon == NULL)
+            break;
+
+        sum += atof(colon + 1);
+        num++;
+    }
+
+    return num == 0 ? 0 : sum / num;
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_cpu_stat_get(rcf_rpc_server *rpcs, net_drv_cpu_stat *stat)
+{
+    te_string str = TE_STRING_INIT;
+
+    read_host_file(rpcs, "/proc/stat", &str);
+    CHECK_RC(te_gettimeofday(&stat->ts, NULL));
+    parse_proc_stat(te_string_value(&str), stat);
+
+    read_host_file(rpcs, "/proc/softirqs", &str);
+    stat->net_rx = get_softirqs(te_string_value(&str), "NET_RX:");
+    stat->net_tx = get_softirqs(te_string_value(&str), "NET_TX:");
+
+    read_host_file(rpcs, "/proc/cpuinfo", &str);
+    stat->mhz = get_cpu_mhz(te_string_value(&str));
+
+    te_string_free(&str);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_cpu_stat_free(net_drv_cpu_stat *stat)
+{
+    te_vec_free(&stat->cpus);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_cpu_usage_mi_log(te_mi_logger *logger, const char *name,
+                              const net_drv_cpu_stat *before,
+                              const net_drv_cpu_stat *after,
+                              double bytes, uint64_t packets)
+{
+    te_string str = TE_STRING_INIT;
+    te_string meas_name = TE_STRING_INIT;
+    size_t n_cpus = te_vec_size(&after->cpus);
+    uint64_t busy = after->all.busy - before->all.busy;
+    uint64_t total = after->all.total - before->all.total;
+    uint64_t softirq = after->softirq - before->softirq;
+    double util = 0;
+    double max_util = 0;
+    double softirq_share = 0;
+    double cycles;
+    size_t i;
+
+    if (total > 0)
+        util = (double)busy * 100 / total;
+    if (busy > 0)
+        softirq_share = (double)softirq * 100 / busy;
+
+    for (i = 0; i < n_cpus && i < te_vec_size(&before->cpus); i++)
+    {
+        net_drv_cpu_time cpu_before;
+        net_drv_cpu_time cpu_after;
+        uint64_t cpu_total;
+
+        cpu_before = TE_VEC_GET(net_drv_cpu_time, &before->cpus, i);
+        cpu_after = TE_VEC_GET(net_drv_cpu_time, &after->cpus, i);
+        cpu_total = cpu_after.total - cpu_before.total;
+        if (cpu_total > 0)
+        {
+            max_util = MAX(max_util,
+                           (double)(cpu_after.busy - cpu_before.busy) *
+                           100 / cpu_total);
+        }
+    }
+
+    te_string_append(&str, "%s CPU", name);
+    te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_CPU,
+                          te_string_value(&str), TE_MI_MEAS_AGGR_MEAN,
+                          util, TE_MI_MEAS_MULTIPLIER_PLAIN);
+    te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_CPU,
+                          te_string_value(&str), TE_MI_MEAS_AGGR_MAX,
+                          max_util, TE_MI_MEAS_MULTIPLIER_PLAIN);
+
+    te_string_reset(&str);
+    te_string_append(&str, "%s softirq share", name);
+    te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_CPU,
+                          te_string_value(&str), TE_MI_MEAS_AGGR_SINGLE,
+                          softirq_share, TE_MI_MEAS_MULTIPLIER_PLAIN);
+
+    te_string_reset(&str);
+    te_string_append(&str, "%s: CPU usage %.1f%% (busiest CPU %.1f%%), "
+                     "softirqs %.1f%% of busy time, NET_RX %" TE_PRINTF_64
+                     "u, NET_TX %" TE_PRINTF_64 "u", name, util, max_util,
+                     softirq_share, after->net_rx - before->net_rx,
+                     after->net_tx - before->net_tx);
+
+    /*
+     * Clock ticks are converted to time using wall time between
+     * snapshots to avoid dependency on USER_HZ of the host
+     * (microseconds multiplied by MHz give cycles).
+     */
+    if (after->mhz > 0 && total > 0)
+    {
+        cycles = (double)busy / total * n_cpus *
+                 TIMEVAL_SUB(after->ts, before->ts) * after->mhz;
+
+        if (bytes > 0)
+        {
+            te_string_append(&meas_name, "%s cycles per byte", name);
+            te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_CPU,
+                                  te_string_value(&meas_name),
+                                  TE_MI_MEAS_AGGR_SINGLE, cycles / bytes,
+                                  TE_MI_MEAS_MULTIPLIER_PLAIN);
+            te_string_append(&str, ", %.2f cycles/byte", cycles / bytes);
+        }
+        if (packets > 0)
+        {
+            te_string_reset(&meas_name);
+            te_string_append(&meas_name, "%s cycles per packet", name);
+            te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_CPU,
+                                  te_string_value(&meas_name),
+                                  TE_MI_MEAS_AGGR_SINGLE, cycles / packets,
+                                  TE_MI_MEAS_MULTIPLIER_PLAIN);
+            te_string_append(&str, ", %.0f cycles/packet",
+                             cycles / packets);
+        }
+    }
+
+    TEST_ARTIFACT("%s", te_string_value(&str));
+    te_string_free(&str);
+    te_string_free(&meas_name);
+}
+
+/* See description in net_drv_perf.h */
+double
+net_drv_perf_cpu_util(const net_drv_cpu_stat *before,
+                      const net_drv_cpu_stat *after, unsigned int cpu)
+{
+    const net_drv_cpu_time *cpu_before;
+    const net_drv_cpu_time *cpu_after;
+    size_t i;
+    size_t j;
+
+    for (i = 0; i < te_vec_size(&before->cpus); i++)
+    {
+        cpu_before = &TE_VEC_GET(net_drv_cpu_time, &before->cpus, i);
+        if (cpu_before->id != cpu)
+            continue;
+
+        for (j = 0; j < te_vec_size(&after->cpus); j++)
+        {
+            cpu_after = &TE_VEC_GET(net_drv_cpu_time, &after->cpus, j);
+            if (cpu_after->id != cpu)
+                continue;
+
+            if (cpu_after->total == cpu_before->total)
+                return 0;
+
+            return (double)(cpu_after->busy - cpu_before->busy) * 100 /
+                   (cpu_after->total - cpu_before->total);
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Get value of a field of meminfo file in bytes.
+ *
+ * @param buf           Contents of the file.
+ * @param name          Field name including colon (e.g. "MemFree:").
+ * @param value         Where to save the value.
+ *
+ * @return @c TRUE on success, @c FALSE if the field is not found.
+ */
+static te_bool
+get_meminfo_field(const char *buf, const char *name, uint64_t *value)
+{
+    const char *p = buf;
+    size_t len = strlen(name);
+
+    /* Lines of per-node meminfo start with "Node <N> " prefix */
+    while ((p = strstr(p, name)) != NULL)
+    {
+        if (p == buf || isspace(p[-1]))
+        {
+            *value = strtoull(p + len, NULL, 10) * 1024;
+            return TRUE;
+        }
+        p += len;
+    }
+
+    return FALSE;
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_mem_stat_get(rcf_rpc_server *rpcs, const char *if_name,
+                          net_drv_mem_stat *stat)
+{
+    te_string str = TE_STRING_INIT;
+    te_string path = TE_STRING_INIT;
+    uint64_t node_free;
+    unsigned int node;
+    int rc;
+
+    read_host_file(rpcs, "/proc/meminfo", &str);
+    if (!get_meminfo_field(te_string_value(&str), "MemFree:",
+                           &stat->mem_free) ||
+        !get_meminfo_field(te_string_value(&str), "Slab:", &stat->slab) ||
+        !get_meminfo_field(te_string_value(&str), "SUnreclaim:",
+                           &stat->slab_unreclaim))
+    {
+        TEST_FAIL("Failed to parse /proc/meminfo on %s", rpcs->ta);
+    }
+
+    te_vec_reset(&stat->node_free);
+    for (node = 0; ; node++)
+    {
+        te_string_reset(&path);
+        te_string_append(&path, "/sys/devices/system/node/node%u/meminfo",
+                         node);
+        if (!read_host_file_opt(rpcs, te_string_value(&path), &str) ||
+            !get_meminfo_field(te_string_value(&str), "MemFree:",
+                               &node_free))
+            break;
+
+        CHECK_RC(TE_VEC_APPEND(&stat->node_free, node_free));
+    }
+
+    stat->page_pool_mem = 0;
+    RPC_AWAIT_ERROR(rpcs);
+    rc = rpc_net_drv_page_pools(rpcs, if_name, NULL,
+                                &stat->page_pool_mem);
+    if (rc < 0)
+    {
+        WARN("Failed to get page pools of %s: " RPC_ERROR_FMT, if_name,
+             RPC_ERROR_ARGS(rpcs));
+    }
+    stat->page_pools = rc;
+
+    te_string_free(&str);
+    te_string_free(&path);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_mem_stat_free(net_drv_mem_stat *stat)
+{
+    te_vec_free(&stat->node_free);
+}
+
+/**
+ * Parse name of per-queue statistic.
+ *
+ * @param name          Statistic name.
+ * @param is_tx         Will be set to @c TRUE for Tx statistic.
+ * @param queue         Where to save queue number.
+ * @param is_bytes      Will be set to @c TRUE for bytes counter,
+ *                      to @c FALSE for packets counter.
+ *
+ * @return @c TRUE if the statistic is a per-queue packets or bytes
+ *         counter, @c FALSE otherwise.
+ */
+static te_bool
+parse_queue_stat_name(const char *name, te_bool *is_tx,
+                      unsigned long *queue, te_bool *is_bytes)
+{
+    static const char *prefixes[] = { "_queue_", "-", "" };
+    const char *p;
+    char *end;
+    unsigned int i;
+
+    if (strcmp_start("rx", name) == 0)
+        *is_tx = FALSE;
+    else if (strcmp_start("tx", name) == 0)
+        *is_tx = TRUE;
+    else
+        return FALSE;
+
+    name += strlen("rx");
+    for (i = 0; i < TE_ARRAY_LEN(prefixes); i++)
+    {
+        p = name + strlen(prefixes[i]);
+        if (strncmp(name, prefixes[i], strlen(prefixes[i])) == 0 &&
+            isdigit(*p))
+            break;
+    }
+    if (i == TE_ARRAY_LEN(prefixes))
+        return FALSE;
+
+    *queue = strtoul(p, &end, 10);
+    if (*end != '_' && *end != '.')
+        return FALSE;
+    end++;
+
+    if (strcmp(end, "packets") == 0)
+        *is_bytes = FALSE;
+    else if (strcmp(end, "bytes") == 0)
+        *is_bytes = TRUE;
+    else
+        return FALSE;
+
+    return TRUE;
+}
+
+/* See description in net_drv_perf.h */
+te_errno
+net_drv_perf_queue_stats_get(tapi_job_factory_t *factory,
+                             const char *if_name, te_vec *queues)
+{
+    tapi_ethtool_report report = tapi_ethtool_default_report;
+    tapi_ethtool_opt opts = tapi_ethtool_default_opt;
+    net_drv_queue_cnt zero_cnt = { 0, };
+    net_drv_queue_cnt *cnt;
+    te_kvpair *kv;
+    te_bool is_tx;
+    te_bool is_bytes;
+    unsigned long queue;
+    unsigned long val;
+    te_errno rc;
+
+    opts.cmd = TAPI_ETHTOOL_CMD_STATS;
+    opts.if_name = if_name;
+
+    rc = tapi_ethtool(factory, &opts, &report);
+    if (rc != 0)
+    {
+        ERROR("Failed to get statistics of %s with ethtool: %r",
+              if_name, rc);
+        return rc;
+    }
+
+    te_vec_reset(queues);
+
+    TAILQ_FOREACH(kv, &report.data.stats, links)
+    {
+        if (!parse_queue_stat_name(kv->key, &is_tx, &queue, &is_bytes))
+            continue;
+
+        rc = te_strtoul(kv->value, 10, &val);
+        if (rc != 0)
+            break;
+
+        while (te_vec_size(queues) <= queue)
+            TE_VEC_APPEND(queues, zero_cnt);
+
+        cnt = te_vec_get(queues, queue);
+        if (is_tx)
+        {
+            if (is_bytes)
+                cnt->tx_bytes = val;
+            else
+                cnt->tx_packets = val;
+        }
+        else
+        {
+            if (is_bytes)
+                cnt->rx_bytes = val;
+            else
+                cnt->rx_packets = val;
+        }
+    }
+
+    tapi_ethtool_destroy_report(&report);
+    return rc;
+}
+
+/**
+ * Compute maximum to mean ratio and Jain's fairness index
+ * (sum(x)^2 / (n * sum(x^2))) of values.
+ *
+ * @param vals          Values.
+ * @param n             Number of values.
+ * @param max_to_mean   Where to save maximum to mean ratio.
+ * @param fairness      Where to save fairness index.
+ */
+static void
+get_imbalance(const double *vals, unsigned int n, double *max_to_mean,
+              double *fairness)
+{
+    double sum = 0;
+    double sum_sq = 0;
+    double max = 0;
+    unsigned int i;
+
+    *max_to_mean = 0;
+    *fairness = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        sum += vals[i];
+        sum_sq += vals[i] * vals[i];
+        max = MAX(max, vals[i]);
+    }
+
+    if (sum > 0)
+    {
+        *max_to_mean = max * n / sum;
+        *fairness = sum * sum / (n * sum_sq);
+    }
+}
+
+/**
+ * Report per-queue rates and imbalance of packets over queues in one
+ * direction.
+ *
+ * @param logger        MI logger.
+ * @param if_name       Interface name.
+ * @param is_tx         Whether to report Tx or Rx queues.
+ * @param before        Counters before the benchmark.
+ * @param after         Counters after the benchmark.
+ * @param n_queues      Number of queues in use (@c 0 - all the queues
+ *                      reported by ethtool).
+ * @param duration      Duration of the benchmark, in seconds.
+ * @param log           Where to append human-readable statistics.
+ */
+static void
+queue_stats_dir_mi_log(te_mi_logger *logger, const char *if_name,
+                       te_bool is_tx, const te_vec *before,
+                       const te_vec *after, unsigned int n_queues,
+                       double duration, te_string *log)
+{
+    const char *dir = is_tx ? "Tx" : "Rx";
+    te_string name = TE_STRING_INIT;
+    double *pkts = NULL;
+    double max_to_mean;
+    double fairness;
+    uint64_t bytes;
+    unsigned int i;
+
+    if (n_queues == 0 || n_queues > te_vec_size(after))
+        n_queues = te_vec_size(after);
+    if (n_queues > te_vec_size(before))
+        n_queues = te_vec_size(before);
+
+    if (n_queues == 0)
+    {
+        WARN("No per-queue %s statistics for %s", dir, if_name);
+        return;
+    }
+
+    pkts = tapi_calloc(n_queues, sizeof(*pkts));
+
+    for (i = 0; i < n_queues; i++)
+    {
+        net_drv_queue_cnt cnt_before;
+        net_drv_queue_cnt cnt_after;
+
+        cnt_before = TE_VEC_GET(net_drv_queue_cnt, before, i);
+        cnt_after = TE_VEC_GET(net_drv_queue_cnt, after, i);
+
+        if (is_tx)
+        {
+            pkts[i] = cnt_after.tx_packets - cnt_before.tx_packets;
+            bytes = cnt_after.tx_bytes - cnt_before.tx_bytes;
+        }
+        else
+        {
+            pkts[i] = cnt_after.rx_packets - cnt_before.rx_packets;
+            bytes = cnt_after.rx_bytes - cnt_before.rx_bytes;
+        }
+
+        te_string_reset(&name);
+        te_string_append(&name, "%s queue %u %s", if_name, i, dir);
+        te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+                TE_MI_MEAS(PPS, te_string_value(&name), SINGLE,
+                           pkts[i] / duration, PLAIN),
+                TE_MI_MEAS(THROUGHPUT, te_string_value(&name), SINGLE,
+                           (double)bytes * 8 / duration, PLAIN)));
+
+        te_string_append(log, "%s queue %u: %.0f packets\n", dir, i,
+                         pkts[i]);
+    }
+
+    get_imbalance(pkts, n_queues, &max_to_mean, &fairness);
+
+    te_string_reset(&name);
+    te_string_append(&name, "%s %s queues max/mean", if_name, dir);
+    te_mi_logger_add_comment(logger, NULL, te_string_value(&name),
+                             "%.2f", max_to_mean);
+
+    te_string_reset(&name);
+    te_string_append(&name, "%s %s queues Jain fairness", if_name, dir);
+    te_mi_logger_add_comment(logger, NULL, te_string_value(&name),
+                             "%.3f", fairness);
+
+    TEST_ARTIFACT("%s: %u %s queues, max/mean %.2f, Jain fairness %.3f",
+                  if_name, n_queues, dir, max_to_mean, fairness);
+
+    free(pkts);
+    te_string_free(&name);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_queue_stats_mi_log(te_mi_logger *logger,
+                                const char *if_name,
+                                const te_vec *before, const te_vec *after,
+                                unsigned int n_rx_queues,
+                                unsigned int n_tx_queues,
+                                double duration)
+{
+    te_string log = TE_STRING_INIT;
+
+    queue_stats_dir_mi_log(logger, if_name, FALSE, before, after,
+                           n_rx_queues, duration, &log);
+    queue_stats_dir_mi_log(logger, if_name, TRUE, before, after,
+                           n_tx_queues, duration, &log);
+
+    RING("Per-queue packets of %s:\n%s", if_name, te_string_value(&log));
+    te_string_free(&log);
+}
+
+/* See description in net_drv_perf.h */
+unsigned int
+net_drv_perf_udp_payload_len(unsigned int frame_size, int family)
+{
+    unsigned int hdrs_len;
+
+    hdrs_len = NET_DRV_PERF_ETH_OVERHEAD + TAD_UDP_HDR_LEN +
+               (family == AF_INET ? TAD_IP4_HDR_LEN : TAD_IP6_HDR_LEN);
+
+    if (frame_size <= hdrs_len)
+    {
+        RING("Frame of %u bytes cannot fit UDP packet, minimum UDP "
+             "packets are used instead", frame_size);
+        return 1;
+    }
+
+    return frame_size - hdrs_len;
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_ensure_mtu(const char *ta, const char *if_name,
+                        unsigned int frame_size)
+{
+    unsigned int mtu = frame_size - NET_DRV_PERF_ETH_OVERHEAD;
+    unsigned int cur_mtu;
+    te_errno rc;
+
+    CHECK_RC(tapi_cfg_base_if_get_mtu_u(ta, if_name, &cur_mtu));
+    if (cur_mtu >= mtu)
+        return;
+
+    rc = tapi_cfg_base_if_set_mtu(ta, if_name, mtu, NULL);
+    if (rc != 0)
+        TEST_SKIP("Failed to set MTU %u on %s: %r", mtu, if_name, rc);
+}
+
+/**
+ * Sum per-CPU counters in a line of /proc/interrupts
+ * ("IRQ: cnt0 cnt1 ... cntN type name").
+ */
+static uint64_t
+sum_irq_line(const char *line)
+{
+    const char *p;
+    char *end;
+    uint64_t sum = 0;
+
+    p = strchr(line, ':');
+    if (p == NULL)
+        return 0;
+
+    for (p++; *p != '\0' && *p != '\n'; p = end)
+    {
+        while (*p == ' ')
+            p++;
+        if (!isdigit(*p))
+            break;
+
+        sum += strtoull(p, &end, 10);
+    }
+
+    return sum;
+}
+
+/**
+ * Check whether a line of /proc/interrupts belongs to an interface.
+ * Interface name should be a separate token in the line, i.e. it should
+ * not be preceded or followed by a letter or a digit, otherwise
+ * interrupts of eth10 or veth1 would be taken for interrupts of eth1.
+ *
+ * @param line          Line without IRQ number (starting after colon).
+ * @param end           End of the line (@c NULL if it is the last line).
+ * @param if_name       Interface name.
+ *
+ * @return @c TRUE if the line belongs to the interface.
+ */
+static te_bool
+irq_line_matches(const char *line, const char *end, const char *if_name)
+{
+    size_t len = strlen(if_name);
+    const char *p;
+
+    for (p = line; (p = strstr(p, if_name)) != NULL; p++)
+    {
+        if (end != NULL && p >= end)
+            break;
+
+        if ((p == line || !isalnum(p[-1])) && !isalnum(p[len]))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+/* See description in net_drv_perf.h */
+te_errno
+net_drv_perf_get_if_interrupts(rcf_rpc_server *rpcs, const char *if_name,
+                               uint64_t *count)
+{
+    te_string str = TE_STRING_INIT;
+    const char *p;
+    const char *next;
+    const char *colon;
+    te_bool found = FALSE;
+
+    read_host_file(rpcs, "/proc/interrupts", &str);
+
+    *count = 0;
+    for (p = te_string_value(&str); p != NULL && *p != '\0'; p = next)
+    {
+        next = strchr(p, '\n');
+        if (next != NULL)
+            next++;
+
+        colon = strchr(p, ':');
+        if (colon == NULL || (next != NULL && colon >= next))
+            continue;
+
+        if (irq_line_matches(colon + 1, next, if_name))
+        {
+            *count += sum_irq_line(p);
+            found = TRUE;
+        }
+    }
+
+    te_string_free(&str);
+
+    if (!found)
+    {
+        ERROR("No interrupts of %s were found in /proc/interrupts on %s",
+              if_name, rpcs->ta);
+        return TE_RC(TE_TAPI, TE_ENOENT);
+    }
+
+    return 0;
+}
+
+/* See description in net_drv_perf.h */
+int
+net_drv_perf_if_numa_node(rcf_rpc_server *rpcs, const char *if_name)
+{
+    te_string path = TE_STRING_INIT;
+    te_string str = TE_STRING_INIT;
+    int node = -1;
+
+    te_string_append(&path, "/sys/class/net/%s/device/numa_node", if_name);
+    if (read_host_file_opt(rpcs, te_string_value(&path), &str))
+        node = atoi(te_string_value(&str));
+
+    te_string_free(&path);
+    te_string_free(&str);
+
+    return node;
+}
+
+/**
+ * Get the first CPU an interrupt is routed to.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param irq           Interrupt number.
+ * @param cpu           Where to save CPU number.
+ *
+ * @return @c TRUE on success, @c FALSE if affinity cannot be obtained.
+ */
+static te_bool
+get_irq_cpu(rcf_rpc_server *rpcs, unsigned long irq, unsigned int *cpu)
+{
+    static const char *files[] = {
+        "effective_affinity_list", "smp_affinity_list",
+    };
+    te_string path = TE_STRING_INIT;
+    te_string str = TE_STRING_INIT;
+    te_bool found = FALSE;
+    unsigned int i;
+
+    for (i = 0; i < TE_ARRAY_LEN(files) && !found; i++)
+    {
+        te_string_reset(&path);
+        te_string_append(&path, "/proc/irq/%lu/%s", irq, files[i]);
+        if (read_host_file_opt(rpcs, te_string_value(&path), &str) &&
+            isdigit(*te_string_value(&str)))
+        {
+            *cpu = strtoul(te_string_value(&str), NULL, 10);
+            found = TRUE;
+        }
+    }
+
+    te_string_free(&path);
+    te_string_free(&str);
+
+    return found;
+}
+
+/**
+ * Get interrupts of an interface from @b /proc/interrupts.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param irqs          Where to save interrupt numbers (vector of
+ *                      @c unsigned @c long).
+ */
+static void
+get_if_irqs(rcf_rpc_server *rpcs, const char *if_name, te_vec *irqs)
+{
+    te_string str = TE_STRING_INIT;
+    const char *p;
+    const char *next;
+    unsigned long irq;
+    char *end;
+
+    te_vec_reset(irqs);
+    read_host_file(rpcs, "/proc/interrupts", &str);
+
+    for (p = te_string_value(&str); p != NULL && *p != '\0'; p = next)
+    {
+        next = strchr(p, '\n');
+        if (next != NULL)
+            next++;
+
+        while (*p == ' ')
+            p++;
+        if (!isdigit(*p))
+            continue;
+
+        irq = strtoul(p, &end, 10);
+        if (*end != ':')
+            continue;
+
+        if (!irq_line_matches(end + 1, next, if_name))
+            continue;
+
+        CHECK_RC(TE_VEC_APPEND(irqs, irq));
+    }
+
+    te_string_free(&str);
+}
+
+/* See description in net_drv_perf.h */
+te_errno
+net_drv_perf_if_irq_cpus(rcf_rpc_server *rpcs, const char *if_name,
+                         te_vec *cpus, te_vec *irqs)
+{
+    te_vec all_irqs = TE_VEC_INIT(unsigned long);
+    unsigned long irq;
+    unsigned int cpu;
+    unsigned int i;
+
+    te_vec_reset(cpus);
+    if (irqs != NULL)
+        te_vec_reset(irqs);
+    get_if_irqs(rpcs, if_name, &all_irqs);
+
+    for (i = 0; i < te_vec_size(&all_irqs); i++)
+    {
+        irq = TE_VEC_GET(unsigned long, &all_irqs, i);
+        if (get_irq_cpu(rpcs, irq, &cpu))
+        {
+            RING("Interrupt %lu of %s is handled by CPU %u",
+                 irq, if_name, cpu);
+            CHECK_RC(TE_VEC_APPEND(cpus, cpu));
+            if (irqs != NULL)
+                CHECK_RC(TE_VEC_APPEND(irqs, irq));
+        }
+    }
+
+    te_vec_free(&all_irqs);
+
+    return te_vec_size(cpus) == 0 ? TE_RC(TE_TAPI, TE_ENOENT) : 0;
+}
+
+/**
+ * Try to grab one of candidate CPUs.
+ *
+ * @param ta            Test Agent name.
+ * @param cands         Candidate CPUs (vector of @c tapi_cpu_index_t).
+ * @param cpu_id        Where to save grabbed CPU.
+ *
+ * @return Status code (@c TE_ENOENT if all candidates are busy).
+ */
+static te_errno
+grab_cpu_from(const char *ta, const te_vec *cands, tapi_cpu_index_t *cpu_id)
+{
+    const tapi_cpu_index_t *cand;
+    size_t i;
+
+    for (i = 0; i < te_vec_size(cands); i++)
+    {
+        cand = &TE_VEC_GET(tapi_cpu_index_t, cands, i);
+        if (tapi_cfg_cpu_grab_by_id(ta, cand) == 0)
+        {
+            *cpu_id = *cand;
+            return 0;
+        }
+    }
+
+    return TE_RC(TE_TAPI, TE_ENOENT);
+}
+
+/* See description in net_drv_perf.h */
+te_errno
+net_drv_perf_cpu_grab(rcf_rpc_server *rpcs, const char *if_name,
+                      net_drv_cpu_placement placement,
+                      tapi_cpu_index_t *cpu_id)
+{
+    tapi_cpu_index_t *threads = NULL;
+    size_t n_threads = 0;
+    te_vec irq_cpus = TE_VEC_INIT(unsigned int);
+    te_vec cands = TE_VEC_INIT(tapi_cpu_index_t);
+    unsigned int irq_cpu;
+    const tapi_cpu_index_t *irq_thread;
+    int node = -1;
+    size_t i;
+    size_t j;
+    size_t k;
+    te_errno rc;
+
+    if (placement == NET_DRV_CPU_PLACEMENT_LOCAL_NUMA ||
+        placement == NET_DRV_CPU_PLACEMENT_REMOTE_NUMA)
+    {
+        node = net_drv_perf_if_numa_node(rpcs, if_name);
+        if (node < 0)
+        {
+            if (placement == NET_DRV_CPU_PLACEMENT_REMOTE_NUMA)
+            {
+                RING("NUMA node of %s is not known, there is no remote "
+                     "NUMA node", if_name);
+                return TE_RC(TE_TAPI, TE_ENOENT);
+            }
+            placement = NET_DRV_CPU_PLACEMENT_ANY;
+        }
+    }
+
+    if (placement == NET_DRV_CPU_PLACEMENT_ANY)
+        return tapi_cfg_cpu_grab_by_prop(rpcs->ta, NULL, cpu_id);
+
+    rc = tapi_cfg_get_all_threads(rpcs->ta, &n_threads, &threads);
+    if (rc != 0)
+        return rc;
+
+    switch (placement)
+    {
+        case NET_DRV_CPU_PLACEMENT_LOCAL_NUMA:
+        case NET_DRV_CPU_PLACEMENT_REMOTE_NUMA:
+            for (i = 0; i < n_threads; i++)
+            {
+                if ((threads[i].node_id == (unsigned long)node) ==
+                    (placement == NET_DRV_CPU_PLACEMENT_LOCAL_NUMA))
+                    CHECK_RC(TE_VEC_APPEND(&cands, threads[i]));
+            }
+            break;
+
+        case NET_DRV_CPU_PLACEMENT_IRQ_CORE:
+        case NET_DRV_CPU_PLACEMENT_IRQ_SIBLING:
+            rc = net_drv_perf_if_irq_cpus(rpcs, if_name, &irq_cpus, NULL);
+            if (rc != 0)
+                break;
+
+            /* Candidates follow interrupts order to spread over queues */
+            for (k = 0; k < te_vec_size(&irq_cpus); k++)
+            {
+                irq_cpu = TE_VEC_GET(unsigned int, &irq_cpus, k);
+                irq_thread = NULL;
+                for (i = 0; i < n_threads; i++)
+                {
+                    if (threads[i].thread_id == irq_cpu)
+                        irq_thread = &threads[i];
+                }
+                if (irq_thread == NULL)
+                    continue;
+
+                if (placement == NET_DRV_CPU_PLACEMENT_IRQ_CORE)
+                {
+                    CHECK_RC(TE_VEC_APPEND(&cands, *irq_thread));
+                    continue;
+                }
+
+                for (j = 0; j < n_threads; j++)
+                {
+                    if (threads[j].node_id == irq_thread->node_id &&
+                        threads[j].package_id == irq_thread->package_id &&
+                        threads[j].core_id == irq_thread->core_id &&
+                        threads[j].thread_id != irq_thread->thread_id)
+                        CHECK_RC(TE_VEC_APPEND(&cands, threads[j]));
+                }
+            }
+            break;
+
+        default:
+            rc = TE_RC(TE_TAPI, TE_EINVAL);
+            break;
+    }
+
+    if (rc == 0)
+        rc = grab_cpu_from(rpcs->ta, &cands, cpu_id);
+
+    free(threads);
+    te_vec_free(&irq_cpus);
+    te_vec_free(&cands);
+
+    return rc;
+}
+
+/**
+ * Get CPUs of a host ordered for mapping queues to them: the first
+ * thread of every core, cores on NUMA node of an interface go first.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param cores         Where to save CPU numbers of cores (vector of
+ *                      @c unsigned @c int).
+ * @param all           Where to save all CPU numbers (vector of
+ *                      @c unsigned @c int).
+ */
+static void
+get_host_cpus(rcf_rpc_server *rpcs, const char *if_name, te_vec *cores,
+              te_vec *all)
+{
+    tapi_cpu_index_t *threads = NULL;
+    size_t n_threads = 0;
+    te_bool local_pass;
+    te_bool dup;
+    unsigned int cpu;
+    int node;
+    size_t i;
+    size_t j;
+
+    CHECK_RC(tapi_cfg_get_all_threads(rpcs->ta, &n_threads, &threads));
+    node = net_drv_perf_if_numa_node(rpcs, if_name);
+
+    te_vec_reset(cores);
+    te_vec_reset(all);
+
+    for (i = 0; i < n_threads; i++)
+    {
+        cpu = threads[i].thread_id;
+        CHECK_RC(TE_VEC_APPEND(all, cpu));
+    }
+
+    /* The first pass takes cores local to NIC, the second - others */
+    for (local_pass = TRUE; ; local_pass = FALSE)
+    {
+        for (i = 0; i < n_threads; i++)
+        {
+            if (node >= 0 &&
+                (threads[i].node_id == (unsigned long)node) != local_pass)
+                continue;
+            if (node < 0 && !local_pass)
+                continue;
+
+            for (j = 0, dup = FALSE; j < i && !dup; j++)
+            {
+                dup = threads[j].node_id == threads[i].node_id &&
+                      threads[j].package_id == threads[i].package_id &&
+                      threads[j].core_id == threads[i].core_id;
+            }
+            if (dup)
+                continue;
+
+            cpu = threads[i].thread_id;
+            CHECK_RC(TE_VEC_APPEND(cores, cpu));
+        }
+
+        if (!local_pass)
+            break;
+    }
+
+    free(threads);
+
+    if (te_vec_size(cores) == 0)
+        TEST_FAIL("No CPUs are found on %s", rpcs->ta);
+}
+
+/**
+ * Append hexadecimal CPU mask in format of sysfs (comma-separated
+ * 32-bit words, the most significant first) to a string.
+ *
+ * @param str           String.
+ * @param cpus          CPU numbers (vector of @c unsigned @c int).
+ */
+static void
+append_cpu_mask(te_string *str, const te_vec *cpus)
+{
+    uint32_t *words;
+    unsigned int n_words = 1;
+    unsigned int cpu;
+    unsigned int i;
+
+    for (i = 0; i < te_vec_size(cpus); i++)
+    {
+        cpu = TE_VEC_GET(unsigned int, cpus, i);
+        if (cpu / 32 + 1 > n_words)
+            n_words = cpu / 32 + 1;
+    }
+
+    words = tapi_calloc(n_words, sizeof(*words));
+    for (i = 0; i < te_vec_size(cpus); i++)
+    {
+        cpu = TE_VEC_GET(unsigned int, cpus, i);
+        words[cpu / 32] |= 1U << (cpu % 32);
+    }
+
+    te_string_append(str, "%x", words[n_words - 1]);
+    for (i = n_words - 1; i > 0; i--)
+        te_string_append(str, ",%08x", words[i - 1]);
+
+    free(words);
+}
+
+/**
+ * Get CPUs a queue should be mapped to.
+ *
+ * @param map           How to map queues to CPUs.
+ * @param queue         Queue index.
+ * @param cores         CPUs of cores, see get_host_cpus().
+ * @param all           All CPUs.
+ * @param cpus          Where to save CPUs of the queue.
+ */
+static void
+get_queue_cpus(net_drv_cpu_map map, unsigned int queue,
+               const te_vec *cores, const te_vec *all, te_vec *cpus)
+{
+    unsigned int cpu;
+
+    te_vec_reset(cpus);
+
+    switch (map)
+    {
+        case NET_DRV_CPU_MAP_OFF:
+            break;
+
+        case NET_DRV_CPU_MAP_SPREAD:
+            cpu = TE_VEC_GET(unsigned int, cores,
+                             queue % te_vec_size(cores));
+            CHECK_RC(TE_VEC_APPEND(cpus, cpu));
+            break;
+
+        case NET_DRV_CPU_MAP_SINGLE:
+            cpu = TE_VEC_GET(unsigned int, cores, 0);
+            CHECK_RC(TE_VEC_APPEND(cpus, cpu));
+            break;
+
+        case NET_DRV_CPU_MAP_ALL:
+            CHECK_RC(te_vec_append_vec(cpus, all));
+            break;
+
+        default:
+            TEST_FAIL("Unexpected CPU mapping %d", map);
+    }
+}
+
+/**
+ * Write a value to a sysfs or procfs file saving its original value.
+ * The test is skipped if the file cannot be read or written.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param path          Path to the file.
+ * @param value         Value to write.
+ * @param saved         Where to save original value.
+ */
+static void
+set_sys_value(rcf_rpc_server *rpcs, const char *path, const char *value,
+              te_vec *saved)
+{
+    te_string str = TE_STRING_INIT;
+    net_drv_sys_setting setting;
+    ssize_t len;
+    int fd;
+
+    if (!read_host_file_opt(rpcs, path, &str))
+        TEST_SKIP("Cannot read %s on %s", path, rpcs->ta);
+    te_string_chop(&str, " \n");
+
+    RPC_AWAIT_ERROR(rpcs);
+    fd = rpc_open(rpcs, path, RPC_O_WRONLY, 0);
+    if (fd < 0)
+    {
+        te_string_free(&str);
+        TEST_SKIP("Cannot open %s on %s for writing: %r", path, rpcs->ta,
+                  RPC_ERRNO(rpcs));
+    }
+
+    RPC_AWAIT_ERROR(rpcs);
+    len = rpc_write(rpcs, fd, value, strlen(value));
+    rpc_close(rpcs, fd);
+    if (len < 0)
+    {
+        te_string_free(&str);
+        TEST_SKIP("Cannot write '%s' to %s on %s: %r", value, path,
+                  rpcs->ta, RPC_ERRNO(rpcs));
+    }
+
+    RING("%s on %s is changed from '%s' to '%s'", path, rpcs->ta,
+         te_string_value(&str), value);
+
+    setting.path = tapi_strdup(path);
+    te_string_move(&setting.value, &str);
+    CHECK_RC(TE_VEC_APPEND(saved, setting));
+}
+
+/**
+ * Get number of queues of an interface of a given direction by
+ * checking which of @b /sys/class/net/<if>/queues/<dir>-<N>/<file>
+ * exist.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param dir           @c "rx" or @c "tx".
+ * @param file          File which should exist for every queue.
+ *
+ * @return Number of queues.
+ */
+static unsigned int
+get_sys_queues(rcf_rpc_server *rpcs, const char *if_name, const char *dir,
+               const char *file)
+{
+    te_string path = TE_STRING_INIT;
+    te_string str = TE_STRING_INIT;
+    unsigned int n;
+
+    for (n = 0; ; n++)
+    {
+        te_string_reset(&path);
+        te_string_append(&path, "/sys/class/net/%s/queues/%s-%u/%s",
+                         if_name, dir, n, file);
+        if (!read_host_file_opt(rpcs, te_string_value(&path), &str))
+            break;
+    }
+
+    te_string_free(&path);
+    te_string_free(&str);
+
+    return n;
+}
+
+/**
+ * Set CPU masks of all the queues of an interface in a given direction.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param dir           @c "rx" or @c "tx".
+ * @param file          Name of file with CPU mask.
+ * @param map           How to map queues to CPUs.
+ * @param saved         Where to save original settings.
+ */
+static void
+set_queues_cpu_mask(rcf_rpc_server *rpcs, const char *if_name,
+                    const char *dir, const char *file, net_drv_cpu_map map,
+                    te_vec *saved)
+{
+    te_vec cores = TE_VEC_INIT(unsigned int);
+    te_vec all = TE_VEC_INIT(unsigned int);
+    te_vec cpus = TE_VEC_INIT(unsigned int);
+    te_string path = TE_STRING_INIT;
+    te_string mask = TE_STRING_INIT;
+    unsigned int n_queues;
+    unsigned int i;
+
+    if (map == NET_DRV_CPU_MAP_DEFAULT)
+        return;
+
+    n_queues = get_sys_queues(rpcs, if_name, dir, file);
+    if (n_queues == 0)
+    {
+        TEST_SKIP("%s of %s queues of %s are not available",
+                  file, dir, if_name);
+    }
+
+    get_host_cpus(rpcs, if_name, &cores, &all);
+
+    for (i = 0; i < n_queues; i++)
+    {
+        get_queue_cpus(map, i, &cores, &all, &cpus);
+
+        te_string_reset(&path);
+        te_string_append(&path, "/sys/class/net/%s/queues/%s-%u/%s",
+                         if_name, dir, i, file);
+        te_string_reset(&mask);
+        append_cpu_mask(&mask, &cpus);
+
+        set_sys_value(rpcs, te_string_value(&path), te_string_value(&mask),
+                      saved);
+    }
+
+    te_vec_free(&cores);
+    te_vec_free(&all);
+    te_vec_free(&cpus);
+    te_string_free(&path);
+    te_string_free(&mask);
+}
+
+/**
+ * Get lists of CPUs to which interrupts of an interface should be
+ * routed.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param map           How to map interrupts to CPUs.
+ * @param irqs          Where to save interrupt numbers (vector of
+ *                      @c unsigned @c long).
+ * @param lists         Where to save CPU lists in smp_affinity_list
+ *                      format, one per interrupt (vector of
+ *                      @c te_string, should be released by caller).
+ */
+static void
+get_irq_affinity_lists(rcf_rpc_server *rpcs, const char *if_name,
+                       net_drv_cpu_map map, te_vec *irqs, te_vec *lists)
+{
+    te_vec cores = TE_VEC_INIT(unsigned int);
+    te_vec all = TE_VEC_INIT(unsigned int);
+    te_vec cpus = TE_VEC_INIT(unsigned int);
+    te_string list;
+    unsigned int i;
+    unsigned int j;
+
+    if (map == NET_DRV_CPU_MAP_OFF)
+        TEST_FAIL("Interrupts cannot be mapped to no CPUs");
+
+    get_if_irqs(rpcs, if_name, irqs);
+    if (te_vec_size(irqs) == 0)
+        TEST_SKIP("No interrupts of %s are found", if_name);
+
+    get_host_cpus(rpcs, if_name, &cores, &all);
+
+    for (i = 0; i < te_vec_size(irqs); i++)
+    {
+        get_queue_cpus(map, i, &cores, &all, &cpus);
+
+        list = (te_string)TE_STRING_INIT;
+        for (j = 0; j < te_vec_size(&cpus); j++)
+        {
+            te_string_append(&list, "%s%u", j == 0 ? "" : ",",
+                             TE_VEC_GET(unsigned int, &cpus, j));
+        }
+
+        CHECK_RC(TE_VEC_APPEND(lists, list));
+    }
+
+    te_vec_free(&cores);
+    te_vec_free(&all);
+    te_vec_free(&cpus);
+}
+
+/** Release vector of strings filled by get_irq_affinity_lists() */
+static void
+free_irq_affinity_lists(te_vec *lists)
+{
+    te_string *list;
+
+    TE_VEC_FOREACH(lists, list)
+        te_string_free(list);
+
+    te_vec_free(lists);
+}
+
+/** Compare CPU numbers, for qsort() */
+static int
+cpu_cmp(const void *a, const void *b)
+{
+    unsigned int cpu_a = *(const unsigned int *)a;
+    unsigned int cpu_b = *(const unsigned int *)b;
+
+    return (cpu_a > cpu_b) - (cpu_a < cpu_b);
+}
+
+/**
+ * Parse list of CPUs in smp_affinity_list format ("0-3,8,10-11").
+ *
+ * @param str           String to parse.
+ * @param cpus          Where to save CPUs (vector of @c unsigned @c int,
+ *                      sorted in ascending order).
+ *
+ * @return @c TRUE on success, @c FALSE if the string cannot be parsed.
+ */
+static te_bool
+parse_cpu_list(const char *str, te_vec *cpus)
+{
+    unsigned long first;
+    unsigned long last;
+    unsigned int cpu;
+    char *end;
+
+    te_vec_reset(cpus);
+
+    while (isdigit(*str))
+    {
+        first = strtoul(str, &end, 10);
+        last = first;
+        if (*end == '-')
+        {
+            str = end + 1;
+            last = strtoul(str, &end, 10);
+            if (end == str || last < first)
+                return FALSE;
+        }
+
+        for (cpu = first; cpu <= last; cpu++)
+            CHECK_RC(TE_VEC_APPEND(cpus, cpu));
+
+        str = end;
+        if (*str == ',')
+            str++;
+    }
+
+    if (te_vec_size(cpus) > 0)
+    {
+        qsort(te_vec_get(cpus, 0), te_vec_size(cpus), sizeof(unsigned int),
+              cpu_cmp);
+    }
+
+    return (*str == '\0' || isspace(*str));
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_irq_affinity(rcf_rpc_server *rpcs, const char *if_name,
+                              net_drv_cpu_map map, te_vec *saved)
+{
+    te_vec irqs = TE_VEC_INIT(unsigned long);
+    te_vec lists = TE_VEC_INIT(te_string);
+    te_string path = TE_STRING_INIT;
+    unsigned int i;
+
+    if (map == NET_DRV_CPU_MAP_DEFAULT)
+        return;
+
+    get_irq_affinity_lists(rpcs, if_name, map, &irqs, &lists);
+
+    for (i = 0; i < te_vec_size(&irqs); i++)
+    {
+        te_string_reset(&path);
+        te_string_append(&path, "/proc/irq/%lu/smp_affinity_list",
+                         TE_VEC_GET(unsigned long, &irqs, i));
+
+        set_sys_value(rpcs, te_string_value(&path),
+                      te_string_value(&TE_VEC_GET(te_string, &lists, i)),
+                      saved);
+    }
+
+    te_vec_free(&irqs);
+    free_irq_affinity_lists(&lists);
+    te_string_free(&path);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_check_irq_affinity(rcf_rpc_server *rpcs, const char *if_name,
+                                net_drv_cpu_map map)
+{
+    te_vec irqs = TE_VEC_INIT(unsigned long);
+    te_vec lists = TE_VEC_INIT(te_string);
+    te_vec exp_cpus = TE_VEC_INIT(unsigned int);
+    te_vec cur_cpus = TE_VEC_INIT(unsigned int);
+    te_string path = TE_STRING_INIT;
+    te_string str = TE_STRING_INIT;
+    const char *exp_list;
+    unsigned long irq;
+    te_bool changed = FALSE;
+    unsigned int i;
+
+    if (map == NET_DRV_CPU_MAP_DEFAULT)
+        return;
+
+    get_irq_affinity_lists(rpcs, if_name, map, &irqs, &lists);
+
+    for (i = 0; i < te_vec_size(&irqs); i++)
+    {
+        irq = TE_VEC_GET(unsigned long, &irqs, i);
+        exp_list = te_string_value(&TE_VEC_GET(te_string, &lists, i));
+
+        te_string_reset(&path);
+        te_string_append(&path, "/proc/irq/%lu/smp_affinity_list", irq);
+        read_host_file(rpcs, te_string_value(&path), &str);
+
+        if (!parse_cpu_list(exp_list, &exp_cpus) ||
+            !parse_cpu_list(te_string_value(&str), &cur_cpus))
+        {
+            TEST_FAIL("Failed to parse affinity of IRQ %lu", irq);
+        }
+
+        if (te_vec_size(&exp_cpus) != te_vec_size(&cur_cpus) ||
+            memcmp(te_vec_get(&exp_cpus, 0), te_vec_get(&cur_cpus, 0),
+                   te_vec_size(&exp_cpus) * sizeof(unsigned int)) != 0)
+        {
+            ERROR("Affinity of IRQ %lu of %s was changed from %s to %s",
+                  irq, if_name, exp_list, te_string_value(&str));
+            changed = TRUE;
+        }
+    }
+
+    te_vec_free(&irqs);
+    free_irq_affinity_lists(&lists);
+    te_vec_free(&exp_cpus);
+    te_vec_free(&cur_cpus);
+    te_string_free(&path);
+    te_string_free(&str);
+
+    if (changed)
+    {
+        TEST_VERDICT("Interrupts affinity of IUT interface was changed "
+                     "during the test, probably by irqbalance");
+    }
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_rps(rcf_rpc_server *rpcs, const char *if_name,
+                     net_drv_cpu_map map, te_vec *saved)
+{
+    set_queues_cpu_mask(rpcs, if_name, "rx", "rps_cpus", map, saved);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_rfs(rcf_rpc_server *rpcs, const char *if_name,
+                     int flow_entries, te_vec *saved)
+{
+    te_string path = TE_STRING_INIT;
+    te_string value = TE_STRING_INIT;
+    unsigned int n_queues;
+    unsigned int i;
+
+    if (flow_entries < 0)
+        return;
+
+    n_queues = get_sys_queues(rpcs, if_name, "rx", "rps_flow_cnt");
+    if (n_queues == 0)
+        TEST_SKIP("RFS is not available for %s", if_name);
+
+    te_string_append(&value, "%d", flow_entries);
+    set_sys_value(rpcs, "/proc/sys/net/core/rps_sock_flow_entries",
+                  te_string_value(&value), saved);
+
+    for (i = 0; i < n_queues; i++)
+    {
+        te_string_reset(&path);
+        te_string_append(&path,
+                         "/sys/class/net/%s/queues/rx-%u/rps_flow_cnt",
+                         if_name, i);
+        te_string_reset(&value);
+        te_string_append(&value, "%u", flow_entries / n_queues);
+
+        set_sys_value(rpcs, te_string_value(&path),
+                      te_string_value(&value), saved);
+    }
+
+    te_string_free(&path);
+    te_string_free(&value);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_xps(rcf_rpc_server *rpcs, const char *if_name,
+                     net_drv_cpu_map map, te_vec *saved)
+{
+    set_queues_cpu_mask(rpcs, if_name, "tx", "xps_cpus", map, saved);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_restore_sys(rcf_rpc_server *rpcs, te_vec *saved)
+{
+    net_drv_sys_setting *setting;
+    ssize_t len;
+    size_t i;
+    int fd;
+
+    for (i = te_vec_size(saved); i > 0; i--)
+    {
+        setting = te_vec_get(saved, i - 1);
+
+        RPC_AWAIT_ERROR(rpcs);
+        fd = rpc_open(rpcs, setting->path, RPC_O_WRONLY, 0);
+        if (fd < 0)
+        {
+            WARN("Failed to open %s to restore it: %r", setting->path,
+                 RPC_ERRNO(rpcs));
+        }
+        else
+        {
+            RPC_AWAIT_ERROR(rpcs);
+            len = rpc_write(rpcs, fd, setting->value,
+                            strlen(setting->value));
+            if (len < 0)
+            {
+                WARN("Failed to restore '%s' in %s: %r", setting->value,
+                     setting->path, RPC_ERRNO(rpcs));
+            }
+            RPC_AWAIT_ERROR(rpcs);
+            rpc_close(rpcs, fd);
+        }
+
+        free(setting->path);
+        free(setting->value);
+    }
+
+    te_vec_free(saved);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_napi_defer(rcf_rpc_server *rpcs, const char *if_name,
+                            int defer_hard_irqs, int gro_flush_timeout,
+                            te_vec *saved)
+{
+    te_string path = TE_STRING_INIT;
+    te_string value = TE_STRING_INIT;
+
+    if (defer_hard_irqs >= 0)
+    {
+        te_string_append(&path, "/sys/class/net/%s/napi_defer_hard_irqs",
+                         if_name);
+        te_string_append(&value, "%d", defer_hard_irqs);
+        set_sys_value(rpcs, te_string_value(&path), te_string_value(&value),
+                      saved);
+    }
+
+    if (gro_flush_timeout >= 0)
+    {
+        te_string_reset(&path);
+        te_string_append(&path, "/sys/class/net/%s/gro_flush_timeout",
+                         if_name);
+        te_string_reset(&value);
+        te_string_append(&value, "%d", gro_flush_timeout);
+        set_sys_value(rpcs, te_string_value(&path), te_string_value(&value),
+                      saved);
+    }
+
+    te_string_free(&path);
+    te_string_free(&value);
+}
+
+/* See description in net_drv_perf.h */
+void
+net_drv_perf_set_threaded_napi(rcf_rpc_server *rpcs, const char *if_name,
+                               te_bool3 threaded, te_vec *saved)
+{
+    te_string path = TE_STRING_INIT;
+
+    if (threaded == TE_BOOL3_UNKNOWN)
+        return;
+
+    te_string_append(&path, "/sys/class/net/%s/threaded", if_name);
+    set_sys_value(rpcs, te_string_value(&path),
+                  threaded == TE_BOOL3_TRUE ? "1" : "0", saved);
+    te_string_free(&path);
+}
+
+/* See description in net_drv_perf.h */
+te_bool
+net_drv_perf_set_big_tcp(rcf_rpc_server *rpcs, const char *if_name,
+                         int family, te_bool3 big_tcp,
+                         net_drv_gso_limits *orig)
+{
+    unsigned int gso_max_size = NET_DRV_GSO_LEGACY_SIZE;
+    unsigned int gro_max_size = NET_DRV_GSO_LEGACY_SIZE;
+    te_errno rc;
+
+    if (big_tcp == TE_BOOL3_UNKNOWN)
+        return FALSE;
+
+    rc = net_drv_get_gso_limits(rpcs, if_name, family, orig);
+    if (rc != 0)
+        TEST_SKIP("BIG TCP is not supported on %s: %r", rpcs->ta, rc);
+
+    if (big_tcp == TE_BOOL3_TRUE)
+    {
+        if (orig->tso_max_size <= NET_DRV_GSO_LEGACY_SIZE)
+        {
+            TEST_SKIP("Driver of %s does not support TSO packets larger "
+                      "than 64KB", if_name);
+        }
+
+        gso_max_size = MIN(orig->tso_max_size, NET_DRV_BIG_TCP_SIZE);
+        gro_max_size = NET_DRV_BIG_TCP_SIZE;
+    }
+
+    CHECK_RC(net_drv_set_gso_limits(rpcs, if_name, family, gso_max_size,
+                                    gro_max_size));
+    return TRUE;
+}
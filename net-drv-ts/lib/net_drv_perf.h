@@ -0,0 +1,651 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/** @file
+ * @brief Performance tests API
+ *
+ * Declarations of API shared by performance tests.
+ */
+
+#ifndef __TS_NET_DRV_PERF_H__
+#define __TS_NET_DRV_PERF_H__
+
+#include "te_config.h"
+
+#include "te_defs.h"
+#include "te_vector.h"
+#include "te_mi_log.h"
+#include "tapi_performance.h"
+#include "rcf_rpc.h"
+#include "tapi_job_factory_rpc.h"
+#include "tapi_cfg_cpu.h"
+
+/**
+ * The list of values allowed for parameter of type 'bool_with_default'
+ */
+#define BOOL_WITH_DEFAULT_MAPPING_LIST  \
+    { "DEFAULT", TE_BOOL3_UNKNOWN },    \
+    { "FALSE",   TE_BOOL3_FALSE },      \
+    { "TRUE",    TE_BOOL3_TRUE }
+
+/**
+ * Get the value of parameter of type 'bool_with_default'
+ *
+ * @param var_name_  Name of the variable used to get the value of
+ *                   "var_name_" parameter of type 'bool_with_default' (OUT)
+ */
+#define TEST_GET_BOOL_WITH_DEFAULT(var_name_) \
+    TEST_GET_ENUM_PARAM(var_name_, BOOL_WITH_DEFAULT_MAPPING_LIST)
+
+/**
+ * Set interface feature if a 'bool_with_default' parameter value is
+ * not @c TE_BOOL3_UNKNOWN, otherwise keep the current state.
+ * The test is skipped if the feature cannot be set.
+ *
+ * @param ta            Test Agent name
+ * @param if_name       Interface name
+ * @param feature_name  Feature name
+ * @param value         Requested feature state
+ */
+extern void net_drv_perf_set_if_feature(const char *ta,
+                                        const char *if_name,
+                                        const char *feature_name,
+                                        te_bool3 value);
+
+/**
+ * Get name of the interface feature controlling Tx checksum offload
+ * for a given address family. If address family specific feature
+ * cannot be configured, @b tx-checksum-ip-generic is returned.
+ *
+ * @param ta            Test Agent name
+ * @param if_name       Interface name
+ * @param family        Address family (@c AF_INET or @c AF_INET6)
+ *
+ * @return Feature name.
+ */
+extern const char *net_drv_perf_tx_csum_feature(const char *ta,
+                                                const char *if_name,
+                                                int family);
+
+/**
+ * Get name of the interface feature controlling TSO for a given
+ * address family.
+ *
+ * @param family        Address family (@c AF_INET or @c AF_INET6)
+ *
+ * @return Feature name.
+ */
+extern const char *net_drv_perf_tso_feature(int family);
+
+/**
+ * Configure Rx interrupt coalescing on an interface. If any of the
+ * values is not @c -1, adaptive Rx coalescing is disabled first.
+ * The test is skipped if requested settings are not supported.
+ *
+ * @param ta                        Test Agent name
+ * @param if_name                   Interface name
+ * @param rx_coalesce_usecs         Value of @b rx_coalesce_usecs
+ *                                  (@c -1 to keep the current one)
+ * @param rx_max_coalesced_frames   Value of @b rx_max_coalesced_frames
+ *                                  (@c -1 to keep the current one)
+ */
+extern void net_drv_perf_set_rx_coalesce(const char *ta,
+                                         const char *if_name,
+                                         int rx_coalesce_usecs,
+                                         int rx_max_coalesced_frames);
+
+/**
+ * Set Rx or Tx ring size on an interface.
+ * The test is skipped if ring size cannot be changed.
+ *
+ * @param ta            Test Agent name
+ * @param if_name       Interface name
+ * @param is_rx         @c TRUE for Rx ring, @c FALSE for Tx ring
+ * @param size          Ring size (@c -1 to keep the current one,
+ *                      @c 0 to set maximum)
+ */
+extern void net_drv_perf_set_ring_size(const char *ta,
+                                       const char *if_name,
+                                       te_bool is_rx, int size);
+
+/**
+ * Set number of combined channels on an interface, updating RSS
+ * indirection table so that only Rx queues existing after the change
+ * are used. The test is skipped if number of channels cannot be
+ * changed.
+ *
+ * @param ta            Test Agent name
+ * @param if_name       Interface name
+ * @param channels      Number of combined channels (@c -1 to keep
+ *                      the current one)
+ */
+extern void net_drv_perf_set_channels(const char *ta,
+                                      const char *if_name,
+                                      int channels);
+
+/**
+ * Interval between reports printed by perf tools, in seconds.
+ * Reports are printed every interval, which also forces server
+ * to print a report at the end of test even if it lost connection
+ * with client (iperf tool issue, Bug 9714).
+ */
+#define NET_DRV_PERF_INTERVAL_SEC 1
+
+/**
+ * Parse interval reports from output of a perf tool (iperf or iperf3
+ * in JSON mode) and add throughput observed in every interval to
+ * a time series. If there are several streams, their throughput is
+ * summed up. Final summary reports are ignored. If the test suite
+ * is built without jansson, iperf3 reports are not parsed and
+ * the series is left untouched.
+ *
+ * @param bench         Perf tool.
+ * @param output        Output of the perf tool.
+ * @param interval      Interval between reports, in seconds.
+ * @param series        Time series (vector of @c double values in
+ *                      bits per second) to which throughput of every
+ *                      interval is added. It is extended if necessary.
+ *
+ * @return Status code.
+ */
+extern te_errno net_drv_perf_add_intervals(tapi_perf_bench bench,
+                                           const char *output,
+                                           unsigned int interval,
+                                           te_vec *series);
+
+/**
+ * Add throughput time series to MI logger as a vector of measurements
+ * together with its minimum, mean and standard deviation; also print
+ * a test artifact with these values.
+ *
+ * @param logger        MI logger.
+ * @param name          Name of the measurement.
+ * @param series        Time series (vector of @c double values in
+ *                      bits per second).
+ */
+extern void net_drv_perf_series_mi_log(te_mi_logger *logger,
+                                       const char *name,
+                                       const te_vec *series);
+
+/** CPU time counters of a single CPU, in clock ticks */
+typedef struct net_drv_cpu_time {
+    unsigned int id;    /**< CPU number (not set for counters summed
+                             over all CPUs) */
+    uint64_t busy;      /**< Time spent not in idle or iowait */
+    uint64_t total;     /**< Total time */
+} net_drv_cpu_time;
+
+/** Snapshot of CPU usage counters of a host */
+typedef struct net_drv_cpu_stat {
+    struct timeval ts;          /**< When the snapshot was taken */
+    net_drv_cpu_time all;       /**< Counters summed over all CPUs */
+    uint64_t softirq;           /**< Time spent in softirqs, in clock
+                                     ticks */
+    te_vec cpus;                /**< Counters of every CPU
+                                     (net_drv_cpu_time) */
+    uint64_t net_rx;            /**< Number of @c NET_RX softirqs */
+    uint64_t net_tx;            /**< Number of @c NET_TX softirqs */
+    double mhz;                 /**< Average CPU frequency, in MHz
+                                     (@c 0 if unknown) */
+} net_drv_cpu_stat;
+
+/** Initializer for net_drv_cpu_stat */
+#define NET_DRV_CPU_STAT_INIT { .cpus = TE_VEC_INIT(net_drv_cpu_time) }
+
+/**
+ * Get snapshot of CPU usage counters of a host from @b /proc/stat,
+ * @b /proc/softirqs and @b /proc/cpuinfo.
+ * The test fails if the counters cannot be obtained.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param stat          Where to save the snapshot (should be
+ *                      initialized with @ref NET_DRV_CPU_STAT_INIT).
+ */
+extern void net_drv_perf_cpu_stat_get(rcf_rpc_server *rpcs,
+                                      net_drv_cpu_stat *stat);
+
+/**
+ * Release memory allocated for CPU usage snapshot.
+ *
+ * @param stat          CPU usage snapshot.
+ */
+extern void net_drv_perf_cpu_stat_free(net_drv_cpu_stat *stat);
+
+/**
+ * Compute CPU usage between two snapshots and report it as MI
+ * measurements and a test artifact: total CPU utilisation, utilisation
+ * of the busiest CPU, share of softirqs in busy time and (if CPU
+ * frequency is known) CPU cycles spent per byte and per packet.
+ *
+ * @param logger        MI logger.
+ * @param name          Name of the host (e.g. "Server").
+ * @param before        Snapshot taken before the benchmark.
+ * @param after         Snapshot taken after the benchmark.
+ * @param bytes         Number of bytes processed by the host.
+ * @param packets       Number of packets processed by the host.
+ */
+extern void net_drv_perf_cpu_usage_mi_log(te_mi_logger *logger,
+                                          const char *name,
+                                          const net_drv_cpu_stat *before,
+                                          const net_drv_cpu_stat *after,
+                                          double bytes, uint64_t packets);
+
+/**
+ * Compute utilisation of a CPU between two snapshots.
+ *
+ * @param before        Snapshot taken before the benchmark.
+ * @param after         Snapshot taken after the benchmark.
+ * @param cpu           CPU number.
+ *
+ * @return Utilisation in percent or @c -1 if there are no counters
+ *         of the CPU.
+ */
+extern double net_drv_perf_cpu_util(const net_drv_cpu_stat *before,
+                                    const net_drv_cpu_stat *after,
+                                    unsigned int cpu);
+
+/** Snapshot of memory usage of a host */
+typedef struct net_drv_mem_stat {
+    uint64_t mem_free;          /**< Free memory (@b MemFree), bytes */
+    uint64_t slab;              /**< Slab allocator memory (@b Slab),
+                                     bytes */
+    uint64_t slab_unreclaim;    /**< Unreclaimable slab memory
+                                     (@b SUnreclaim), bytes */
+    te_vec node_free;           /**< Free memory of every NUMA node
+                                     (uint64_t), bytes */
+    int page_pools;             /**< Number of page pools of
+                                     the interface (@c -1 if unknown) */
+    uint64_t page_pool_mem;     /**< Memory held by page pools of
+                                     the interface, bytes */
+} net_drv_mem_stat;
+
+/** Initializer for net_drv_mem_stat */
+#define NET_DRV_MEM_STAT_INIT \
+    { .node_free = TE_VEC_INIT(uint64_t), .page_pools = -1 }
+
+/**
+ * Get snapshot of memory usage of a host from @b /proc/meminfo and
+ * @b /sys/devices/system/node/node<N>/meminfo, and of page pools of
+ * an interface (if kernel reports them over netlink).
+ * The test fails if @b /proc/meminfo cannot be parsed.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param stat          Where to save the snapshot (should be
+ *                      initialized with @ref NET_DRV_MEM_STAT_INIT).
+ */
+extern void net_drv_perf_mem_stat_get(rcf_rpc_server *rpcs,
+                                      const char *if_name,
+                                      net_drv_mem_stat *stat);
+
+/**
+ * Release memory allocated for memory usage snapshot.
+ *
+ * @param stat          Memory usage snapshot.
+ */
+extern void net_drv_perf_mem_stat_free(net_drv_mem_stat *stat);
+
+/** Counters of a single Rx/Tx queue pair */
+typedef struct net_drv_queue_cnt {
+    uint64_t rx_packets;    /**< Received packets */
+    uint64_t rx_bytes;      /**< Received bytes */
+    uint64_t tx_packets;    /**< Sent packets */
+    uint64_t tx_bytes;      /**< Sent bytes */
+} net_drv_queue_cnt;
+
+/**
+ * Get per-queue counters of an interface from output of
+ * @b ethtool @b -S. Statistics named like @b rx_queue_N_packets,
+ * @b rx-N.packets or @b rxN_packets (and the same for bytes and Tx)
+ * are taken into account.
+ *
+ * @param factory       Job factory to run ethtool.
+ * @param if_name       Interface name.
+ * @param queues        Where to save counters (vector of
+ *                      net_drv_queue_cnt indexed by queue number,
+ *                      initialized with TE_VEC_INIT()).
+ *
+ * @return Status code.
+ */
+extern te_errno net_drv_perf_queue_stats_get(tapi_job_factory_t *factory,
+                                             const char *if_name,
+                                             te_vec *queues);
+
+/**
+ * Report changes of per-queue counters to MI: packet and bit rate of
+ * every queue as measurements, maximum to mean ratio and Jain's fairness
+ * index of received and sent packets over queues as comments.
+ *
+ * @param logger        MI logger.
+ * @param if_name       Interface name.
+ * @param before        Counters before the benchmark.
+ * @param after         Counters after the benchmark.
+ * @param n_rx_queues   Number of Rx queues in use (@c 0 - all the
+ *                      queues reported by ethtool).
+ * @param n_tx_queues   Number of Tx queues in use (@c 0 - all the
+ *                      queues reported by ethtool).
+ * @param duration      Duration of the benchmark, in seconds.
+ */
+extern void net_drv_perf_queue_stats_mi_log(te_mi_logger *logger,
+                                            const char *if_name,
+                                            const te_vec *before,
+                                            const te_vec *after,
+                                            unsigned int n_rx_queues,
+                                            unsigned int n_tx_queues,
+                                            double duration);
+
+/** Size of Ethernet header and FCS */
+#define NET_DRV_PERF_ETH_OVERHEAD 18
+
+/**
+ * Get size of UDP payload of a packet sent in Ethernet frame of
+ * a given size (including FCS). If such frame cannot fit UDP packet,
+ * @c 1 is returned.
+ *
+ * @param frame_size    Size of Ethernet frame.
+ * @param family        Address family (@c AF_INET or @c AF_INET6).
+ *
+ * @return Size of UDP payload.
+ */
+extern unsigned int net_drv_perf_udp_payload_len(unsigned int frame_size,
+                                                 int family);
+
+/**
+ * Make sure that MTU of an interface is large enough to send Ethernet
+ * frames of a given size, increasing it if necessary. The test is
+ * skipped if MTU cannot be increased.
+ *
+ * @param ta            Test Agent name.
+ * @param if_name       Interface name.
+ * @param frame_size    Size of Ethernet frame including FCS.
+ */
+extern void net_drv_perf_ensure_mtu(const char *ta, const char *if_name,
+                                    unsigned int frame_size);
+
+/**
+ * Get number of interrupts of an interface from @b /proc/interrupts,
+ * summed over all CPUs and all interrupt lines whose name contains
+ * interface name as a separate token.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param count         Where to save number of interrupts.
+ *
+ * @return Status code (@c TE_ENOENT if no interrupts of the interface
+ *         were found, e.g. if driver names interrupts after PCI device).
+ */
+extern te_errno net_drv_perf_get_if_interrupts(rcf_rpc_server *rpcs,
+                                               const char *if_name,
+                                               uint64_t *count);
+
+/** How CPUs for traffic generators are chosen with respect to NIC */
+typedef enum net_drv_cpu_placement {
+    NET_DRV_CPU_PLACEMENT_ANY,          /**< Any free CPU */
+    NET_DRV_CPU_PLACEMENT_LOCAL_NUMA,   /**< CPU on the NUMA node of NIC */
+    NET_DRV_CPU_PLACEMENT_REMOTE_NUMA,  /**< CPU on another NUMA node */
+    NET_DRV_CPU_PLACEMENT_IRQ_CORE,     /**< CPU handling interrupts of
+                                             NIC queue */
+    NET_DRV_CPU_PLACEMENT_IRQ_SIBLING,  /**< Hyperthread sibling of CPU
+                                             handling interrupts of NIC
+                                             queue */
+} net_drv_cpu_placement;
+
+/**
+ * The list of values allowed for parameter of type 'cpu_placement'
+ */
+#define NET_DRV_CPU_PLACEMENT_MAPPING_LIST                    \
+    { "any",            NET_DRV_CPU_PLACEMENT_ANY },          \
+    { "local_numa",     NET_DRV_CPU_PLACEMENT_LOCAL_NUMA },   \
+    { "remote_numa",    NET_DRV_CPU_PLACEMENT_REMOTE_NUMA },  \
+    { "irq_core",       NET_DRV_CPU_PLACEMENT_IRQ_CORE },     \
+    { "irq_sibling",    NET_DRV_CPU_PLACEMENT_IRQ_SIBLING }
+
+/**
+ * Get the value of parameter of type 'cpu_placement'
+ *
+ * @param var_name_  Name of the variable used to get the value of
+ *                   "var_name_" parameter of type 'cpu_placement' (OUT)
+ */
+#define TEST_GET_CPU_PLACEMENT(var_name_) \
+    TEST_GET_ENUM_PARAM(var_name_, NET_DRV_CPU_PLACEMENT_MAPPING_LIST)
+
+/**
+ * Get NUMA node of a network interface from
+ * @b /sys/class/net/<if>/device/numa_node.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ *
+ * @return NUMA node or @c -1 if it is not known (e.g. interface is
+ *         virtual or the host is not NUMA).
+ */
+extern int net_drv_perf_if_numa_node(rcf_rpc_server *rpcs,
+                                     const char *if_name);
+
+/**
+ * Get CPUs handling interrupts of an interface. Interrupts are found in
+ * @b /proc/interrupts by interface name, CPU of every interrupt is the
+ * first one in its @b effective_affinity_list (or @b smp_affinity_list
+ * if the former is not available).
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param cpus          Where to save CPU numbers (vector of
+ *                      @c unsigned @c int, in order of interrupts
+ *                      in @b /proc/interrupts).
+ * @param irqs          Where to save numbers of the interrupts
+ *                      (vector of @c unsigned @c long, the same order
+ *                      as @p cpus; may be @c NULL).
+ *
+ * @return Status code (@c TE_ENOENT if no interrupts are found).
+ */
+extern te_errno net_drv_perf_if_irq_cpus(rcf_rpc_server *rpcs,
+                                         const char *if_name,
+                                         te_vec *cpus, te_vec *irqs);
+
+/**
+ * Grab a CPU for a traffic generator according to its placement with
+ * respect to a network interface. If NUMA node of the interface is not
+ * known, @c NET_DRV_CPU_PLACEMENT_LOCAL_NUMA is the same as
+ * @c NET_DRV_CPU_PLACEMENT_ANY.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param placement     CPU placement.
+ * @param cpu_id        Where to save grabbed CPU.
+ *
+ * @return Status code (@c TE_ENOENT if there is no suitable free CPU).
+ */
+extern te_errno net_drv_perf_cpu_grab(rcf_rpc_server *rpcs,
+                                      const char *if_name,
+                                      net_drv_cpu_placement placement,
+                                      tapi_cpu_index_t *cpu_id);
+
+/** How interface queues (interrupts, RPS or XPS) are mapped to CPUs */
+typedef enum net_drv_cpu_map {
+    NET_DRV_CPU_MAP_DEFAULT,    /**< Keep current settings (e.g. made
+                                     by irqbalance) */
+    NET_DRV_CPU_MAP_OFF,        /**< No CPUs (disable RPS or XPS) */
+    NET_DRV_CPU_MAP_SPREAD,     /**< One core per queue, cores on NUMA
+                                     node of NIC go first */
+    NET_DRV_CPU_MAP_SINGLE,     /**< All queues on the same core */
+    NET_DRV_CPU_MAP_ALL,        /**< Every queue on all CPUs */
+} net_drv_cpu_map;
+
+/**
+ * The list of values allowed for parameter of type 'cpu_map'
+ */
+#define NET_DRV_CPU_MAP_MAPPING_LIST                \
+    { "default",    NET_DRV_CPU_MAP_DEFAULT },      \
+    { "off",        NET_DRV_CPU_MAP_OFF },          \
+    { "spread",     NET_DRV_CPU_MAP_SPREAD },       \
+    { "single",     NET_DRV_CPU_MAP_SINGLE },       \
+    { "all",        NET_DRV_CPU_MAP_ALL }
+
+/**
+ * Get the value of parameter of type 'cpu_map'
+ *
+ * @param var_name_  Name of the variable used to get the value of
+ *                   "var_name_" parameter of type 'cpu_map' (OUT)
+ */
+#define TEST_GET_CPU_MAP(var_name_) \
+    TEST_GET_ENUM_PARAM(var_name_, NET_DRV_CPU_MAP_MAPPING_LIST)
+
+/** Original value of a sysfs or procfs file changed by a test */
+typedef struct net_drv_sys_setting {
+    char *path;     /**< Path to the file */
+    char *value;    /**< Value to restore */
+} net_drv_sys_setting;
+
+/** Initializer for vector of saved settings */
+#define NET_DRV_SYS_SETTINGS_INIT TE_VEC_INIT(net_drv_sys_setting)
+
+/**
+ * Route interrupts of an interface to CPUs via
+ * @b /proc/irq/<N>/smp_affinity_list. Interrupts are found in
+ * @b /proc/interrupts by interface name. The test is skipped if
+ * affinity cannot be changed.
+ *
+ * @note irqbalance may override the configured affinity, use
+ *       net_drv_perf_check_irq_affinity() after the benchmark to make
+ *       sure that it did not happen.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param map           How to map interrupts to CPUs
+ *                      (@c NET_DRV_CPU_MAP_OFF is not allowed).
+ * @param saved         Where to save original settings.
+ */
+extern void net_drv_perf_set_irq_affinity(rcf_rpc_server *rpcs,
+                                          const char *if_name,
+                                          net_drv_cpu_map map,
+                                          te_vec *saved);
+
+/**
+ * Check that interrupts of an interface are still routed to CPUs as
+ * configured by net_drv_perf_set_irq_affinity() (e.g. irqbalance did not
+ * move them). Test verdict is produced if affinity was changed.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param map           How interrupts were mapped to CPUs
+ *                      (nothing is checked for
+ *                      @c NET_DRV_CPU_MAP_DEFAULT).
+ */
+extern void net_drv_perf_check_irq_affinity(rcf_rpc_server *rpcs,
+                                            const char *if_name,
+                                            net_drv_cpu_map map);
+
+/**
+ * Configure Receive Packet Steering (RPS) CPUs of all Rx queues of
+ * an interface. The test is skipped if RPS cannot be configured.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param map           How to map Rx queues to CPUs.
+ * @param saved         Where to save original settings.
+ */
+extern void net_drv_perf_set_rps(rcf_rpc_server *rpcs, const char *if_name,
+                                 net_drv_cpu_map map, te_vec *saved);
+
+/**
+ * Configure Receive Flow Steering (RFS): set global
+ * @b rps_sock_flow_entries and divide it evenly between
+ * @b rps_flow_cnt of Rx queues of an interface. RFS works only if RPS
+ * is enabled or the driver supports accelerated RFS. The test is
+ * skipped if RFS cannot be configured.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param flow_entries  Number of flow entries (@c -1 - keep current
+ *                      settings, @c 0 - disable RFS).
+ * @param saved         Where to save original settings.
+ */
+extern void net_drv_perf_set_rfs(rcf_rpc_server *rpcs, const char *if_name,
+                                 int flow_entries, te_vec *saved);
+
+/**
+ * Configure Transmit Packet Steering (XPS) CPUs of all Tx queues of
+ * an interface. The test is skipped if XPS cannot be configured.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param map           How to map Tx queues to CPUs.
+ * @param saved         Where to save original settings.
+ */
+extern void net_drv_perf_set_xps(rcf_rpc_server *rpcs, const char *if_name,
+                                 net_drv_cpu_map map, te_vec *saved);
+
+/**
+ * Restore settings changed by net_drv_perf_set_irq_affinity(),
+ * net_drv_perf_set_rps(), net_drv_perf_set_rfs(),
+ * net_drv_perf_set_xps(), net_drv_perf_set_napi_defer() or
+ * net_drv_perf_set_threaded_napi() in reverse order and release
+ * the vector.
+ * Failures are only logged, so it may be used in cleanup.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param saved         Saved settings.
+ */
+extern void net_drv_perf_restore_sys(rcf_rpc_server *rpcs, te_vec *saved);
+
+/**
+ * Configure NAPI deferral of an interface: number of times hard
+ * interrupts stay masked after NAPI poll which found no work
+ * (@b napi_defer_hard_irqs) and timeout of GRO flush timer which
+ * re-arms polling (@b gro_flush_timeout). The test is skipped if the
+ * settings cannot be changed.
+ *
+ * @param rpcs              RPC server on the host.
+ * @param if_name           Interface name.
+ * @param defer_hard_irqs   Value of @b napi_defer_hard_irqs
+ *                          (@c -1 - keep current).
+ * @param gro_flush_timeout Value of @b gro_flush_timeout, in
+ *                          nanoseconds (@c -1 - keep current).
+ * @param saved             Where to save original settings (to be
+ *                          restored with net_drv_perf_restore_sys()).
+ */
+extern void net_drv_perf_set_napi_defer(rcf_rpc_server *rpcs,
+                                        const char *if_name,
+                                        int defer_hard_irqs,
+                                        int gro_flush_timeout,
+                                        te_vec *saved);
+
+/**
+ * Switch NAPI processing of an interface to kernel threads or back to
+ * softirq context via @b /sys/class/net/<if>/threaded. The test is
+ * skipped if it cannot be changed.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param threaded      Whether to use threaded NAPI
+ *                      (@c TE_BOOL3_UNKNOWN - keep current).
+ * @param saved         Where to save original settings (to be
+ *                      restored with net_drv_perf_restore_sys()).
+ */
+extern void net_drv_perf_set_threaded_napi(rcf_rpc_server *rpcs,
+                                           const char *if_name,
+                                           te_bool3 threaded,
+                                           te_vec *saved);
+
+/**
+ * Enable or disable BIG TCP on an interface: set GSO and GRO maximum
+ * sizes to @c NET_DRV_BIG_TCP_SIZE (GSO limited by what driver
+ * supports) or to 64KB. The test is skipped if BIG TCP is not
+ * supported by kernel or, when enabling, by driver.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param family        Address family of traffic.
+ * @param big_tcp       Whether to enable BIG TCP
+ *                      (@c TE_BOOL3_UNKNOWN - keep current).
+ * @param orig          Where to save original limits (to be restored
+ *                      with net_drv_set_gso_limits()).
+ *
+ * @return @c TRUE if the limits were changed, @c FALSE otherwise.
+ */
+extern te_bool net_drv_perf_set_big_tcp(rcf_rpc_server *rpcs,
+                                        const char *if_name, int family,
+                                        te_bool3 big_tcp,
+                                        net_drv_gso_limits *orig);
+
+#endif /* !__TS_NET_DRV_PERF_H__ */
@@ -8,8 +8,29 @@
 
 #include "te_config.h"
 
+#include <endian.h>
+#include <math.h>
+
 #include "net_drv_rpc.h"
 #include "tapi_rpc_internal.h"
+#include "tapi_mem.h"
+
+/* Convert latency statistics of Rx rules operations from RPC format */
+static void
+rx_rules_lat_rpc2h(const tarpc_net_drv_rx_rules_lat *rpc_lat,
+                   net_drv_rx_rules_lat *lat)
+{
+    unsigned int i;
+
+    lat->count = rpc_lat->count;
+    lat->total = rpc_lat->total;
+    lat->min = rpc_lat->min;
+    lat->max = rpc_lat->max;
+
+    for (i = 0; i < NET_DRV_RX_RULES_LAT_BINS &&
+                i < TE_ARRAY_LEN(rpc_lat->hist); i++)
+        lat->hist[i] = rpc_lat->hist[i];
+}
 
 /* See description in net_drv_rpc.h */
 int
@@ -21,13 +42,16 @@ rpc_net_drv_too_many_rx_rules(rcf_rpc_server *rpcs,
                               rpc_socket_type sock_type,
                               te_bool any_location,
                               unsigned int queues_num,
+                              unsigned int bucket_size,
                               unsigned int *rules_count,
-                              te_errno *add_errno)
+                              te_errno *add_errno,
+                              net_drv_rx_rules_prof *prof)
 {
     struct tarpc_net_drv_too_many_rx_rules_in in;
     struct tarpc_net_drv_too_many_rx_rules_out out;
     char src_addr_str[1000];
     char dst_addr_str[1000];
+    unsigned int i;
 
     memset(&in, 0, sizeof(in));
     memset(&out, 0, sizeof(out));
@@ -39,6 +63,7 @@ rpc_net_drv_too_many_rx_rules(rcf_rpc_server *rpcs,
     sockaddr_input_h2rpc(dst_addr, &in.dst_addr);
     in.any_location = any_location;
     in.queues_num = queues_num;
+    in.bucket_size = bucket_size;
 
     rcf_rpc_call(rpcs, "net_drv_too_many_rx_rules", &in, &out);
 
@@ -48,6 +73,28 @@ rpc_net_drv_too_many_rx_rules(rcf_rpc_server *rpcs,
             *rules_count = out.rules_count;
         if (add_errno != NULL)
             *add_errno = out.add_errno;
+
+        if (prof != NULL)
+        {
+            memset(prof, 0, sizeof(*prof));
+            prof->ins_time = out.ins_time;
+            prof->del_time = out.del_time;
+            prof->del_count = out.del_count;
+
+            if (out.buckets.buckets_len > 0)
+            {
+                prof->buckets = tapi_calloc(out.buckets.buckets_len,
+                                            sizeof(*prof->buckets));
+                for (i = 0; i < out.buckets.buckets_len; i++)
+                {
+                    rx_rules_lat_rpc2h(&out.buckets.buckets_val[i].ins,
+                                       &prof->buckets[i].ins);
+                    rx_rules_lat_rpc2h(&out.buckets.buckets_val[i].del,
+                                       &prof->buckets[i].del);
+                }
+            }
+            prof->buckets_num = out.buckets.buckets_len;
+        }
     }
 
     CHECK_RETVAL_VAR_IS_ZERO_OR_MINUS_ONE(net_drv_too_many_rx_rules,
@@ -56,12 +103,15 @@ rpc_net_drv_too_many_rx_rules(rcf_rpc_server *rpcs,
     SOCKADDR_H2STR_SBUF(src_addr, src_addr_str);
     SOCKADDR_H2STR_SBUF(dst_addr, dst_addr_str);
     TAPI_RPC_LOG(rpcs, net_drv_too_many_rx_rules, "%s, %s, %s, %s, "
-                 "any_location=%s, queues_num=%u",
-                 "%d rules_count=%u add_errno=%r",
+                 "any_location=%s, queues_num=%u, bucket_size=%u",
+                 "%d rules_count=%u add_errno=%r "
+                 "ins_time=%" TE_PRINTF_64 "u ns "
+                 "del_time=%" TE_PRINTF_64 "u ns",
                  if_name, src_addr_str, dst_addr_str,
                  socktype_rpc2str(sock_type),
                  any_location ? "TRUE" : "FALSE",
-                 queues_num, out.retval, out.rules_count, out.add_errno);
+                 queues_num, bucket_size, out.retval, out.rules_count,
+                 out.add_errno, out.ins_time, out.del_time);
 
     RETVAL_INT(net_drv_too_many_rx_rules, out.retval);
 }
@@ -95,6 +145,38 @@ rpc_net_drv_send_pkts_exact_delay(rcf_rpc_server *rpcs,
     RETVAL_INT64(net_drv_send_pkts_exact_delay, out.retval);
 }
 
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_send_pkts_burst(rcf_rpc_server *rpcs,
+                            int s,
+                            unsigned int burst,
+                            uint64_t gap,
+                            unsigned int time2run)
+{
+    struct tarpc_net_drv_send_pkts_burst_in in;
+    struct tarpc_net_drv_send_pkts_burst_out out;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.burst = burst;
+    in.gap = gap;
+    in.time2run = time2run;
+
+    rcf_rpc_call(rpcs, "net_drv_send_pkts_burst", &in, &out);
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_send_pkts_burst,
+                                      out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_send_pkts_burst,
+                 "socket=%d, burst=%u, gap=%" TE_PRINTF_64 "u ns, "
+                 "time2run=%u ms", "%jd",
+                 s, burst, gap, time2run, (intmax_t)out.retval);
+
+    RETVAL_INT64(net_drv_send_pkts_burst, out.retval);
+}
+
 /* See description in net_drv_rpc.h */
 int64_t
 rpc_net_drv_recv_pkts_exact_delay(rcf_rpc_server *rpcs,
@@ -121,3 +203,939 @@ rpc_net_drv_recv_pkts_exact_delay(rcf_rpc_server *rpcs,
 
     RETVAL_INT64(net_drv_recv_pkts_exact_delay, out.retval);
 }
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_recv_pkts_ts(rcf_rpc_server *rpcs,
+                         int s,
+                         unsigned int time2wait,
+                         const char *hw_ts_if,
+                         unsigned int max_pkts,
+                         net_drv_pkt_ts **pkts,
+                         unsigned int *pkts_num)
+{
+    struct tarpc_net_drv_recv_pkts_ts_in in;
+    struct tarpc_net_drv_recv_pkts_ts_out out;
+    net_drv_pkt_ts *result = NULL;
+    unsigned int i;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.time2wait = time2wait;
+    in.hw_ts_if = (char *)(hw_ts_if == NULL ? "" : hw_ts_if);
+    in.max_pkts = max_pkts;
+
+    rcf_rpc_call(rpcs, "net_drv_recv_pkts_ts", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0 && pkts != NULL && pkts_num != NULL)
+    {
+        if (out.pkts.pkts_len > 0)
+        {
+            result = tapi_calloc(out.pkts.pkts_len, sizeof(*result));
+            for (i = 0; i < out.pkts.pkts_len; i++)
+            {
+                result[i].id = out.pkts.pkts_val[i].id;
+                result[i].ts = out.pkts.pkts_val[i].ts;
+            }
+        }
+
+        *pkts = result;
+        *pkts_num = out.pkts.pkts_len;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_recv_pkts_ts, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_recv_pkts_ts,
+                 "socket=%d, time2wait=%u ms, hw_ts_if=%s, max_pkts=%u",
+                 "%jd timestamps=%u",
+                 s, time2wait, hw_ts_if == NULL ? "(none)" : hw_ts_if,
+                 max_pkts,
+                 (intmax_t)out.retval, out.pkts.pkts_len);
+
+    RETVAL_INT64(net_drv_recv_pkts_ts, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_recv_pkts_groups(rcf_rpc_server *rpcs,
+                             int s,
+                             unsigned int time2wait,
+                             const char *hw_ts_if,
+                             unsigned int min_group_delay,
+                             unsigned int exp_group_time,
+                             unsigned int bucket_width,
+                             unsigned int buckets_num,
+                             net_drv_pkt_groups *groups)
+{
+    struct tarpc_net_drv_recv_pkts_groups_in in;
+    struct tarpc_net_drv_recv_pkts_groups_out out;
+    unsigned int i;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.time2wait = time2wait;
+    in.hw_ts_if = (char *)(hw_ts_if == NULL ? "" : hw_ts_if);
+    in.min_group_delay = min_group_delay;
+    in.exp_group_time = exp_group_time;
+    in.bucket_width = bucket_width;
+    in.buckets_num = buckets_num;
+
+    rcf_rpc_call(rpcs, "net_drv_recv_pkts_groups", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0 && groups != NULL)
+    {
+        memset(groups, 0, sizeof(*groups));
+        groups->n_groups = out.n_groups;
+        groups->skipped_groups = out.skipped_groups;
+        groups->avg_group_time = TE_NS2US((double)out.avg_group_time);
+        groups->group_time_dev = TE_NS2US(sqrt(out.group_time_var));
+
+        if (out.gap_hist.gap_hist_len > 0)
+        {
+            groups->gap_hist = tapi_calloc(out.gap_hist.gap_hist_len,
+                                           sizeof(*groups->gap_hist));
+            for (i = 0; i < out.gap_hist.gap_hist_len; i++)
+                groups->gap_hist[i] = out.gap_hist.gap_hist_val[i];
+        }
+        groups->gap_hist_len = out.gap_hist.gap_hist_len;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_recv_pkts_groups,
+                                      out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_recv_pkts_groups,
+                 "socket=%d, time2wait=%u ms, hw_ts_if=%s, "
+                 "min_group_delay=%u us, exp_group_time=%u us, "
+                 "bucket_width=%u us, buckets_num=%u",
+                 "%jd groups=%" TE_PRINTF_64 "u "
+                 "skipped_groups=%" TE_PRINTF_64 "u "
+                 "avg_group_time=%" TE_PRINTF_64 "u ns",
+                 s, time2wait, hw_ts_if == NULL ? "(none)" : hw_ts_if,
+                 min_group_delay, exp_group_time, bucket_width,
+                 buckets_num,
+                 (intmax_t)out.retval, out.n_groups, out.skipped_groups,
+                 out.avg_group_time);
+
+    RETVAL_INT64(net_drv_recv_pkts_groups, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_send_pkts_mt(rcf_rpc_server *rpcs,
+                         const struct sockaddr *src_addr,
+                         const struct sockaddr *dst_addr,
+                         const int *cpus,
+                         unsigned int threads_num,
+                         unsigned int pkt_size,
+                         unsigned int burst,
+                         uint64_t rate,
+                         unsigned int time2run,
+                         net_drv_send_thread_stats **stats)
+{
+    struct tarpc_net_drv_send_pkts_mt_in in;
+    struct tarpc_net_drv_send_pkts_mt_out out;
+    char src_addr_str[1000];
+    char dst_addr_str[1000];
+    net_drv_send_thread_stats *res;
+    unsigned int i;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    sockaddr_input_h2rpc(src_addr, &in.src_addr);
+    sockaddr_input_h2rpc(dst_addr, &in.dst_addr);
+    in.cpus.cpus_val = (tarpc_int *)cpus;
+    in.cpus.cpus_len = threads_num;
+    in.pkt_size = pkt_size;
+    in.burst = burst;
+    in.rate = rate;
+    in.time2run = time2run;
+
+    rcf_rpc_call(rpcs, "net_drv_send_pkts_mt", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0 && stats != NULL)
+    {
+        res = tapi_calloc(out.stats.stats_len + 1, sizeof(*res));
+        for (i = 0; i < out.stats.stats_len; i++)
+        {
+            res[i].pkts = out.stats.stats_val[i].pkts;
+            res[i].bytes = out.stats.stats_val[i].bytes;
+            res[i].errors = out.stats.stats_val[i].errors;
+        }
+        *stats = res;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_send_pkts_mt, out.retval);
+
+    SOCKADDR_H2STR_SBUF(src_addr, src_addr_str);
+    SOCKADDR_H2STR_SBUF(dst_addr, dst_addr_str);
+    TAPI_RPC_LOG(rpcs, net_drv_send_pkts_mt,
+                 "%s, %s, threads_num=%u, pkt_size=%u, burst=%u, "
+                 "rate=%" TE_PRINTF_64 "u pps, time2run=%u ms", "%jd",
+                 src_addr_str, dst_addr_str, threads_num, pkt_size, burst,
+                 rate, time2run, (intmax_t)out.retval);
+
+    RETVAL_INT64(net_drv_send_pkts_mt, out.retval);
+}
+
+/* Convert bitmask of net_drv_capt_field values to RPC format */
+static uint32_t
+capt_fields_h2rpc(unsigned int fields)
+{
+    uint32_t res = 0;
+
+#define CAPT_FIELD_H2RPC(_field) \
+    do {                                                \
+        if (fields & NET_DRV_CAPT_ ## _field)           \
+            res |= TARPC_NET_DRV_CAPT_ ## _field;       \
+    } while (0)
+
+    CAPT_FIELD_H2RPC(TS);
+    CAPT_FIELD_H2RPC(LEN);
+    CAPT_FIELD_H2RPC(VLAN);
+    CAPT_FIELD_H2RPC(TCP_SEQ);
+    CAPT_FIELD_H2RPC(TCP_LEN);
+    CAPT_FIELD_H2RPC(TCP_FLAGS);
+
+#undef CAPT_FIELD_H2RPC
+
+    return res;
+}
+
+/* Get size of a packed capture record with given fields */
+static size_t
+capt_rec_size(unsigned int fields)
+{
+    size_t size = 0;
+
+    if (fields & NET_DRV_CAPT_TS)
+        size += sizeof(uint64_t);
+    if (fields & NET_DRV_CAPT_LEN)
+        size += sizeof(uint32_t);
+    if (fields & NET_DRV_CAPT_VLAN)
+        size += 2 * sizeof(uint16_t);
+    if (fields & NET_DRV_CAPT_TCP_SEQ)
+        size += sizeof(uint32_t);
+    if (fields & NET_DRV_CAPT_TCP_LEN)
+        size += sizeof(uint32_t);
+    if (fields & NET_DRV_CAPT_TCP_FLAGS)
+        size += sizeof(uint8_t);
+
+    return size;
+}
+
+/*
+ * Parse a packed capture record. Fields are stored in network byte
+ * order in the order of their flags in net_drv_capt_field.
+ */
+static void
+capt_rec_parse(const uint8_t *data, unsigned int fields,
+               net_drv_capt_rec *rec)
+{
+    uint64_t val64;
+    uint32_t val32;
+    uint16_t val16;
+
+#define CAPT_REC_GET(_val) \
+    do {                                    \
+        memcpy(&(_val), data, sizeof(_val)); \
+        data += sizeof(_val);               \
+    } while (0)
+
+    if (fields & NET_DRV_CAPT_TS)
+    {
+        CAPT_REC_GET(val64);
+        rec->ts = be64toh(val64);
+    }
+    if (fields & NET_DRV_CAPT_LEN)
+    {
+        CAPT_REC_GET(val32);
+        rec->len = ntohl(val32);
+    }
+    if (fields & NET_DRV_CAPT_VLAN)
+    {
+        CAPT_REC_GET(val16);
+        rec->vlan_tpid = ntohs(val16);
+        CAPT_REC_GET(val16);
+        rec->vlan_tci = ntohs(val16);
+    }
+    if (fields & NET_DRV_CAPT_TCP_SEQ)
+    {
+        CAPT_REC_GET(val32);
+        rec->tcp_seq = ntohl(val32);
+    }
+    if (fields & NET_DRV_CAPT_TCP_LEN)
+    {
+        CAPT_REC_GET(val32);
+        rec->tcp_len = ntohl(val32);
+    }
+    if (fields & NET_DRV_CAPT_TCP_FLAGS)
+        CAPT_REC_GET(rec->tcp_flags);
+
+#undef CAPT_REC_GET
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_capture_pkts(rcf_rpc_server *rpcs,
+                         const char *if_name,
+                         const struct sock_filter *filter,
+                         unsigned int filter_len,
+                         unsigned int fields,
+                         unsigned int time2run,
+                         unsigned int max_pkts,
+                         net_drv_capt_rec **recs,
+                         unsigned int *recs_num,
+                         uint64_t *drops)
+{
+    struct tarpc_net_drv_capture_pkts_in in;
+    struct tarpc_net_drv_capture_pkts_out out;
+    tarpc_net_drv_bpf_insn *insns = NULL;
+    net_drv_capt_rec *res = NULL;
+    size_t rec_size = capt_rec_size(fields);
+    unsigned int num = 0;
+    unsigned int i;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    if (filter_len > 0)
+    {
+        insns = tapi_calloc(filter_len, sizeof(*insns));
+        for (i = 0; i < filter_len; i++)
+        {
+            insns[i].code = filter[i].code;
+            insns[i].jt = filter[i].jt;
+            insns[i].jf = filter[i].jf;
+            insns[i].k = filter[i].k;
+        }
+    }
+
+    in.if_name = (char *)if_name;
+    in.filter.filter_val = insns;
+    in.filter.filter_len = filter_len;
+    in.fields = capt_fields_h2rpc(fields);
+    in.time2run = time2run;
+    in.max_pkts = max_pkts;
+
+    rcf_rpc_call(rpcs, "net_drv_capture_pkts", &in, &out);
+    free(insns);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0)
+    {
+        if (rec_size > 0)
+            num = out.records.records_len / rec_size;
+        else
+            num = max_pkts == 0 ? out.retval : MIN(out.retval, max_pkts);
+
+        if (recs != NULL)
+        {
+            res = tapi_calloc(num + 1, sizeof(*res));
+            for (i = 0; i < num && rec_size > 0; i++)
+            {
+                capt_rec_parse(out.records.records_val + i * rec_size,
+                               fields, &res[i]);
+            }
+            *recs = res;
+        }
+        if (recs_num != NULL)
+            *recs_num = num;
+        if (drops != NULL)
+            *drops = out.drops;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_capture_pkts, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_capture_pkts,
+                 "if_name=%s, filter_len=%u, fields=0x%x, time2run=%u ms, "
+                 "max_pkts=%u", "%jd drops=%" TE_PRINTF_64 "u",
+                 if_name, filter_len, fields, time2run, max_pkts,
+                 (intmax_t)out.retval, out.drops);
+
+    RETVAL_INT64(net_drv_capture_pkts, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_send_zc(rcf_rpc_server *rpcs,
+                    int s,
+                    unsigned int buf_size,
+                    unsigned int time2run,
+                    te_bool zerocopy,
+                    net_drv_zc_stats *stats)
+{
+    struct tarpc_net_drv_send_zc_in in;
+    struct tarpc_net_drv_send_zc_out out;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.buf_size = buf_size;
+    in.time2run = time2run;
+    in.zerocopy = zerocopy;
+
+    rcf_rpc_call(rpcs, "net_drv_send_zc", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        stats != NULL)
+    {
+        stats->calls = out.calls;
+        stats->zc_completed = out.zc_completed;
+        stats->zc_copied = out.zc_copied;
+        stats->cpu_time = out.cpu_time;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_send_zc, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_send_zc,
+                 "socket=%d, buf_size=%u, time2run=%u ms, zerocopy=%s",
+                 "%jd calls=%" TE_PRINTF_64 "u "
+                 "zc_completed=%" TE_PRINTF_64 "u "
+                 "zc_copied=%" TE_PRINTF_64 "u "
+                 "cpu_time=%" TE_PRINTF_64 "u ns",
+                 s, buf_size, time2run, zerocopy ? "TRUE" : "FALSE",
+                 (intmax_t)out.retval, out.calls, out.zc_completed,
+                 out.zc_copied, out.cpu_time);
+
+    RETVAL_INT64(net_drv_send_zc, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_send_udp_gso(rcf_rpc_server *rpcs,
+                         int s,
+                         unsigned int buf_len,
+                         unsigned int gso_size,
+                         unsigned int time2run,
+                         unsigned int max_calls,
+                         net_drv_udp_gso_stats *stats)
+{
+    struct tarpc_net_drv_send_udp_gso_in in;
+    struct tarpc_net_drv_send_udp_gso_out out;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.buf_len = buf_len;
+    in.gso_size = gso_size;
+    in.time2run = time2run;
+    in.max_calls = max_calls;
+
+    rcf_rpc_call(rpcs, "net_drv_send_udp_gso", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        stats != NULL)
+    {
+        stats->calls = out.calls;
+        stats->segs = out.segs;
+        stats->cpu_time = out.cpu_time;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_send_udp_gso, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_send_udp_gso,
+                 "socket=%d, buf_len=%u, gso_size=%u, time2run=%u ms, "
+                 "max_calls=%u", "%jd calls=%" TE_PRINTF_64 "u "
+                 "segs=%" TE_PRINTF_64 "u cpu_time=%" TE_PRINTF_64 "u ns",
+                 s, buf_len, gso_size, time2run, max_calls,
+                 (intmax_t)out.retval, out.calls, out.segs, out.cpu_time);
+
+    RETVAL_INT64(net_drv_send_udp_gso, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_recv_udp_gro(rcf_rpc_server *rpcs,
+                         int s,
+                         te_bool gro,
+                         unsigned int time2wait,
+                         net_drv_udp_gro_stats *stats)
+{
+    struct tarpc_net_drv_recv_udp_gro_in in;
+    struct tarpc_net_drv_recv_udp_gro_out out;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.gro = gro;
+    in.time2wait = time2wait;
+
+    rcf_rpc_call(rpcs, "net_drv_recv_udp_gro", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        stats != NULL)
+    {
+        stats->segs = out.segs;
+        stats->bytes = out.bytes;
+        stats->coalesced = out.coalesced;
+        stats->max_segs = out.max_segs;
+        stats->gso_size = out.gso_size;
+        stats->gso_size_mismatch = out.gso_size_mismatch;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_recv_udp_gro, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_recv_udp_gro,
+                 "socket=%d, gro=%s, time2wait=%u ms",
+                 "%jd segs=%" TE_PRINTF_64 "u bytes=%" TE_PRINTF_64 "u "
+                 "coalesced=%" TE_PRINTF_64 "u max_segs=%u gso_size=%u",
+                 s, gro ? "TRUE" : "FALSE", time2wait,
+                 (intmax_t)out.retval, out.segs, out.bytes, out.coalesced,
+                 out.max_segs, out.gso_size);
+
+    RETVAL_INT64(net_drv_recv_udp_gro, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_pingpong_client(rcf_rpc_server *rpcs,
+                            int s,
+                            unsigned int msg_size,
+                            unsigned int depth,
+                            unsigned int time2run,
+                            const unsigned int *percentiles,
+                            unsigned int pct_num,
+                            uint64_t *pct_values,
+                            net_drv_rtt_stats *stats)
+{
+    struct tarpc_net_drv_pingpong_client_in in;
+    struct tarpc_net_drv_pingpong_client_out out;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.msg_size = msg_size;
+    in.depth = depth;
+    in.time2run = time2run;
+    in.percentiles.percentiles_val = (uint32_t *)percentiles;
+    in.percentiles.percentiles_len = pct_num;
+
+    rcf_rpc_call(rpcs, "net_drv_pingpong_client", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0)
+    {
+        if (pct_values != NULL)
+        {
+            memcpy(pct_values, out.pct_values.pct_values_val,
+                   MIN(pct_num, out.pct_values.pct_values_len) *
+                   sizeof(*pct_values));
+        }
+
+        if (stats != NULL)
+        {
+            stats->count = out.retval;
+            stats->lost = out.lost;
+            stats->min = out.min;
+            stats->max = out.max;
+            stats->mean = out.mean;
+        }
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_pingpong_client, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_pingpong_client,
+                 "socket=%d, msg_size=%u, depth=%u, time2run=%u ms",
+                 "%jd lost=%" TE_PRINTF_64 "u min=%" TE_PRINTF_64 "u ns "
+                 "mean=%" TE_PRINTF_64 "u ns max=%" TE_PRINTF_64 "u ns",
+                 s, msg_size, depth, time2run, (intmax_t)out.retval,
+                 out.lost, out.min, out.mean, out.max);
+
+    RETVAL_INT64(net_drv_pingpong_client, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_pingpong_server(rcf_rpc_server *rpcs,
+                            int s,
+                            unsigned int msg_size,
+                            unsigned int time2wait)
+{
+    struct tarpc_net_drv_pingpong_server_in in;
+    struct tarpc_net_drv_pingpong_server_out out;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.msg_size = msg_size;
+    in.time2wait = time2wait;
+
+    rcf_rpc_call(rpcs, "net_drv_pingpong_server", &in, &out);
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_pingpong_server, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_pingpong_server,
+                 "socket=%d, msg_size=%u, time2wait=%u ms", "%jd",
+                 s, msg_size, time2wait, (intmax_t)out.retval);
+
+    RETVAL_INT64(net_drv_pingpong_server, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_uring_send(rcf_rpc_server *rpcs,
+                       int s,
+                       unsigned int min_size,
+                       unsigned int max_size,
+                       unsigned int depth,
+                       unsigned int time2run,
+                       te_bool ignore_err,
+                       net_drv_uring_send_stats *stats)
+{
+    struct tarpc_net_drv_uring_send_in in;
+    struct tarpc_net_drv_uring_send_out out;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.min_size = min_size;
+    in.max_size = max_size;
+    in.depth = depth;
+    in.time2run = time2run;
+    in.ignore_err = ignore_err;
+
+    rcf_rpc_call(rpcs, "net_drv_uring_send", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        stats != NULL)
+    {
+        stats->completions = out.completions;
+        stats->errors = out.errors;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_uring_send, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_uring_send,
+                 "socket=%d, size=[%u, %u], depth=%u, time2run=%u ms, "
+                 "ignore_err=%s", "%jd completions=%" TE_PRINTF_64 "u "
+                 "errors=%" TE_PRINTF_64 "u",
+                 s, min_size, max_size, depth, time2run,
+                 ignore_err ? "TRUE" : "FALSE", (intmax_t)out.retval,
+                 out.completions, out.errors);
+
+    RETVAL_INT64(net_drv_uring_send, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_uring_recv(rcf_rpc_server *rpcs,
+                       int s,
+                       unsigned int buf_size,
+                       unsigned int bufs_num,
+                       unsigned int time2run,
+                       uint64_t *completions)
+{
+    struct tarpc_net_drv_uring_recv_in in;
+    struct tarpc_net_drv_uring_recv_out out;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.s = s;
+    in.buf_size = buf_size;
+    in.bufs_num = bufs_num;
+    in.time2run = time2run;
+
+    rcf_rpc_call(rpcs, "net_drv_uring_recv", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        completions != NULL)
+        *completions = out.completions;
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_uring_recv, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_uring_recv,
+                 "socket=%d, buf_size=%u, bufs_num=%u, time2run=%u ms",
+                 "%jd completions=%" TE_PRINTF_64 "u",
+                 s, buf_size, bufs_num, time2run, (intmax_t)out.retval,
+                 out.completions);
+
+    RETVAL_INT64(net_drv_uring_recv, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int
+rpc_net_drv_napi_threads(rcf_rpc_server *rpcs, const char *if_name,
+                         const int *cpus, unsigned int cpus_num,
+                         net_drv_napi_thread **threads)
+{
+    struct tarpc_net_drv_napi_threads_in in;
+    struct tarpc_net_drv_napi_threads_out out;
+    net_drv_napi_thread *res;
+    unsigned int i;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.if_name = (char *)if_name;
+    in.cpus.cpus_val = (tarpc_int *)cpus;
+    in.cpus.cpus_len = cpus_num;
+
+    rcf_rpc_call(rpcs, "net_drv_napi_threads", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0 && threads != NULL)
+    {
+        res = tapi_calloc(out.threads.threads_len + 1, sizeof(*res));
+        for (i = 0; i < out.threads.threads_len; i++)
+        {
+            res[i].pid = out.threads.threads_val[i].pid;
+            res[i].napi_id = out.threads.threads_val[i].napi_id;
+            res[i].cpu_time = out.threads.threads_val[i].cpu_time;
+            res[i].ts = out.threads.threads_val[i].ts;
+            res[i].cpu = out.threads.threads_val[i].cpu;
+        }
+        *threads = res;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_napi_threads, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_napi_threads, "%s, cpus_num=%u", "%jd",
+                 if_name, cpus_num, (intmax_t)out.retval);
+
+    RETVAL_INT(net_drv_napi_threads, out.retval);
+}
+
+/* Convert bitmask of net_drv_xsk_flag values to RPC format */
+static uint32_t
+xsk_flags_h2rpc(unsigned int flags)
+{
+    uint32_t res = 0;
+
+#define XSK_FLAG_H2RPC(_flag) \
+    do {                                            \
+        if (flags & NET_DRV_XSK_ ## _flag)          \
+            res |= TARPC_NET_DRV_XSK_ ## _flag;     \
+    } while (0)
+
+    XSK_FLAG_H2RPC(COPY);
+    XSK_FLAG_H2RPC(ZEROCOPY);
+    XSK_FLAG_H2RPC(NEED_WAKEUP);
+
+#undef XSK_FLAG_H2RPC
+
+    return res;
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_xsk_batch(rcf_rpc_server *rpcs, const char *if_name,
+                      int map_fd, const unsigned int *queues,
+                      const int *cpus, unsigned int queues_num,
+                      unsigned int frame_size, unsigned int frames_num,
+                      unsigned int ring_size, unsigned int flags,
+                      net_drv_xsk_mode mode, unsigned int batch,
+                      unsigned int time2run,
+                      net_drv_xsk_queue_stats **stats)
+{
+    struct tarpc_net_drv_xsk_batch_in in;
+    struct tarpc_net_drv_xsk_batch_out out;
+    net_drv_xsk_queue_stats *res;
+    unsigned int i;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.if_name = (char *)if_name;
+    in.map_fd = map_fd;
+    in.queues.queues_val = (uint32_t *)queues;
+    in.queues.queues_len = queues_num;
+    if (cpus != NULL)
+    {
+        in.cpus.cpus_val = (tarpc_int *)cpus;
+        in.cpus.cpus_len = queues_num;
+    }
+    in.frame_size = frame_size;
+    in.frames_num = frames_num;
+    in.ring_size = ring_size;
+    in.flags = xsk_flags_h2rpc(flags);
+    in.mode = (mode == NET_DRV_XSK_FWD ? TARPC_NET_DRV_XSK_FWD :
+                                         TARPC_NET_DRV_XSK_RX_DROP);
+    in.batch = batch;
+    in.time2run = time2run;
+
+    rcf_rpc_call(rpcs, "net_drv_xsk_batch", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0 && stats != NULL)
+    {
+        res = tapi_calloc(out.stats.stats_len + 1, sizeof(*res));
+        for (i = 0; i < out.stats.stats_len; i++)
+        {
+            res[i].rx_pkts = out.stats.stats_val[i].rx_pkts;
+            res[i].tx_pkts = out.stats.stats_val[i].tx_pkts;
+            res[i].wakeups = out.stats.stats_val[i].wakeups;
+        }
+        *stats = res;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_xsk_batch, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_xsk_batch,
+                 "%s, map_fd=%d, queues_num=%u, frame_size=%u, "
+                 "frames_num=%u, ring_size=%u, flags=0x%x, mode=%s, "
+                 "batch=%u, time2run=%u ms", "%jd",
+                 if_name, map_fd, queues_num, frame_size, frames_num,
+                 ring_size, flags,
+                 mode == NET_DRV_XSK_FWD ? "fwd" : "rx_drop",
+                 batch, time2run, (intmax_t)out.retval);
+
+    RETVAL_INT64(net_drv_xsk_batch, out.retval);
+}
+
+/* Convert per-thread statistics of net_drv_cps_*() from RPC format */
+static net_drv_cps_thread_stats *
+cps_stats_rpc2h(const tarpc_net_drv_cps_thread_stats *rpc_stats,
+                unsigned int len)
+{
+    net_drv_cps_thread_stats *res;
+    unsigned int i;
+
+    res = tapi_calloc(len + 1, sizeof(*res));
+    for (i = 0; i < len; i++)
+    {
+        res[i].conns = rpc_stats[i].conns;
+        res[i].errors = rpc_stats[i].errors;
+    }
+
+    return res;
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_cps_client(rcf_rpc_server *rpcs,
+                       const struct sockaddr *dst_addr,
+                       const int *cpus, unsigned int threads_num,
+                       unsigned int req_size, unsigned int resp_size,
+                       unsigned int time2run,
+                       net_drv_cps_thread_stats **stats,
+                       uint64_t *syn_retrans)
+{
+    struct tarpc_net_drv_cps_client_in in;
+    struct tarpc_net_drv_cps_client_out out;
+    char dst_addr_str[1000];
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    sockaddr_input_h2rpc(dst_addr, &in.dst_addr);
+    in.cpus.cpus_val = (tarpc_int *)cpus;
+    in.cpus.cpus_len = threads_num;
+    in.req_size = req_size;
+    in.resp_size = resp_size;
+    in.time2run = time2run;
+
+    rcf_rpc_call(rpcs, "net_drv_cps_client", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0)
+    {
+        if (stats != NULL)
+            *stats = cps_stats_rpc2h(out.stats.stats_val,
+                                     out.stats.stats_len);
+        if (syn_retrans != NULL)
+            *syn_retrans = out.syn_retrans;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_cps_client, out.retval);
+
+    SOCKADDR_H2STR_SBUF(dst_addr, dst_addr_str);
+    TAPI_RPC_LOG(rpcs, net_drv_cps_client,
+                 "%s, threads_num=%u, req_size=%u, resp_size=%u, "
+                 "time2run=%u ms", "%jd syn_retrans=%" TE_PRINTF_64 "u",
+                 dst_addr_str, threads_num, req_size, resp_size, time2run,
+                 (intmax_t)out.retval, out.syn_retrans);
+
+    RETVAL_INT64(net_drv_cps_client, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int64_t
+rpc_net_drv_cps_server(rcf_rpc_server *rpcs, const struct sockaddr *addr,
+                       const int *cpus, unsigned int threads_num,
+                       unsigned int req_size, unsigned int resp_size,
+                       unsigned int time2run,
+                       net_drv_cps_thread_stats **stats)
+{
+    struct tarpc_net_drv_cps_server_in in;
+    struct tarpc_net_drv_cps_server_out out;
+    char addr_str[1000];
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    sockaddr_input_h2rpc(addr, &in.addr);
+    in.cpus.cpus_val = (tarpc_int *)cpus;
+    in.cpus.cpus_len = threads_num;
+    in.req_size = req_size;
+    in.resp_size = resp_size;
+    in.time2run = time2run;
+
+    rcf_rpc_call(rpcs, "net_drv_cps_server", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0 && stats != NULL)
+    {
+        *stats = cps_stats_rpc2h(out.stats.stats_val, out.stats.stats_len);
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_cps_server, out.retval);
+
+    SOCKADDR_H2STR_SBUF(addr, addr_str);
+    TAPI_RPC_LOG(rpcs, net_drv_cps_server,
+                 "%s, threads_num=%u, req_size=%u, resp_size=%u, "
+                 "time2run=%u ms", "%jd",
+                 addr_str, threads_num, req_size, resp_size, time2run,
+                 (intmax_t)out.retval);
+
+    RETVAL_INT64(net_drv_cps_server, out.retval);
+}
+
+/* See description in net_drv_rpc.h */
+int
+rpc_net_drv_page_pools(rcf_rpc_server *rpcs, const char *if_name,
+                       uint64_t *inflight, uint64_t *inflight_mem)
+{
+    struct tarpc_net_drv_page_pools_in in;
+    struct tarpc_net_drv_page_pools_out out;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.if_name = (char *)if_name;
+
+    rcf_rpc_call(rpcs, "net_drv_page_pools", &in, &out);
+
+    if (RPC_IS_CALL_OK(rpcs) && rpcs->op != RCF_RPC_WAIT &&
+        out.retval >= 0)
+    {
+        if (inflight != NULL)
+            *inflight = out.inflight;
+        if (inflight_mem != NULL)
+            *inflight_mem = out.inflight_mem;
+    }
+
+    CHECK_RETVAL_VAR_IS_GTE_MINUS_ONE(net_drv_page_pools, out.retval);
+
+    TAPI_RPC_LOG(rpcs, net_drv_page_pools, "%s",
+                 "%jd inflight=%" TE_PRINTF_64 "u "
+                 "inflight_mem=%" TE_PRINTF_64 "u",
+                 if_name, (intmax_t)out.retval, out.inflight,
+                 out.inflight_mem);
+
+    RETVAL_INT(net_drv_page_pools, out.retval);
+}
@@ -11,12 +11,65 @@
 
 #include "te_config.h"
 
+#include <linux/filter.h>
+
 #include "rcf_rpc.h"
 #include "te_rpc_types.h"
+#include "tarpc.h"
+
+/**
+ * Latency statistics of Rx rule insertions or deletions.
+ *
+ * Histogram has @c NET_DRV_RX_RULES_LAT_BINS bins (the constant is
+ * defined in net_drv_ts.x.m4 and shared with TA). The first bin counts
+ * operations which took less than 1 microsecond, bin @c N counts
+ * operations which took from @c 2^(N-1) to @c 2^N microseconds, the last
+ * bin counts all the longer operations.
+ */
+typedef struct net_drv_rx_rules_lat {
+    unsigned int count;   /**< Number of operations */
+    uint64_t total;       /**< Total time of all operations, in ns */
+    uint64_t min;         /**< Minimum operation time, in ns */
+    uint64_t max;         /**< Maximum operation time, in ns */
+    unsigned int hist[NET_DRV_RX_RULES_LAT_BINS]; /**< Latency histogram
+                                                       (log2 of
+                                                       microseconds) */
+} net_drv_rx_rules_lat;
+
+/**
+ * Latency statistics of operations performed when number of rules
+ * in the table was within a given range.
+ */
+typedef struct net_drv_rx_rules_bucket {
+    net_drv_rx_rules_lat ins; /**< Insertions */
+    net_drv_rx_rules_lat del; /**< Deletions */
+} net_drv_rx_rules_bucket;
+
+/** Latency profile of Rx rules table filling and clearing */
+typedef struct net_drv_rx_rules_prof {
+    net_drv_rx_rules_bucket *buckets; /**< Statistics per fill level
+                                           range; bucket @c N covers
+                                           table fill levels from
+                                           @c N * bucket_size to
+                                           @c (N + 1) * bucket_size - 1
+                                           (should be released by
+                                           caller) */
+    unsigned int buckets_num;         /**< Number of elements in
+                                           @p buckets */
+    uint64_t ins_time;                /**< Total time spent in successful
+                                           insertions, in ns */
+    uint64_t del_time;                /**< Total time spent in successful
+                                           deletions, in ns */
+    unsigned int del_count;           /**< Number of successful
+                                           deletions */
+} net_drv_rx_rules_prof;
 
 /**
  * Create as many Rx classification rules as possible before it fails.
- * Then remove all the created rules.
+ * Then remove all the created rules. Time taken by every insertion
+ * and deletion is measured with @c CLOCK_MONOTONIC_RAW and accumulated
+ * per range of table fill levels (number of rules present in the
+ * table before the operation).
  *
  * @note To make rules different, this function iterates over all possible
  *       TCP/UDP ports for source and destination. So this function can
@@ -34,9 +87,13 @@
  * @param any_location  If @c TRUE, use special "any" location when adding
  *                      a rule. Otherwise set specific location.
  * @param queues_num    Number of available Rx queues.
+ * @param bucket_size   Number of table fill levels covered by a single
+ *                      bucket of latency statistics. If @c 0, per-bucket
+ *                      statistics are not collected.
  * @param rules_count   How many rules were created.
  * @param add_error     Which error was encountered when trying to add the
  *                      last rule.
+ * @param prof          Where to save latency profile (may be @c NULL).
  *
  * @return @c 0 on success, @c -1 on failure.
  */
@@ -48,8 +105,10 @@ extern int rpc_net_drv_too_many_rx_rules(rcf_rpc_server *rpcs,
                                          rpc_socket_type sock_type,
                                          te_bool any_location,
                                          unsigned int queues_num,
+                                         unsigned int bucket_size,
                                          unsigned int *rules_count,
-                                         te_errno *add_errno);
+                                         te_errno *add_errno,
+                                         net_drv_rx_rules_prof *prof);
 
 /**
  * Send packets trying to keep requested time intervals between them.
@@ -57,8 +116,10 @@ extern int rpc_net_drv_too_many_rx_rules(rcf_rpc_server *rpcs,
  * @note This is intended to be used with datagram sockets. Every packet has
  *       payload of 9 bytes, the first 8 bytes is 64-bit packet ordinal
  *       number in network byte order (to make it possible to detect lost
- *       packets). The last byte is 0xff, it makes it easy to skip small
+ *       packets). The last byte is nonzero, it makes it easy to skip small
  *       Ethernet frame padding at the end if it is retrieved by CSAP.
+ *       It is 0xfe if the packet was sent after a delay more than 5 times
+ *       longer than requested, and 0xff otherwise.
  *
  * @param rpcs      RPC server.
  * @param s         Socket FD.
@@ -72,6 +133,34 @@ extern int64_t rpc_net_drv_send_pkts_exact_delay(rcf_rpc_server *rpcs,
                                                  unsigned int delay,
                                                  unsigned int time2run);
 
+/**
+ * Send packets in bursts with sendmmsg(), keeping requested time
+ * intervals between starts of the bursts. Intervals are measured with
+ * @c CLOCK_MONOTONIC_RAW in nanoseconds, so this function can be used
+ * for much higher packet rates than
+ * rpc_net_drv_send_pkts_exact_delay().
+ *
+ * @note Packets have the same format as those sent by
+ *       rpc_net_drv_send_pkts_exact_delay(), so they can be received
+ *       with rpc_net_drv_recv_pkts_exact_delay(). The first packet of
+ *       a burst is marked as delayed if it is sent more than 5 gaps
+ *       after the previous burst.
+ *
+ * @param rpcs      RPC server.
+ * @param s         Socket FD.
+ * @param burst     Number of packets in a burst (no more than @c 1024).
+ * @param gap       Interval between starts of subsequent bursts,
+ *                  in nanoseconds. If @c 0, bursts are sent back to back.
+ * @param time2run  How long to send packets, in milliseconds.
+ *
+ * @return Number of sent packets on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_send_pkts_burst(rcf_rpc_server *rpcs,
+                                           int s,
+                                           unsigned int burst,
+                                           uint64_t gap,
+                                           unsigned int time2run);
+
 /**
  * Receive and check packets sent with rpc_net_drv_send_pkts_exact_delay().
  *
@@ -89,4 +178,647 @@ extern int64_t rpc_net_drv_recv_pkts_exact_delay(rcf_rpc_server *rpcs,
                                                  int s,
                                                  unsigned int time2wait);
 
+/** Rx timestamp of a packet sent with rpc_net_drv_send_pkts_exact_delay() */
+typedef struct net_drv_pkt_ts {
+    uint64_t id;    /**< Packet Id (ordinal number) */
+    uint64_t ts;    /**< Rx timestamp, in nanoseconds */
+} net_drv_pkt_ts;
+
+/**
+ * Receive and check packets sent with rpc_net_drv_send_pkts_exact_delay()
+ * or rpc_net_drv_send_pkts_burst() using recvmmsg(), obtaining kernel
+ * Rx timestamp for every packet via @c SO_TIMESTAMPING.
+ *
+ * @note If @p hw_ts_if is not @c NULL, the RPC enables
+ *       @c HWTSTAMP_FILTER_ALL on that interface with @c SIOCSHWTSTAMP
+ *       and restores the previous configuration before returning.
+ *       It fails with @c TE_EOPNOTSUPP if the interface cannot
+ *       timestamp all received packets.
+ *
+ * @param rpcs        RPC server.
+ * @param s           Socket FD.
+ * @param time2wait   How long to wait for new data, in milliseconds.
+ *                    If no new data comes during this time, the RPC
+ *                    call terminates.
+ * @param hw_ts_if    Interface on which packets are received if
+ *                    hardware timestamps should be retrieved, @c NULL
+ *                    to retrieve software ones.
+ * @param max_pkts    Maximum number of timestamps to return (packets
+ *                    received after that are still checked and counted).
+ *                    If @c 0, timestamps of all packets are returned.
+ * @param pkts        Where to save pointer to array of timestamps
+ *                    (should be released by caller, may be @c NULL).
+ * @param pkts_num    Where to save number of elements in @p pkts.
+ *
+ * @return Number of received packets on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_recv_pkts_ts(rcf_rpc_server *rpcs,
+                                        int s,
+                                        unsigned int time2wait,
+                                        const char *hw_ts_if,
+                                        unsigned int max_pkts,
+                                        net_drv_pkt_ts **pkts,
+                                        unsigned int *pkts_num);
+
+/** Summary of packet groups detected by rpc_net_drv_recv_pkts_groups() */
+typedef struct net_drv_pkt_groups {
+    unsigned int n_groups;      /**< Number of packet groups */
+    unsigned int skipped_groups; /**< Number of packet groups ignored
+                                      due to delays on sender */
+    double avg_group_time;      /**< Average duration of a packet group,
+                                     in microseconds */
+    double group_time_dev;      /**< Square root of average squared
+                                     deviation of group duration from
+                                     the expected one, in microseconds */
+    unsigned int *gap_hist;     /**< Histogram of gaps between groups
+                                     (should be released by caller) */
+    unsigned int gap_hist_len;  /**< Number of buckets in @p gap_hist */
+} net_drv_pkt_groups;
+
+/**
+ * Receive and check packets sent with rpc_net_drv_send_pkts_exact_delay()
+ * or rpc_net_drv_send_pkts_burst(), splitting them into groups (as it
+ * happens with Rx interrupts coalescing) according to their Rx
+ * timestamps. Statistics are computed on TA, only summary is returned.
+ *
+ * A packet is considered to start a new group if the delay between it and
+ * the previous packet is greater than @p min_group_delay. Group duration
+ * is the time between the first packets of the group and of the next one.
+ * If a packet of the group other than the first one or the first packet
+ * of the next group was marked by the sender as sent after an
+ * unexpectedly big delay, real duration of the group cannot be estimated
+ * and the group is ignored.
+ *
+ * @param rpcs              RPC server.
+ * @param s                 Socket FD.
+ * @param time2wait         How long to wait for new data, in milliseconds.
+ *                          If no new data comes during this time, the RPC
+ *                          call terminates.
+ * @param hw_ts_if          Interface on which packets are received if
+ *                          hardware timestamps should be used (see
+ *                          rpc_net_drv_recv_pkts_ts()), @c NULL to use
+ *                          software ones.
+ * @param min_group_delay   Minimum delay between groups, in microseconds.
+ * @param exp_group_time    Expected duration of a group, in microseconds
+ *                          (used to compute deviation).
+ * @param bucket_width      Width of a bucket in histogram of gaps between
+ *                          groups, in microseconds. The first bucket starts
+ *                          at @p min_group_delay, the last one counts all
+ *                          the larger gaps.
+ * @param buckets_num       Number of buckets in histogram (may be @c 0).
+ * @param groups            Where to save groups statistics.
+ *
+ * @return Number of received packets on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_recv_pkts_groups(rcf_rpc_server *rpcs,
+                                            int s,
+                                            unsigned int time2wait,
+                                            const char *hw_ts_if,
+                                            unsigned int min_group_delay,
+                                            unsigned int exp_group_time,
+                                            unsigned int bucket_width,
+                                            unsigned int buckets_num,
+                                            net_drv_pkt_groups *groups);
+
+/** Statistics of a sender thread of rpc_net_drv_send_pkts_mt() */
+typedef struct net_drv_send_thread_stats {
+    uint64_t pkts;      /**< Number of sent packets */
+    uint64_t bytes;     /**< Number of sent payload bytes */
+    uint64_t errors;    /**< Number of failed sendmmsg() calls */
+} net_drv_send_thread_stats;
+
+/**
+ * Send UDP packets from multiple threads at a given or the maximum
+ * possible rate.
+ * Every thread is bound to its own CPU and sends packets in bursts
+ * with sendmmsg() over its own connected socket. If source port is not
+ * zero, thread @c N binds its socket to that port plus @c N, so that
+ * RSS on the receiver can spread flows of different threads across
+ * Rx queues.
+ *
+ * @note Send errors (like @c ENOBUFS) do not stop sending, they are
+ *       only counted.
+ *
+ * @param rpcs          RPC server.
+ * @param src_addr      Source address (if port is zero, every socket
+ *                      is bound to an ephemeral port).
+ * @param dst_addr      Destination address.
+ * @param cpus          CPUs to which to bind sender threads (one thread
+ *                      is created per element; negative value means
+ *                      that the thread is not bound to any CPU).
+ * @param threads_num   Number of elements in @p cpus.
+ * @param pkt_size      Size of UDP payload.
+ * @param burst         Number of packets passed to a single sendmmsg()
+ *                      call.
+ * @param rate          Total sending rate, in packets per second, shared
+ *                      equally between threads (@c 0 - send at the
+ *                      maximum possible rate).
+ * @param time2run      How long to send packets, in milliseconds.
+ * @param stats         Where to save pointer to array of per-thread
+ *                      statistics (should be released by caller, may be
+ *                      @c NULL).
+ *
+ * @return Total number of sent packets on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_send_pkts_mt(rcf_rpc_server *rpcs,
+                                        const struct sockaddr *src_addr,
+                                        const struct sockaddr *dst_addr,
+                                        const int *cpus,
+                                        unsigned int threads_num,
+                                        unsigned int pkt_size,
+                                        unsigned int burst,
+                                        uint64_t rate,
+                                        unsigned int time2run,
+                                        net_drv_send_thread_stats **stats);
+
+/** Fields of a packet which can be collected by rpc_net_drv_capture_pkts() */
+typedef enum net_drv_capt_field {
+    NET_DRV_CAPT_TS = 0x1,          /**< Rx timestamp */
+    NET_DRV_CAPT_LEN = 0x2,         /**< Packet length */
+    NET_DRV_CAPT_VLAN = 0x4,        /**< VLAN TPID and TCI */
+    NET_DRV_CAPT_TCP_SEQ = 0x8,     /**< TCP sequence number */
+    NET_DRV_CAPT_TCP_LEN = 0x10,    /**< TCP payload length */
+    NET_DRV_CAPT_TCP_FLAGS = 0x20,  /**< TCP flags */
+} net_drv_capt_field;
+
+/**
+ * Packet record returned by rpc_net_drv_capture_pkts(). Only requested
+ * fields are filled, the rest are zero. TCP fields are zero for packets
+ * which are not TCP.
+ */
+typedef struct net_drv_capt_rec {
+    uint64_t ts;          /**< Rx timestamp, in nanoseconds */
+    uint32_t len;         /**< Packet length (including Ethernet header) */
+    uint16_t vlan_tpid;   /**< VLAN TPID (@c 0 if there is no VLAN tag) */
+    uint16_t vlan_tci;    /**< VLAN TCI */
+    uint32_t tcp_seq;     /**< TCP sequence number */
+    uint32_t tcp_len;     /**< TCP payload length */
+    uint8_t tcp_flags;    /**< TCP flags */
+} net_drv_capt_rec;
+
+/**
+ * Capture packets on an interface using @c AF_PACKET socket with
+ * @c TPACKET_V3 memory-mapped Rx ring. Packets are parsed on TA and
+ * only requested fields are returned, packed together in a single
+ * transfer. This is much cheaper than capturing with CSAP, so it can
+ * be used at high packet rates.
+ *
+ * @note VLAN tag is taken from packet metadata if it was stripped by
+ *       the NIC, otherwise from the packet itself. IPv6 extension headers
+ *       are not parsed.
+ *
+ * @param rpcs          RPC server.
+ * @param if_name       Interface name.
+ * @param filter        Classic BPF filter (may be @c NULL). Value
+ *                      returned by it limits how many bytes of a packet
+ *                      are copied to the ring, so it should be large
+ *                      enough to include all the headers. If there is
+ *                      no filter, all packets are captured.
+ * @param filter_len    Number of instructions in @p filter.
+ * @param fields        Fields to collect (bitmask of
+ *                      @ref net_drv_capt_field values).
+ * @param time2run      How long to capture packets, in milliseconds.
+ * @param max_pkts      Maximum number of records to return (packets
+ *                      captured after that are only counted). If @c 0,
+ *                      records for all packets are returned. It is also
+ *                      used to size the capture ring (from 4 to 64 MiB,
+ *                      16 MiB if @c 0), so it should be set to the
+ *                      expected number of packets if it is known.
+ * @param recs          Where to save pointer to array of packet records
+ *                      (should be released by caller, may be @c NULL).
+ * @param recs_num      Where to save number of elements in @p recs.
+ * @param drops         Where to save number of packets dropped by
+ *                      kernel because the ring was full (may be
+ *                      @c NULL).
+ *
+ * @return Number of captured packets on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_capture_pkts(rcf_rpc_server *rpcs,
+                                        const char *if_name,
+                                        const struct sock_filter *filter,
+                                        unsigned int filter_len,
+                                        unsigned int fields,
+                                        unsigned int time2run,
+                                        unsigned int max_pkts,
+                                        net_drv_capt_rec **recs,
+                                        unsigned int *recs_num,
+                                        uint64_t *drops);
+
+/** Statistics of rpc_net_drv_send_zc() */
+typedef struct net_drv_zc_stats {
+    uint64_t calls;         /**< Number of successful send() calls */
+    uint64_t zc_completed;  /**< Number of send() calls for which
+                                 zero-copy completion was received */
+    uint64_t zc_copied;     /**< Number of send() calls for which
+                                 completion reported that data was
+                                 copied instead of being sent
+                                 without copying */
+    uint64_t cpu_time;      /**< CPU time (user and system) consumed by
+                                 the sending thread, in nanoseconds */
+} net_drv_zc_stats;
+
+/**
+ * Send data over a connected socket for a given time, optionally using
+ * @c MSG_ZEROCOPY. In zero-copy mode completion notifications are read
+ * from socket error queue while sending, and after that the function
+ * waits for the remaining ones for a while.
+ *
+ * @param rpcs        RPC server.
+ * @param s           Socket FD.
+ * @param buf_size    Size of buffer passed to every send() call.
+ * @param time2run    How long to send data, in milliseconds.
+ * @param zerocopy    If @c TRUE, enable @c SO_ZEROCOPY on the socket
+ *                    and send with @c MSG_ZEROCOPY.
+ * @param stats       Where to save statistics (may be @c NULL).
+ *
+ * @return Number of sent bytes on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_send_zc(rcf_rpc_server *rpcs,
+                                   int s,
+                                   unsigned int buf_size,
+                                   unsigned int time2run,
+                                   te_bool zerocopy,
+                                   net_drv_zc_stats *stats);
+
+/** Statistics of rpc_net_drv_send_udp_gso() */
+typedef struct net_drv_udp_gso_stats {
+    uint64_t calls;     /**< Number of successful sendmsg() calls */
+    uint64_t segs;      /**< Number of UDP datagrams which should
+                             appear on the wire */
+    uint64_t cpu_time;  /**< CPU time (user and system) consumed by
+                             the sending thread, in nanoseconds */
+} net_drv_udp_gso_stats;
+
+/**
+ * Send UDP super-buffers with @c UDP_SEGMENT control message, so that
+ * every buffer is split into datagrams of @p gso_size bytes (the last
+ * one may be shorter) by NIC or by kernel. Sending stops when
+ * @p time2run expires or @p max_calls buffers are sent.
+ *
+ * @param rpcs        RPC server.
+ * @param s           Connected UDP socket.
+ * @param buf_len     Length of a super-buffer.
+ * @param gso_size    Size of UDP payload of a segment. If @c 0, buffers
+ *                    are sent without segmentation.
+ * @param time2run    How long to send, in milliseconds.
+ * @param max_calls   Maximum number of sendmsg() calls (@c 0 means
+ *                    no limit).
+ * @param stats       Where to save statistics (may be @c NULL).
+ *
+ * @return Number of sent bytes on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_send_udp_gso(rcf_rpc_server *rpcs,
+                                        int s,
+                                        unsigned int buf_len,
+                                        unsigned int gso_size,
+                                        unsigned int time2run,
+                                        unsigned int max_calls,
+                                        net_drv_udp_gso_stats *stats);
+
+/** Statistics of rpc_net_drv_recv_udp_gro() */
+typedef struct net_drv_udp_gro_stats {
+    uint64_t segs;              /**< Number of received segments
+                                     (coalesced datagrams are split
+                                     according to reported GSO size) */
+    uint64_t bytes;             /**< Number of received bytes */
+    uint64_t coalesced;         /**< Number of datagrams received with
+                                     @c UDP_GRO control message */
+    unsigned int max_segs;      /**< Maximum number of segments in
+                                     a coalesced datagram */
+    unsigned int gso_size;      /**< GSO size reported for the last
+                                     coalesced datagram */
+    uint64_t gso_size_mismatch; /**< How many times reported GSO size
+                                     differed from the previous one */
+} net_drv_udp_gro_stats;
+
+/**
+ * Receive UDP datagrams until no new data arrives for @p time2wait
+ * milliseconds, optionally enabling @c UDP_GRO on the socket and
+ * counting datagrams coalesced by GRO.
+ *
+ * @param rpcs        RPC server.
+ * @param s           UDP socket.
+ * @param gro         If @c TRUE, enable @c UDP_GRO socket option.
+ * @param time2wait   How long to wait for new data, in milliseconds.
+ * @param stats       Where to save statistics (may be @c NULL).
+ *
+ * @return Number of received datagrams on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_recv_udp_gro(rcf_rpc_server *rpcs,
+                                        int s,
+                                        te_bool gro,
+                                        unsigned int time2wait,
+                                        net_drv_udp_gro_stats *stats);
+
+/** RTT statistics collected by rpc_net_drv_pingpong_client() */
+typedef struct net_drv_rtt_stats {
+    uint64_t count;     /**< Number of replies received in time */
+    uint64_t lost;      /**< Number of requests for which replies were
+                             not received in time (replies arriving
+                             later are ignored) */
+    uint64_t min;       /**< Minimum RTT, in nanoseconds */
+    uint64_t max;       /**< Maximum RTT, in nanoseconds */
+    uint64_t mean;      /**< Mean RTT, in nanoseconds */
+} net_drv_rtt_stats;
+
+/**
+ * Send requests to a ping-pong server (see rpc_net_drv_pingpong_server())
+ * keeping @p depth of them in flight, and measure RTT of every request.
+ * RTTs are collected in a histogram in the agent, from which requested
+ * percentiles are computed (with relative error not exceeding 1/16).
+ *
+ * @param rpcs          RPC server.
+ * @param s             Connected TCP or UDP socket.
+ * @param msg_size      Size of request and reply (at least @c 8 bytes).
+ * @param depth         Number of requests in flight.
+ * @param time2run      How long to send requests, in milliseconds.
+ * @param percentiles   Percentiles to compute, in thousandths of
+ *                      percent (e.g. @c 99900 for p99.9).
+ * @param pct_num       Number of elements in @p percentiles.
+ * @param pct_values    Where to save computed percentiles, in
+ *                      nanoseconds (should have space for @p pct_num
+ *                      elements).
+ * @param stats         Where to save RTT statistics (may be @c NULL).
+ *
+ * @return Number of received replies on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_pingpong_client(rcf_rpc_server *rpcs,
+                                           int s,
+                                           unsigned int msg_size,
+                                           unsigned int depth,
+                                           unsigned int time2run,
+                                           const unsigned int *percentiles,
+                                           unsigned int pct_num,
+                                           uint64_t *pct_values,
+                                           net_drv_rtt_stats *stats);
+
+/**
+ * Send back every message received on a socket until no new messages
+ * arrive for @p time2wait milliseconds or connection is closed.
+ *
+ * @param rpcs          RPC server.
+ * @param s             TCP or UDP socket.
+ * @param msg_size      Size of a message.
+ * @param time2wait     How long to wait for new messages, in
+ *                      milliseconds.
+ *
+ * @return Number of processed messages on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_pingpong_server(rcf_rpc_server *rpcs,
+                                           int s,
+                                           unsigned int msg_size,
+                                           unsigned int time2wait);
+
+/** Statistics of rpc_net_drv_uring_send() */
+typedef struct net_drv_uring_send_stats {
+    uint64_t completions;   /**< Number of completed writes */
+    uint64_t errors;        /**< Number of writes completed with
+                                 error */
+} net_drv_uring_send_stats;
+
+/**
+ * Send data over a socket with io_uring, keeping @p depth writes from
+ * registered buffers in flight. Requests which are still in flight
+ * when @p time2run expires are cancelled.
+ *
+ * @param rpcs          RPC server.
+ * @param s             Connected socket.
+ * @param min_size      Minimum size of data passed to a single write.
+ * @param max_size      Maximum size of data passed to a single write.
+ * @param depth         Number of writes in flight.
+ * @param time2run      How long to send, in milliseconds.
+ * @param ignore_err    If @c TRUE, do not stop on write errors.
+ * @param stats         Where to save statistics (may be @c NULL).
+ *
+ * @return Number of sent bytes on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_uring_send(rcf_rpc_server *rpcs,
+                                      int s,
+                                      unsigned int min_size,
+                                      unsigned int max_size,
+                                      unsigned int depth,
+                                      unsigned int time2run,
+                                      te_bool ignore_err,
+                                      net_drv_uring_send_stats *stats);
+
+/**
+ * Receive data from a socket with io_uring multishot recv using
+ * a ring of provided buffers, until @p time2run expires or connection
+ * is closed.
+ *
+ * @param rpcs          RPC server.
+ * @param s             Socket.
+ * @param buf_size      Size of a receive buffer.
+ * @param bufs_num      Number of receive buffers (rounded up to
+ *                      a power of 2).
+ * @param time2run      How long to receive, in milliseconds.
+ * @param completions   Where to save number of completions
+ *                      (may be @c NULL).
+ *
+ * @return Number of received bytes on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_uring_recv(rcf_rpc_server *rpcs,
+                                      int s,
+                                      unsigned int buf_size,
+                                      unsigned int bufs_num,
+                                      unsigned int time2run,
+                                      uint64_t *completions);
+
+/** Threaded NAPI kernel thread returned by rpc_net_drv_napi_threads() */
+typedef struct net_drv_napi_thread {
+    int pid;                /**< Thread ID */
+    unsigned int napi_id;   /**< NAPI instance ID (@c 0 if unknown) */
+    uint64_t cpu_time;      /**< CPU time consumed by the thread,
+                                 in nanoseconds */
+    uint64_t ts;            /**< When @p cpu_time was obtained
+                                 (@c CLOCK_MONOTONIC_RAW time on TA),
+                                 in nanoseconds */
+    int cpu;                /**< CPU the thread ran on last time */
+} net_drv_napi_thread;
+
+/**
+ * Find threaded NAPI kernel threads (@c napi/<if>-<id>) of an
+ * interface, optionally binding them to CPUs, and get their CPU usage.
+ *
+ * @param rpcs          RPC server.
+ * @param if_name       Interface name.
+ * @param cpus          CPUs to bind threads to: thread @c N is bound to
+ *                      CPU @c cpus[N % cpus_num] (may be @c NULL to
+ *                      keep affinity).
+ * @param cpus_num      Number of elements in @p cpus.
+ * @param threads       Where to save pointer to array of threads
+ *                      (should be released by caller, may be @c NULL).
+ *
+ * @return Number of found threads on success, @c -1 on failure.
+ */
+extern int rpc_net_drv_napi_threads(rcf_rpc_server *rpcs,
+                                    const char *if_name,
+                                    const int *cpus,
+                                    unsigned int cpus_num,
+                                    net_drv_napi_thread **threads);
+
+/** Flags of AF_XDP sockets created by rpc_net_drv_xsk_batch() */
+typedef enum net_drv_xsk_flag {
+    NET_DRV_XSK_COPY = 0x1,         /**< Force copy mode */
+    NET_DRV_XSK_ZEROCOPY = 0x2,     /**< Force zero-copy mode */
+    NET_DRV_XSK_NEED_WAKEUP = 0x4,  /**< Use need_wakeup ring flag */
+} net_drv_xsk_flag;
+
+/** What rpc_net_drv_xsk_batch() does with received packets */
+typedef enum net_drv_xsk_mode {
+    NET_DRV_XSK_RX_DROP,    /**< Return frames to FILL ring at once */
+    NET_DRV_XSK_FWD,        /**< Send packets back over Tx ring with
+                                 swapped MAC addresses */
+} net_drv_xsk_mode;
+
+/** Statistics of a queue served by rpc_net_drv_xsk_batch() */
+typedef struct net_drv_xsk_queue_stats {
+    uint64_t rx_pkts;   /**< Number of received packets */
+    uint64_t tx_pkts;   /**< Number of packets passed to Tx ring */
+    uint64_t wakeups;   /**< Number of system calls made to wake up
+                             the kernel */
+} net_drv_xsk_queue_stats;
+
+/**
+ * Receive (and optionally send back) packets over AF_XDP sockets in
+ * batches for a given time.
+ * For every queue an AF_XDP socket with its own UMEM is created, bound
+ * to that queue of the interface and inserted to XSK map under the
+ * queue number; then a separate thread processes up to @p batch
+ * packets at once from its Rx ring. Sockets are closed when the
+ * function returns.
+ *
+ * @note The RPC fails with @c TE_ENOSYS if Test Agent was built without
+ *       AF_XDP support and with @c TE_EOPNOTSUPP if a socket cannot be
+ *       bound to the interface in the requested mode.
+ *
+ * @param rpcs          RPC server.
+ * @param if_name       Interface name.
+ * @param map_fd        File descriptor of XSK map used by XDP program
+ *                      attached to the interface.
+ * @param queues        Queues to which to bind sockets.
+ * @param cpus          CPUs to which to bind threads of @p queues
+ *                      (negative value means that the thread is not
+ *                      bound to any CPU; may be @c NULL).
+ * @param queues_num    Number of elements in @p queues (and @p cpus).
+ * @param frame_size    Size of UMEM frame (power of 2).
+ * @param frames_num    Number of frames in UMEM of every socket, also
+ *                      used as size of FILL and COMPLETION rings
+ *                      (power of 2).
+ * @param ring_size     Size of Rx and Tx rings (power of 2).
+ * @param flags         Bitmask of net_drv_xsk_flag values.
+ * @param mode          What to do with received packets.
+ * @param batch         Maximum number of packets processed at once.
+ * @param time2run      How long to process packets, in milliseconds.
+ * @param stats         Where to save pointer to array of per-queue
+ *                      statistics (should be released by caller, may be
+ *                      @c NULL).
+ *
+ * @return Total number of received packets on success, @c -1 on failure.
+ */
+extern int64_t rpc_net_drv_xsk_batch(rcf_rpc_server *rpcs,
+                                     const char *if_name, int map_fd,
+                                     const unsigned int *queues,
+                                     const int *cpus,
+                                     unsigned int queues_num,
+                                     unsigned int frame_size,
+                                     unsigned int frames_num,
+                                     unsigned int ring_size,
+                                     unsigned int flags,
+                                     net_drv_xsk_mode mode,
+                                     unsigned int batch,
+                                     unsigned int time2run,
+                                     net_drv_xsk_queue_stats **stats);
+
+/** Statistics of a thread of rpc_net_drv_cps_client/server() */
+typedef struct net_drv_cps_thread_stats {
+    uint64_t conns;     /**< Number of completed connections */
+    uint64_t errors;    /**< Number of failed connections */
+} net_drv_cps_thread_stats;
+
+/**
+ * Open TCP connections to a server as fast as possible from multiple
+ * threads. Over every connection a request is sent and a response is
+ * received, then the client waits until the server closes
+ * the connection and closes it too.
+ *
+ * @note Failed connections (including timeouts of blocking calls)
+ *       do not stop the client, they are only counted.
+ *
+ * @param rpcs          RPC server.
+ * @param dst_addr      Server address.
+ * @param cpus          CPUs to which to bind client threads (one thread
+ *                      is created per element; negative value means
+ *                      that the thread is not bound to any CPU).
+ * @param threads_num   Number of elements in @p cpus.
+ * @param req_size      Size of request.
+ * @param resp_size     Size of response.
+ * @param time2run      How long to open connections, in milliseconds.
+ * @param stats         Where to save pointer to array of per-thread
+ *                      statistics (should be released by caller, may be
+ *                      @c NULL).
+ * @param syn_retrans   Where to save increment of host-wide
+ *                      @c TCPSynRetrans counter (may be @c NULL).
+ *
+ * @return Total number of completed connections on success, @c -1 on
+ *         failure.
+ */
+extern int64_t rpc_net_drv_cps_client(rcf_rpc_server *rpcs,
+                                      const struct sockaddr *dst_addr,
+                                      const int *cpus,
+                                      unsigned int threads_num,
+                                      unsigned int req_size,
+                                      unsigned int resp_size,
+                                      unsigned int time2run,
+                                      net_drv_cps_thread_stats **stats,
+                                      uint64_t *syn_retrans);
+
+/**
+ * Accept TCP connections from multiple threads listening on the same
+ * address with @c SO_REUSEPORT. Over every connection a request is
+ * received and a response is sent, then the connection is closed.
+ *
+ * @param rpcs          RPC server.
+ * @param addr          Address to listen on.
+ * @param cpus          CPUs to which to bind server threads (one thread
+ *                      is created per element; negative value means
+ *                      that the thread is not bound to any CPU).
+ * @param threads_num   Number of elements in @p cpus.
+ * @param req_size      Size of request.
+ * @param resp_size     Size of response.
+ * @param time2run      How long to accept connections, in milliseconds.
+ * @param stats         Where to save pointer to array of per-thread
+ *                      statistics (should be released by caller, may be
+ *                      @c NULL).
+ *
+ * @return Total number of completed connections on success, @c -1 on
+ *         failure.
+ */
+extern int64_t rpc_net_drv_cps_server(rcf_rpc_server *rpcs,
+                                      const struct sockaddr *addr,
+                                      const int *cpus,
+                                      unsigned int threads_num,
+                                      unsigned int req_size,
+                                      unsigned int resp_size,
+                                      unsigned int time2run,
+                                      net_drv_cps_thread_stats **stats);
+
+/**
+ * Get page pools of an interface from netdev generic netlink family
+ * (requires Linux 6.8 or newer).
+ *
+ * @param rpcs          RPC server.
+ * @param if_name       Interface name.
+ * @param inflight      Where to save total number of pages held by
+ *                      the pools (may be @c NULL).
+ * @param inflight_mem  Where to save total memory held by the pools,
+ *                      in bytes (may be @c NULL).
+ *
+ * @return Number of page pools on success, @c -1 on failure.
+ */
+extern int rpc_net_drv_page_pools(rcf_rpc_server *rpcs,
+                                  const char *if_name,
+                                  uint64_t *inflight,
+                                  uint64_t *inflight_mem);
+
 #endif /* !__TS_NET_DRV_RPC_H__ */
@@ -39,6 +39,7 @@
 #include "net_drv_ts.h"
 #include "net_drv_data_flow.h"
 #include "net_drv_ethtool.h"
+#include "net_drv_perf.h"
 #include "net_drv_ptp.h"
 #include "net_drv_rpc.h"
 
@@ -19,6 +19,7 @@
 #include "tapi_cfg_base.h"
 #include "te_ethernet.h"
 #include "tapi_cfg_phy.h"
+#include "tapi_rpc_misc.h"
 
 #define MAX_PKT_LEN 1024
 
@@ -785,3 +786,113 @@ net_drv_ts_add_vlan(const char *ta1, const char *ta2,
     else
         free(new_addr2);
 }
+
+/**
+ * Get numeric attribute from output of @b ip -d link.
+ *
+ * @param out           Command output.
+ * @param attr          Attribute name.
+ * @param value         Where to save attribute value.
+ *
+ * @return Status code.
+ */
+static te_errno
+get_ip_link_attr(const char *out, const char *attr, unsigned int *value)
+{
+    te_string str = TE_STRING_INIT;
+    const char *p;
+    char *end;
+
+    te_string_append(&str, " %s ", attr);
+    p = strstr(out, te_string_value(&str));
+    if (p == NULL)
+    {
+        ERROR("%s(): '%s' is not reported", __FUNCTION__, attr);
+        te_string_free(&str);
+        return TE_RC(TE_TAPI, TE_ENOENT);
+    }
+
+    p += str.len;
+    te_string_free(&str);
+
+    *value = strtoul(p, &end, 10);
+    if (end == p)
+    {
+        ERROR("%s(): failed to parse value of '%s'", __FUNCTION__, attr);
+        return TE_RC(TE_TAPI, TE_EINVAL);
+    }
+
+    return 0;
+}
+
+/* See description in net_drv_ts.h */
+te_errno
+net_drv_get_gso_limits(rcf_rpc_server *rpcs, const char *if_name,
+                       int family, net_drv_gso_limits *limits)
+{
+    rpc_wait_status status;
+    char *out = NULL;
+    te_errno rc;
+
+    RPC_AWAIT_ERROR(rpcs);
+    status = rpc_shell_get_all(rpcs, &out, "ip -d link show dev %s", -1,
+                               if_name);
+    if (status.flag != RPC_WAIT_STATUS_EXITED ||
+        status.value != 0)
+    {
+        ERROR("%s(): failed to get link attributes of %s",
+              __FUNCTION__, if_name);
+        free(out);
+        return TE_RC(TE_TAPI, TE_EFAIL);
+    }
+
+    rc = get_ip_link_attr(out, "tso_max_size", &limits->tso_max_size);
+    if (rc == 0)
+    {
+        rc = get_ip_link_attr(out, family == AF_INET ?
+                                        "gso_ipv4_max_size" :
+                                        "gso_max_size",
+                              &limits->gso_max_size);
+    }
+    if (rc == 0)
+    {
+        rc = get_ip_link_attr(out, family == AF_INET ?
+                                        "gro_ipv4_max_size" :
+                                        "gro_max_size",
+                              &limits->gro_max_size);
+    }
+
+    free(out);
+    return rc;
+}
+
+/* See description in net_drv_ts.h */
+te_errno
+net_drv_set_gso_limits(rcf_rpc_server *rpcs, const char *if_name,
+                       int family, unsigned int gso_max_size,
+                       unsigned int gro_max_size)
+{
+    rpc_wait_status status;
+
+    RPC_AWAIT_ERROR(rpcs);
+    status = rpc_system_ex(rpcs, "ip link set dev %s %s %u %s %u",
+                           if_name,
+                           family == AF_INET ? "gso_ipv4_max_size" :
+                                               "gso_max_size",
+                           gso_max_size,
+                           family == AF_INET ? "gro_ipv4_max_size" :
+                                               "gro_max_size",
+                           gro_max_size);
+    if (status.flag != RPC_WAIT_STATUS_EXITED ||
+        status.value != 0)
+    {
+        ERROR("%s(): failed to set GSO/GRO maximum size to %u/%u on %s",
+              __FUNCTION__, gso_max_size, gro_max_size, if_name);
+        return TE_RC(TE_TAPI, TE_EFAIL);
+    }
+
+    RING("GSO/GRO maximum size on %s is set to %u/%u", if_name,
+         gso_max_size, gro_max_size);
+
+    return 0;
+}
@@ -406,4 +406,57 @@ extern void net_drv_ts_add_vlan(const char *ta1, const char *ta2,
                                 struct sockaddr **vlan_addr1,
                                 struct sockaddr **vlan_addr2);
 
+/** Maximum size of TCP super-packets without BIG TCP */
+#define NET_DRV_GSO_LEGACY_SIZE 65536
+
+/** Maximum size of TCP super-packets set on an interface for BIG TCP */
+#define NET_DRV_BIG_TCP_SIZE 185000
+
+/**
+ * Size limits of TCP super-packets of an interface, as reported by
+ * @b ip -d link. For IPv4 the separate @b gso_ipv4_max_size and
+ * @b gro_ipv4_max_size limits are used.
+ */
+typedef struct net_drv_gso_limits {
+    unsigned int tso_max_size;  /**< Maximum TSO packet size supported
+                                     by driver */
+    unsigned int gso_max_size;  /**< Maximum size of GSO packets passed
+                                     to driver */
+    unsigned int gro_max_size;  /**< Maximum size of packets built by
+                                     GRO */
+} net_drv_gso_limits;
+
+/**
+ * Get size limits of TCP super-packets of an interface.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param family        Address family (@c AF_INET or @c AF_INET6).
+ * @param limits        Where to save the limits.
+ *
+ * @return Status code (@c TE_ENOENT if some limit is not reported,
+ *         i.e. it is not supported by kernel or @b ip tool).
+ */
+extern te_errno net_drv_get_gso_limits(rcf_rpc_server *rpcs,
+                                       const char *if_name, int family,
+                                       net_drv_gso_limits *limits);
+
+/**
+ * Set size limits of GSO and GRO TCP packets of an interface with
+ * @b ip link. Values above 64KB enable BIG TCP. Sockets should be
+ * created after that since they get the limit when connecting.
+ *
+ * @param rpcs          RPC server on the host.
+ * @param if_name       Interface name.
+ * @param family        Address family (@c AF_INET or @c AF_INET6).
+ * @param gso_max_size  Maximum size of GSO packets.
+ * @param gro_max_size  Maximum size of GRO packets.
+ *
+ * @return Status code.
+ */
+extern te_errno net_drv_set_gso_limits(rcf_rpc_server *rpcs,
+                                       const char *if_name, int family,
+                                       unsigned int gso_max_size,
+                                       unsigned int gro_max_size);
+
 #endif /* !__TS_NET_DRV_TS_H__ */
@@ -0,0 +1,504 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Offloads tests
+ */
+
+/**
+ * @defgroup offload-big_tcp BIG TCP
+ * @ingroup offload
+ * @{
+ *
+ * @objective Check that when GSO and GRO maximum sizes of IUT interface
+ *            are raised above 64KB (BIG TCP), TSO still splits larger
+ *            packets into MSS-sized ones and GRO builds packets larger
+ *            than 64KB.
+ *
+ * @param env           Testing environment:
+ *                      - @ref env-peer2peer
+ *                      - @ref env-peer2peer_ipv6
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME "offload/big_tcp"
+
+#include "net_drv_test.h"
+#include "tapi_cfg_base.h"
+#include "tapi_cfg_if.h"
+#include "tapi_cfg_if_coalesce.h"
+#include "tapi_tcp.h"
+#include "tapi_eth.h"
+
+/** Minimum number of bytes to pass to send() call */
+#define MIN_SEND_SIZE 100000
+/** Maximum number of bytes to pass to send() call */
+#define MAX_SEND_SIZE 300000
+/** Number of bytes to send in every direction */
+#define TOTAL_SIZE 10000000
+/** Maximum time to send or receive, in seconds */
+#define TIME_TO_SEND 10
+
+/** Value of rx_coalesce_usecs interrupt coalescing parameter */
+#define RX_COALESCE_USECS 300
+
+/** Auxiliary structure to pass information to/from CSAP callback */
+typedef struct pkts_info {
+    unsigned int mss;
+    te_bool by_seqn;
+
+    unsigned int pkts_num;
+    uint32_t first_seqn;
+    uint32_t last_seqn;
+    uint64_t seqn_span;
+
+    unsigned int max_size;
+    unsigned int big_pkts_num;
+    unsigned int huge_pkts_num;
+    uint64_t total_len;
+
+    te_bool failed;
+} pkts_info;
+
+/** Account a packet with a given TCP payload size */
+static void
+account_pkt(pkts_info *info, unsigned int len)
+{
+    info->total_len += len;
+
+    if (len > info->max_size)
+        info->max_size = len;
+    if (len > info->mss)
+        info->big_pkts_num++;
+    if (len > NET_DRV_GSO_LEGACY_SIZE)
+        info->huge_pkts_num++;
+}
+
+/** Callback to process packets captured by CSAP */
+static void
+process_pkts(asn_value *pkt, void *arg)
+{
+    pkts_info *info = (pkts_info *)arg;
+    unsigned int pld_len;
+    uint64_t span;
+    uint32_t seqn;
+    te_errno rc;
+
+    rc = asn_read_uint32(pkt, &seqn, "pdus.0.#tcp.seqn");
+    if (rc != 0)
+    {
+        ERROR("Failed to get SEQN: %r", rc);
+        info->failed = TRUE;
+        goto cleanup;
+    }
+
+    if (info->by_seqn)
+    {
+        /*
+         * Length fields of IP header are zero in packets larger than
+         * 64KB, so size of a packet is computed as difference between
+         * SEQN of the next data packet and its SEQN. Retransmits and
+         * pure ACKs are ignored, the last packet is not counted.
+         */
+        if (info->pkts_num == 0)
+        {
+            info->last_seqn = seqn;
+        }
+        else if (tapi_tcp_compare_seqn(seqn, info->last_seqn) > 0)
+        {
+            account_pkt(info, seqn - info->last_seqn);
+            info->last_seqn = seqn;
+        }
+    }
+    else
+    {
+        rc = tapi_tcp_get_hdrs_payload_len(pkt, NULL, &pld_len);
+        if (rc != 0)
+        {
+            ERROR("Failed to get packet payload length, rc=%r", rc);
+            info->failed = TRUE;
+            goto cleanup;
+        }
+
+        account_pkt(info, pld_len);
+
+        /*
+         * Retransmitted data is counted in total_len more than once,
+         * so the amount of data is estimated by SEQN span of the
+         * captured packets.
+         */
+        if (info->pkts_num == 0)
+        {
+            info->first_seqn = seqn;
+            info->last_seqn = seqn;
+            info->seqn_span = pld_len;
+        }
+        else
+        {
+            if (tapi_tcp_compare_seqn(seqn, info->last_seqn) > 0)
+                info->last_seqn = seqn;
+
+            if (tapi_tcp_compare_seqn(seqn, info->first_seqn) < 0)
+            {
+                info->seqn_span += (uint32_t)(info->first_seqn - seqn);
+                info->first_seqn = seqn;
+            }
+
+            span = (uint32_t)(seqn - info->first_seqn) + (uint64_t)pld_len;
+            if (span > info->seqn_span)
+                info->seqn_span = span;
+        }
+    }
+
+    info->pkts_num++;
+
+cleanup:
+
+    asn_free_value(pkt);
+}
+
+/**
+ * Stop a CSAP and process packets captured by it.
+ *
+ * @param ta            Test Agent name.
+ * @param csap          CSAP handle.
+ * @param mss           MSS.
+ * @param by_seqn       If @c TRUE, compute packet sizes from SEQNs.
+ * @param csap_name     CSAP name to use in verdicts.
+ * @param info          Where to save information about packets.
+ */
+static void
+get_captured_pkts(const char *ta, csap_handle_t csap, int mss,
+                  te_bool by_seqn, const char *csap_name, pkts_info *info)
+{
+    tapi_tad_trrecv_cb_data csap_cb_data;
+
+    memset(info, 0, sizeof(*info));
+    info->mss = mss;
+    info->by_seqn = by_seqn;
+
+    memset(&csap_cb_data, 0, sizeof(csap_cb_data));
+    csap_cb_data.callback = &process_pkts;
+    csap_cb_data.user_data = info;
+
+    rcf_tr_op_log(FALSE);
+    CHECK_RC(tapi_tad_trrecv_stop(ta, 0, csap, &csap_cb_data, NULL));
+    rcf_tr_op_log(TRUE);
+
+    RING("%s CSAP captured %u packets with %" TE_PRINTF_64 "u bytes, "
+         "%u of them were larger than MSS, %u larger than 64KB, "
+         "maximum size is %u", csap_name, info->pkts_num,
+         info->total_len, info->big_pkts_num, info->huge_pkts_num,
+         info->max_size);
+
+    if (info->failed)
+    {
+        TEST_VERDICT("Failed to process captured packet(s) from %s CSAP",
+                     csap_name);
+    }
+
+    if (info->pkts_num == 0)
+        TEST_VERDICT("No packets were captured on %s CSAP", csap_name);
+}
+
+/**
+ * Create a CSAP capturing TCP packets and start it.
+ *
+ * @param rpcs          RPC server.
+ * @param if_name       Interface name.
+ * @param mode          Receive mode.
+ * @param src_addr      Source address of packets.
+ * @param dst_addr      Destination address of packets.
+ *
+ * @return CSAP handle.
+ */
+static csap_handle_t
+start_csap(rcf_rpc_server *rpcs, const char *if_name, unsigned int mode,
+           const struct sockaddr *src_addr,
+           const struct sockaddr *dst_addr)
+{
+    csap_handle_t csap = CSAP_INVALID_HANDLE;
+
+    CHECK_RC(tapi_tcp_ip_eth_csap_create(
+        rpcs->ta, 0, if_name,
+        mode | TAD_ETH_RECV_NO_PROMISC,
+        NULL, NULL,
+        dst_addr->sa_family,
+        TAD_SA2ARGS(dst_addr, src_addr),
+        &csap));
+
+    CHECK_RC(tapi_tad_trrecv_start(rpcs->ta, 0, csap,
+                                   NULL, TAD_TIMEOUT_INF, 0,
+                                   RCF_TRRECV_PACKETS));
+
+    return csap;
+}
+
+/**
+ * Send data with help of rpc_pattern_sender(), receiving and checking
+ * it on peer with rpc_pattern_receiver().
+ *
+ * @param rpcs_sender       RPC server from which to send.
+ * @param s_sender          Socket from which to send.
+ * @param rpcs_receiver     RPC server on which to receive.
+ * @param s_receiver        Socket on which to receive.
+ *
+ * @return Number of bytes sent and received.
+ */
+static uint64_t
+transfer_data(rcf_rpc_server *rpcs_sender, int s_sender,
+              rcf_rpc_server *rpcs_receiver, int s_receiver)
+{
+    tapi_pat_sender send_ctx;
+    tapi_pat_receiver recv_ctx;
+    tarpc_pat_gen_arg *pat_arg = NULL;
+    int rc;
+
+    tapi_pat_sender_init(&send_ctx);
+    tapi_pat_receiver_init(&recv_ctx);
+    send_ctx.time2wait = TAPI_WAIT_NETWORK_DELAY;
+    recv_ctx.time2wait = TAPI_WAIT_NETWORK_DELAY;
+    send_ctx.duration_sec = TIME_TO_SEND;
+    recv_ctx.duration_sec = TIME_TO_SEND;
+    send_ctx.iomux = FUNC_NO_IOMUX;
+    send_ctx.total_size = TOTAL_SIZE;
+
+    tapi_rand_gen_set(&send_ctx.size, MIN_SEND_SIZE, MAX_SEND_SIZE, FALSE);
+
+    send_ctx.gen_func = RPC_PATTERN_GEN_LCG;
+    recv_ctx.gen_func = RPC_PATTERN_GEN_LCG;
+    pat_arg = &send_ctx.gen_arg;
+    pat_arg->offset = 0;
+    pat_arg->coef1 = rand_range(0, RAND_MAX);
+    pat_arg->coef2 = rand_range(1, RAND_MAX);
+    pat_arg->coef3 = rand_range(0, RAND_MAX);
+    memcpy(&recv_ctx.gen_arg, pat_arg, sizeof(*pat_arg));
+
+    rpcs_receiver->op = RCF_RPC_CALL;
+    rpc_pattern_receiver(rpcs_receiver, s_receiver, &recv_ctx);
+
+    RPC_AWAIT_ERROR(rpcs_sender);
+    rc = rpc_pattern_sender(rpcs_sender, s_sender, &send_ctx);
+    if (rc < 0)
+    {
+        ERROR_VERDICT("rpc_pattern_sender() failed on %s with error "
+                      RPC_ERROR_FMT, rpcs_sender->ta,
+                      RPC_ERROR_ARGS(rpcs_sender));
+        rpc_pattern_receiver(rpcs_receiver, s_receiver, &recv_ctx);
+        TEST_STOP;
+    }
+
+    RPC_AWAIT_ERROR(rpcs_receiver);
+    rc = rpc_pattern_receiver(rpcs_receiver, s_receiver, &recv_ctx);
+    if (rc < 0)
+    {
+        TEST_VERDICT("rpc_pattern_receiver() failed on %s with error "
+                     RPC_ERROR_FMT, rpcs_receiver->ta,
+                     RPC_ERROR_ARGS(rpcs_receiver));
+    }
+
+    if (send_ctx.sent != recv_ctx.received)
+    {
+        TEST_VERDICT("Number of bytes received does not match "
+                     "number of bytes sent");
+    }
+
+    return send_ctx.sent;
+}
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct if_nameindex *tst_if = NULL;
+
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+
+    int iut_s = -1;
+    int tst_s = -1;
+    int mss;
+
+    net_drv_gso_limits orig_limits;
+    te_bool limits_changed = FALSE;
+    unsigned int gso_max_size;
+    unsigned int gro_max_size;
+    int family;
+    te_errno rc;
+
+    csap_handle_t csap_iut = CSAP_INVALID_HANDLE;
+    csap_handle_t csap_tst = CSAP_INVALID_HANDLE;
+    pkts_info iut_stats;
+    pkts_info tst_stats;
+    uint64_t sent;
+    te_bool test_failed = FALSE;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_IF(tst_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+
+    family = iut_addr->sa_family;
+
+    TEST_STEP("Get GSO and GRO maximum sizes of IUT interface. Skip the "
+              "test if they are not reported (kernel does not support "
+              "BIG TCP for the address family) or if driver does not "
+              "allow TSO packets larger than 64KB.");
+    rc = net_drv_get_gso_limits(iut_rpcs, iut_if->if_name, family,
+                                &orig_limits);
+    if (rc != 0)
+        TEST_SKIP("BIG TCP is not supported by kernel");
+
+    RING("Original limits: tso_max_size %u, gso_max_size %u, "
+         "gro_max_size %u", orig_limits.tso_max_size,
+         orig_limits.gso_max_size, orig_limits.gro_max_size);
+
+    if (orig_limits.tso_max_size <= NET_DRV_GSO_LEGACY_SIZE)
+        TEST_SKIP("Driver does not support TSO packets larger than 64KB");
+
+    TEST_STEP("Try to enable Tx checksum offload and enable TSO and GRO "
+              "on IUT.");
+    net_drv_try_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                               net_drv_perf_tx_csum_feature(
+                                    iut_rpcs->ta, iut_if->if_name,
+                                    family), 1);
+    net_drv_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                           net_drv_perf_tso_feature(family), 1);
+    net_drv_set_if_feature(iut_rpcs->ta, iut_if->if_name, "rx-gro", 1);
+
+    TEST_STEP("Make sure LRO and GRO are turned off on Tester, so that "
+              "CSAP captures IUT packets there exactly as they were sent, "
+              "and try to enable TSO on Tester so that it sends data "
+              "as fast as possible.");
+    net_drv_set_if_feature(tst_rpcs->ta, tst_if->if_name, "rx-gro", 0);
+    net_drv_set_if_feature(tst_rpcs->ta, tst_if->if_name, "rx-gro-hw", 0);
+    net_drv_set_if_feature(tst_rpcs->ta, tst_if->if_name, "rx-lro", 0);
+    net_drv_try_set_if_feature(tst_rpcs->ta, tst_if->if_name,
+                               "tx-checksum-ip-generic", 1);
+    net_drv_try_set_if_feature(tst_rpcs->ta, tst_if->if_name,
+                               net_drv_perf_tso_feature(family), 1);
+
+    TEST_STEP("Try to disable adaptive Rx interrupt coalescing and set "
+              "@b rx_coalesce_usecs to a big value on IUT so that GRO "
+              "gets enough packets at once.");
+    /* This may be not possible for all drivers, errors are ignored */
+    tapi_cfg_if_coalesce_set(iut_rpcs->ta, iut_if->if_name,
+                             "use_adaptive_rx_coalesce", 0);
+    tapi_cfg_if_coalesce_set(iut_rpcs->ta, iut_if->if_name,
+                             "rx_coalesce_usecs", RX_COALESCE_USECS);
+
+    TEST_STEP("Raise GSO and GRO maximum sizes on IUT above 64KB "
+              "(GSO maximum size is limited by what driver supports).");
+    gso_max_size = MIN(orig_limits.tso_max_size, NET_DRV_BIG_TCP_SIZE);
+    gro_max_size = NET_DRV_BIG_TCP_SIZE;
+    rc = net_drv_set_gso_limits(iut_rpcs, iut_if->if_name, family,
+                                gso_max_size, gro_max_size);
+    if (rc != 0)
+        TEST_VERDICT("Failed to enable BIG TCP on IUT");
+    limits_changed = TRUE;
+
+    CFG_WAIT_CHANGES;
+
+    TEST_STEP("Establish connection between a pair of TCP sockets "
+              "on IUT and Tester.");
+    GEN_CONNECTION(iut_rpcs, tst_rpcs, RPC_SOCK_STREAM, RPC_PROTO_DEF,
+                   iut_addr, tst_addr, &iut_s, &tst_s);
+    rpc_getsockopt(tst_rpcs, tst_s, RPC_TCP_MAXSEG, &mss);
+
+    TEST_STEP("Create a CSAP on IUT to capture outgoing packets and "
+              "a CSAP on Tester to capture incoming packets.");
+    csap_iut = start_csap(iut_rpcs, iut_if->if_name, TAD_ETH_RECV_OUT,
+                          iut_addr, tst_addr);
+    csap_tst = start_csap(tst_rpcs, tst_if->if_name, TAD_ETH_RECV_DEF,
+                          iut_addr, tst_addr);
+
+    TEST_STEP("Send a lot of data from IUT to Tester, checking that it "
+              "is received correctly.");
+    sent = transfer_data(iut_rpcs, iut_s, tst_rpcs, tst_s);
+
+    TEST_STEP("Check packets captured on IUT: packets larger than 64KB "
+              "but not larger than GSO maximum size should be passed "
+              "to NIC.");
+    get_captured_pkts(iut_rpcs->ta, csap_iut, mss, TRUE, "IUT",
+                      &iut_stats);
+    if (iut_stats.huge_pkts_num == 0)
+    {
+        ERROR_VERDICT("No packets larger than 64KB were sent from IUT");
+        test_failed = TRUE;
+    }
+    if (iut_stats.max_size > gso_max_size)
+    {
+        ERROR_VERDICT("Packets larger than GSO maximum size were sent "
+                      "from IUT");
+        test_failed = TRUE;
+    }
+
+    TEST_STEP("Check packets captured on Tester: all of them should be "
+              "not larger than MSS and carry all the data sent.");
+    get_captured_pkts(tst_rpcs->ta, csap_tst, mss, FALSE, "Tester",
+                      &tst_stats);
+    if (tst_stats.big_pkts_num > 0)
+    {
+        ERROR_VERDICT("Larger than MSS packets were captured on Tester");
+        test_failed = TRUE;
+    }
+    if (tst_stats.seqn_span != sent)
+    {
+        ERROR("%" TE_PRINTF_64 "u bytes were sent, %" TE_PRINTF_64 "u "
+              "bytes were captured on Tester", sent, tst_stats.seqn_span);
+        ERROR_VERDICT("Number of bytes in packets captured on Tester "
+                      "does not match number of bytes sent");
+        test_failed = TRUE;
+    }
+
+    CHECK_RC(tapi_tad_csap_destroy(iut_rpcs->ta, 0, csap_iut));
+    csap_iut = CSAP_INVALID_HANDLE;
+
+    TEST_STEP("Create a CSAP on IUT to capture incoming packets.");
+    csap_iut = start_csap(iut_rpcs, iut_if->if_name, TAD_ETH_RECV_DEF,
+                          tst_addr, iut_addr);
+
+    TEST_STEP("Send a lot of data from Tester to IUT, checking that it "
+              "is received correctly.");
+    transfer_data(tst_rpcs, tst_s, iut_rpcs, iut_s);
+
+    TEST_STEP("Check packets captured on IUT: GRO should build packets "
+              "larger than 64KB but not larger than GRO maximum size.");
+    get_captured_pkts(iut_rpcs->ta, csap_iut, mss, TRUE, "IUT",
+                      &iut_stats);
+    if (iut_stats.huge_pkts_num == 0)
+        TEST_VERDICT("GRO did not build packets larger than 64KB on IUT");
+    if (iut_stats.max_size > gro_max_size)
+        TEST_VERDICT("GRO built packets larger than GRO maximum size");
+
+    if (test_failed)
+        TEST_STOP;
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    CLEANUP_CHECK_RC(tapi_tad_csap_destroy(iut_rpcs->ta, 0, csap_iut));
+    CLEANUP_CHECK_RC(tapi_tad_csap_destroy(tst_rpcs->ta, 0, csap_tst));
+
+    CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
+    CLEANUP_RPC_CLOSE(tst_rpcs, tst_s);
+
+    if (limits_changed)
+    {
+        CLEANUP_CHECK_RC(net_drv_set_gso_limits(iut_rpcs, iut_if->if_name,
+                                                family,
+                                                orig_limits.gso_max_size,
+                                                orig_limits.gro_max_size));
+    }
+
+    TEST_END;
+}
+
+/** @} */
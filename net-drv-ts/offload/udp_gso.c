@@ -0,0 +1,293 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Offloads tests
+ */
+
+/**
+ * @defgroup offload-udp_gso UDP segmentation and UDP GRO
+ * @ingroup offload
+ * @{
+ *
+ * @objective Check that UDP super-buffers sent with @c UDP_SEGMENT are
+ *            split into datagrams of requested size, and that UDP
+ *            datagrams are coalesced by GRO on receive if socket has
+ *            @c UDP_GRO enabled.
+ *
+ * @param env           Testing environment:
+ *                      - @ref env-peer2peer
+ *                      - @ref env-peer2peer_ipv6
+ * @param udp_seg_on    Should UDP segmentation offload
+ *                      (@b tx-udp-segmentation) be enabled on IUT?
+ * @param gro_on        Should GRO be enabled on IUT?
+ * @param gso_size      Size of UDP payload of a segment:
+ *                      - @c 1000
+ * @param segs          Number of segments in a super-buffer:
+ *                      - @c 8
+ *                      - @c 32
+ * @param send_calls    Number of super-buffers to send:
+ *                      - @c 10
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME "offload/udp_gso"
+
+#include <stddef.h>
+#include <linux/if_ether.h>
+#include <netinet/ip.h>
+#include <netinet/ip6.h>
+#include <netinet/udp.h>
+
+#include "net_drv_test.h"
+
+/** How long to capture packets on Tester, in milliseconds */
+#define CAPTURE_TIME 3000
+
+/** Maximum time to send super-buffers, in milliseconds */
+#define SEND_TIME 2000
+
+/**
+ * How long to wait for new data when receiving, in milliseconds
+ * (receiving stops if nothing is received during this time).
+ */
+#define RECV_TIME2WAIT 1000
+
+/** Length of IP header without options for a given address family */
+#define IP_HDR_LEN(_family) \
+    ((_family) == AF_INET ? sizeof(struct iphdr) : sizeof(struct ip6_hdr))
+
+/** How many bytes of a packet to capture */
+#define CAPTURE_SNAPLEN 128
+
+/**
+ * Build classic BPF filter accepting only UDP packets sent to
+ * a given port (IP options and IPv6 extension headers are not
+ * expected).
+ *
+ * @param family      Address family.
+ * @param port        Destination port (in host byte order).
+ * @param filter      Where to save the filter (should have space
+ *                    for 8 instructions).
+ *
+ * @return Number of instructions in the filter.
+ */
+static unsigned int
+build_udp_filter(int family, uint16_t port, struct sock_filter *filter)
+{
+    unsigned int eth_type = (family == AF_INET) ? ETH_P_IP : ETH_P_IPV6;
+    unsigned int ip_hlen = IP_HDR_LEN(family);
+    unsigned int proto_off = ETH_HLEN +
+                             (family == AF_INET ?
+                                offsetof(struct iphdr, protocol) :
+                                offsetof(struct ip6_hdr, ip6_nxt));
+    unsigned int dport_off = ETH_HLEN + ip_hlen + 2;
+    struct sock_filter insns[] = {
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, 12),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, eth_type, 0, 5),
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, proto_off),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, 0, 3),
+        BPF_STMT(BPF_LD | BPF_H | BPF_ABS, dport_off),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, port, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, CAPTURE_SNAPLEN),
+        BPF_STMT(BPF_RET | BPF_K, 0),
+    };
+
+    memcpy(filter, insns, sizeof(insns));
+    return TE_ARRAY_LEN(insns);
+}
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    rcf_rpc_server *capt_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct if_nameindex *tst_if = NULL;
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+    te_bool udp_seg_on;
+    te_bool gro_on;
+    unsigned int gso_size;
+    unsigned int segs;
+    unsigned int send_calls;
+
+    struct sock_filter filter[8];
+    unsigned int filter_len;
+    net_drv_capt_rec *recs = NULL;
+    unsigned int recs_num = 0;
+    uint64_t drops = 0;
+    unsigned int exp_len;
+    unsigned int bad_len = 0;
+    unsigned int i;
+
+    net_drv_udp_gso_stats gso_stats;
+    net_drv_udp_gro_stats gro_stats;
+    int64_t sent;
+    int iut_s = -1;
+    int tst_s = -1;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_IF(tst_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+    TEST_GET_BOOL_PARAM(udp_seg_on);
+    TEST_GET_BOOL_PARAM(gro_on);
+    TEST_GET_UINT_PARAM(gso_size);
+    TEST_GET_UINT_PARAM(segs);
+    TEST_GET_UINT_PARAM(send_calls);
+
+    TEST_STEP("Turn UDP segmentation offload on or off on IUT according "
+              "to @p udp_seg_on.");
+    net_drv_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                           "tx-udp-segmentation", udp_seg_on ? 1 : 0);
+
+    TEST_STEP("Turn GRO on or off on IUT according to @p gro_on.");
+    net_drv_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                           "rx-gro", gro_on ? 1 : 0);
+
+    TEST_STEP("Make sure LRO and GRO are turned off on Tester, so that "
+              "packets sent from IUT are captured there exactly as they "
+              "were received.");
+    net_drv_set_if_feature(tst_rpcs->ta, tst_if->if_name,
+                           "rx-gro", 0);
+    net_drv_set_if_feature(tst_rpcs->ta, tst_if->if_name,
+                           "rx-gro-hw", 0);
+    net_drv_set_if_feature(tst_rpcs->ta, tst_if->if_name,
+                           "rx-lro", 0);
+
+    CFG_WAIT_CHANGES;
+
+    TEST_STEP("Create a pair of connected UDP sockets on IUT and Tester.");
+    GEN_CONNECTION(iut_rpcs, tst_rpcs, RPC_SOCK_DGRAM, RPC_PROTO_DEF,
+                   iut_addr, tst_addr, &iut_s, &tst_s);
+
+    CHECK_RC(rcf_rpc_server_fork(tst_rpcs, "tst_capture", &capt_rpcs));
+
+    TEST_STEP("Start capturing UDP packets sent to the Tester socket "
+              "on Tester interface with @c TPACKET_V3 ring.");
+    filter_len = build_udp_filter(tst_addr->sa_family,
+                                  ntohs(te_sockaddr_get_port(tst_addr)),
+                                  filter);
+    capt_rpcs->op = RCF_RPC_CALL;
+    rpc_net_drv_capture_pkts(capt_rpcs, tst_if->if_name, filter,
+                             filter_len, NET_DRV_CAPT_LEN, CAPTURE_TIME,
+                             0, NULL, NULL, NULL);
+    TAPI_WAIT_NETWORK;
+
+    TEST_STEP("Start receiving data on the Tester socket.");
+    tst_rpcs->op = RCF_RPC_CALL;
+    rpc_net_drv_recv_udp_gro(tst_rpcs, tst_s, FALSE, RECV_TIME2WAIT, NULL);
+
+    TEST_STEP("Send @p send_calls super-buffers of @p segs * @p gso_size "
+              "bytes with @c UDP_SEGMENT control message from the IUT "
+              "socket.");
+    sent = rpc_net_drv_send_udp_gso(iut_rpcs, iut_s, gso_size * segs,
+                                    gso_size, SEND_TIME, send_calls,
+                                    &gso_stats);
+
+    TEST_STEP("Check that all the data was received on Tester in "
+              "expected number of datagrams.");
+    memset(&gro_stats, 0, sizeof(gro_stats));
+    rpc_net_drv_recv_udp_gro(tst_rpcs, tst_s, FALSE, RECV_TIME2WAIT,
+                             &gro_stats);
+    if (gro_stats.bytes != (uint64_t)sent)
+    {
+        ERROR("%" TE_PRINTF_64 "u bytes received instead of %jd",
+              gro_stats.bytes, (intmax_t)sent);
+        TEST_VERDICT("Tester received unexpected number of bytes");
+    }
+    if (gro_stats.segs != gso_stats.segs)
+        TEST_VERDICT("Tester received unexpected number of datagrams");
+
+    TEST_STEP("Check that every UDP packet captured on Tester carries "
+              "exactly @p gso_size bytes of payload and that their "
+              "number matches the number of segments.");
+    capt_rpcs->timeout = CAPTURE_TIME + TE_SEC2MS(10);
+    rpc_net_drv_capture_pkts(capt_rpcs, tst_if->if_name, filter,
+                             filter_len, NET_DRV_CAPT_LEN, CAPTURE_TIME,
+                             0, &recs, &recs_num, &drops);
+    if (drops > 0)
+        WARN("%" TE_PRINTF_64 "u packets were dropped by capture", drops);
+
+    exp_len = ETH_HLEN + IP_HDR_LEN(tst_addr->sa_family) +
+              sizeof(struct udphdr) + gso_size;
+    for (i = 0; i < recs_num; i++)
+    {
+        if (recs[i].len != exp_len)
+        {
+            if (bad_len == 0)
+            {
+                ERROR("Packet %u has length %u instead of %u",
+                      i, recs[i].len, exp_len);
+            }
+            bad_len++;
+        }
+    }
+
+    RING("%u packets were captured on Tester, %u of them have "
+         "unexpected length", recs_num, bad_len);
+
+    if (bad_len > 0)
+        TEST_VERDICT("Size of packets on the wire does not match gso_size");
+    if (recs_num != gso_stats.segs)
+        TEST_VERDICT("Unexpected number of packets captured on Tester");
+
+    TEST_STEP("Start receiving data with @c UDP_GRO enabled on the IUT "
+              "socket.");
+    iut_rpcs->op = RCF_RPC_CALL;
+    rpc_net_drv_recv_udp_gro(iut_rpcs, iut_s, TRUE, RECV_TIME2WAIT, NULL);
+
+    TEST_STEP("Send @p send_calls super-buffers of @p segs * @p gso_size "
+              "bytes with @c UDP_SEGMENT control message from the Tester "
+              "socket.");
+    sent = rpc_net_drv_send_udp_gso(tst_rpcs, tst_s, gso_size * segs,
+                                    gso_size, SEND_TIME, send_calls,
+                                    &gso_stats);
+
+    TEST_STEP("Check that all the data was received on IUT. If @p gro_on "
+              "is @c TRUE, check that some datagrams were coalesced and "
+              "that reported GSO size is @p gso_size. Otherwise check that "
+              "nothing was coalesced.");
+    memset(&gro_stats, 0, sizeof(gro_stats));
+    rpc_net_drv_recv_udp_gro(iut_rpcs, iut_s, TRUE, RECV_TIME2WAIT,
+                             &gro_stats);
+    if (gro_stats.bytes != (uint64_t)sent)
+        TEST_VERDICT("IUT received unexpected number of bytes");
+    if (gro_stats.segs != gso_stats.segs)
+        TEST_VERDICT("IUT received unexpected number of segments");
+
+    RING("%" TE_PRINTF_64 "u datagrams were coalesced on IUT, up to %u "
+         "segments in a datagram", gro_stats.coalesced, gro_stats.max_segs);
+
+    if (gro_on)
+    {
+        if (gro_stats.coalesced == 0)
+            TEST_VERDICT("No UDP datagrams were coalesced by GRO on IUT");
+        if (gro_stats.gso_size != gso_size ||
+            gro_stats.gso_size_mismatch > 0)
+            TEST_VERDICT("UDP_GRO reported unexpected GSO size");
+    }
+    else if (gro_stats.coalesced > 0)
+    {
+        TEST_VERDICT("UDP datagrams were coalesced on IUT while GRO is "
+                     "disabled");
+    }
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    free(recs);
+    CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
+    CLEANUP_RPC_CLOSE(tst_rpcs, tst_s);
+    if (capt_rpcs != NULL)
+        CLEANUP_CHECK_RC(rcf_rpc_server_destroy(capt_rpcs));
+
+    TEST_END;
+}
@@ -0,0 +1,322 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-af_xdp_perf AF_XDP packet rate in copy and zero-copy modes
+ * @ingroup perf
+ * @{
+ *
+ * @objective Measure rate of packets received (and sent back) over
+ *            AF_XDP sockets on every Rx queue of IUT interface when
+ *            packets are processed in batches.
+ *
+ * @param env               Testing environment:
+ *                          - @ref env-peer2peer
+ *                          - @ref env-peer2peer_ipv6
+ * @param copy_mode         XDP copy mode:
+ *                          - @c none (kernel tries zero-copy, falls back
+ *                            to copy mode if it fails)
+ *                          - @c copy
+ *                          - @c zerocopy
+ * @param need_wakeup       If @c TRUE, bind AF_XDP sockets with
+ *                          @c XDP_USE_NEED_WAKEUP flag so that system
+ *                          calls are made only when the driver asks
+ *                          for it.
+ * @param xsk_mode          What to do with received packets:
+ *                          - @c rx_drop (return frames to FILL ring)
+ *                          - @c fwd (send packets back to Tester with
+ *                            MAC addresses swapped)
+ * @param frame_size        Size of Ethernet frame including FCS:
+ *                          - @c 64
+ *                          - @c 1518
+ * @param ring_size         Size of Rx and Tx rings of AF_XDP sockets
+ *                          (UMEM of every socket has four times more
+ *                          frames)
+ * @param batch             Maximum number of packets processed at once
+ * @param n_threads         Number of sender threads on Tester (every
+ *                          thread sends its own flow)
+ * @param burst             Number of packets passed to a single
+ *                          @b sendmmsg() call on Tester
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/af_xdp_perf"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "te_units.h"
+#include "tapi_cfg_if_rss.h"
+#include "tapi_bpf_rxq_stats.h"
+#include "tapi_rpc_bpf.h"
+
+/** How long to send packets, in seconds */
+#define TEST_SEND_DURATION_SEC 6
+
+/**
+ * How long AF_XDP sockets on IUT process packets after Tester stops
+ * sending, in seconds.
+ */
+#define TEST_XSK_MARGIN_SEC 2
+
+/** Size of UMEM frame */
+#define TEST_UMEM_FRAME_SIZE 4096
+
+/** Ratio of number of UMEM frames to size of Rx ring */
+#define TEST_UMEM_FRAMES_RATIO 4
+
+/** The list of values allowed for parameter of type 'copy_mode' */
+#define TEST_COPY_MODE_MAPPING_LIST             \
+    { "none", 0 },                              \
+    { "copy", NET_DRV_XSK_COPY },               \
+    { "zerocopy", NET_DRV_XSK_ZEROCOPY }
+
+/** The list of values allowed for parameter of type 'xsk_mode' */
+#define TEST_XSK_MODE_MAPPING_LIST              \
+    { "rx_drop", NET_DRV_XSK_RX_DROP },         \
+    { "fwd", NET_DRV_XSK_FWD }
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct if_nameindex *tst_if = NULL;
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+    unsigned int copy_mode;
+    te_bool need_wakeup;
+    net_drv_xsk_mode xsk_mode;
+    unsigned int frame_size;
+    unsigned int ring_size;
+    unsigned int batch;
+    unsigned int n_threads;
+    unsigned int burst;
+
+    te_mi_logger *logger = NULL;
+    net_drv_xsk_queue_stats *stats = NULL;
+    te_string name = TE_STRING_INIT;
+    struct sockaddr_storage dst_addr;
+    unsigned int bpf_id = 0;
+    te_bool bpf_loaded = FALSE;
+    unsigned int *queues = NULL;
+    int *cpus = NULL;
+    int rx_queues;
+    unsigned int flags;
+    unsigned int pkt_size;
+    int64_t received;
+    uint64_t sent_back = 0;
+    uint64_t wakeups = 0;
+    double rx_pps;
+    double tx_pps;
+    double queue_pps;
+    unsigned int i;
+    int map_fd = -1;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_IF(tst_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+    TEST_GET_ENUM_PARAM(copy_mode, TEST_COPY_MODE_MAPPING_LIST);
+    TEST_GET_BOOL_PARAM(need_wakeup);
+    TEST_GET_ENUM_PARAM(xsk_mode, TEST_XSK_MODE_MAPPING_LIST);
+    TEST_GET_UINT_PARAM(frame_size);
+    TEST_GET_UINT_PARAM(ring_size);
+    TEST_GET_UINT_PARAM(batch);
+    TEST_GET_UINT_PARAM(n_threads);
+    TEST_GET_UINT_PARAM(burst);
+
+    pkt_size = net_drv_perf_udp_payload_len(frame_size,
+                                            iut_addr->sa_family);
+    flags = copy_mode;
+    if (need_wakeup)
+        flags |= NET_DRV_XSK_NEED_WAKEUP;
+
+    TEST_STEP("If frames of @p frame_size bytes do not fit current MTU, "
+              "increase it on IUT and Tester.");
+    net_drv_perf_ensure_mtu(iut_rpcs->ta, iut_if->if_name, frame_size);
+    net_drv_perf_ensure_mtu(tst_rpcs->ta, tst_if->if_name, frame_size);
+
+    CFG_WAIT_CHANGES;
+
+    CHECK_RC(tapi_cfg_if_rss_rx_queues_get(iut_rpcs->ta, iut_if->if_name,
+                                           &rx_queues));
+    if (rx_queues <= 0)
+        TEST_FAIL("Failed to get number of Rx queues of IUT interface");
+
+    TEST_STEP("Link @b rxq_stats XDP program to IUT interface and "
+              "configure it to redirect UDP packets going from "
+              "@p tst_addr to @p iut_addr (accepting any destination "
+              "port) to its XSK map. Obtain file descriptor of the map "
+              "on IUT RPC server.");
+    CHECK_RC(tapi_bpf_rxq_stats_init(iut_rpcs->ta, iut_if->if_name,
+                                     "rss_bpf", &bpf_id));
+    bpf_loaded = TRUE;
+
+    tapi_sockaddr_clone_exact(iut_addr, &dst_addr);
+    te_sockaddr_set_port(SA(&dst_addr), 0);
+    CHECK_RC(tapi_bpf_rxq_stats_reset(iut_rpcs->ta, bpf_id));
+    CHECK_RC(tapi_bpf_rxq_stats_set_params(
+                  iut_rpcs->ta, bpf_id, iut_addr->sa_family,
+                  tst_addr, SA(&dst_addr), IPPROTO_UDP, TRUE));
+
+    CHECK_RC(tapi_bpf_map_pin_get_fd(iut_rpcs, bpf_id,
+                                     TAPI_BPF_RXQ_STATS_XSK_MAP,
+                                     &map_fd));
+
+    TEST_STEP("On IUT start processing packets in batches of @p batch "
+              "packets over AF_XDP sockets bound to every Rx queue "
+              "according to @p copy_mode, @p need_wakeup and "
+              "@p xsk_mode, with a thread per queue and Rx and Tx rings "
+              "of @p ring_size entries.");
+    queues = tapi_calloc(rx_queues, sizeof(*queues));
+    for (i = 0; i < (unsigned int)rx_queues; i++)
+        queues[i] = i;
+
+    iut_rpcs->op = RCF_RPC_CALL;
+    rpc_net_drv_xsk_batch(iut_rpcs, iut_if->if_name, map_fd, queues, NULL,
+                          rx_queues, TEST_UMEM_FRAME_SIZE,
+                          ring_size * TEST_UMEM_FRAMES_RATIO, ring_size,
+                          flags, xsk_mode, batch,
+                          TE_SEC2MS(TEST_SEND_DURATION_SEC +
+                                    TEST_XSK_MARGIN_SEC), NULL);
+
+    te_motivated_msleep(500, "make sure that AF_XDP sockets are bound "
+                        "and added to XSK map");
+
+    TEST_STEP("Send UDP packets fitting in @p frame_size bytes frames "
+              "from Tester to IUT at the maximum rate for a few seconds "
+              "from @p n_threads threads, so that RSS spreads flows "
+              "across Rx queues.");
+    cpus = tapi_calloc(n_threads, sizeof(*cpus));
+    for (i = 0; i < n_threads; i++)
+        cpus[i] = -1;
+
+    tst_rpcs->timeout = TE_SEC2MS(TEST_SEND_DURATION_SEC + 5);
+    rpc_net_drv_send_pkts_mt(tst_rpcs, tst_addr, iut_addr, cpus, n_threads,
+                             pkt_size, burst, 0,
+                             TE_SEC2MS(TEST_SEND_DURATION_SEC), NULL);
+
+    TEST_STEP("Wait until processing on IUT finishes and get numbers of "
+              "packets received and sent back on every queue. Skip the "
+              "test if requested copy mode is not supported.");
+    iut_rpcs->timeout = TE_SEC2MS(TEST_SEND_DURATION_SEC +
+                                  TEST_XSK_MARGIN_SEC + 5);
+    RPC_AWAIT_ERROR(iut_rpcs);
+    received = rpc_net_drv_xsk_batch(iut_rpcs, iut_if->if_name, map_fd,
+                                     queues, NULL, rx_queues,
+                                     TEST_UMEM_FRAME_SIZE,
+                                     ring_size * TEST_UMEM_FRAMES_RATIO,
+                                     ring_size, flags, xsk_mode, batch,
+                                     TE_SEC2MS(TEST_SEND_DURATION_SEC +
+                                               TEST_XSK_MARGIN_SEC),
+                                     &stats);
+    if (received < 0)
+    {
+        if (RPC_ERRNO(iut_rpcs) == RPC_ENOSYS)
+            TEST_SKIP("AF_XDP is not supported by Test Agent");
+
+        if (RPC_ERRNO(iut_rpcs) == RPC_EOPNOTSUPP)
+        {
+            TEST_SKIP("AF_XDP sockets cannot be bound in %s mode",
+                      TEST_STRING_PARAM(copy_mode));
+        }
+
+        TEST_VERDICT("Processing packets over AF_XDP sockets failed "
+                     "with error " RPC_ERROR_FMT, RPC_ERROR_ARGS(iut_rpcs));
+    }
+
+    if (received == 0)
+        TEST_VERDICT("No packets were received over AF_XDP sockets");
+
+    for (i = 0; i < (unsigned int)rx_queues; i++)
+    {
+        sent_back += stats[i].tx_pkts;
+        wakeups += stats[i].wakeups;
+    }
+
+    if (xsk_mode == NET_DRV_XSK_FWD && sent_back == 0)
+        TEST_VERDICT("No packets were sent back over AF_XDP sockets");
+
+    TEST_STEP("Report rates of packets received and sent back over "
+              "AF_XDP sockets per queue and in aggregate.");
+    rx_pps = (double)received / TEST_SEND_DURATION_SEC;
+    tx_pps = (double)sent_back / TEST_SEND_DURATION_SEC;
+
+    TEST_ARTIFACT("AF_XDP %s mode%s, frame size %u: received %.3f Mpps, "
+                  "sent back %.3f Mpps, %.0f wakeups/s",
+                  TEST_STRING_PARAM(copy_mode),
+                  need_wakeup ? " with need_wakeup" : "", frame_size,
+                  TE_UNITS_DEC_U2M(rx_pps), TE_UNITS_DEC_U2M(tx_pps),
+                  (double)wakeups / TEST_SEND_DURATION_SEC);
+
+    CHECK_RC(te_mi_logger_meas_create("af_xdp_perf", &logger));
+    te_mi_logger_add_meas_key(logger, NULL, "Copy mode", "%s",
+                              TEST_STRING_PARAM(copy_mode));
+    te_mi_logger_add_meas_key(logger, NULL, "Need wakeup", "%s",
+                              need_wakeup ? "yes" : "no");
+    te_mi_logger_add_meas_key(logger, NULL, "Mode", "%s",
+                              TEST_STRING_PARAM(xsk_mode));
+    te_mi_logger_add_meas_key(logger, NULL, "Frame size", "%u",
+                              frame_size);
+
+    te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_PPS, "Received",
+                          TE_MI_MEAS_AGGR_SINGLE, rx_pps,
+                          TE_MI_MEAS_MULTIPLIER_PLAIN);
+    if (xsk_mode == NET_DRV_XSK_FWD)
+    {
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_PPS, "Sent back",
+                              TE_MI_MEAS_AGGR_SINGLE, tx_pps,
+                              TE_MI_MEAS_MULTIPLIER_PLAIN);
+    }
+
+    for (i = 0; i < (unsigned int)rx_queues; i++)
+    {
+        queue_pps = (double)stats[i].rx_pkts / TEST_SEND_DURATION_SEC;
+        RING("Queue %u: received %.3f Mpps, sent back %.3f Mpps, "
+             "%" TE_PRINTF_64 "u wakeups", i, TE_UNITS_DEC_U2M(queue_pps),
+             TE_UNITS_DEC_U2M((double)stats[i].tx_pkts /
+                              TEST_SEND_DURATION_SEC),
+             stats[i].wakeups);
+
+        te_string_reset(&name);
+        te_string_append(&name, "Queue %u received", i);
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_PPS,
+                              te_string_value(&name),
+                              TE_MI_MEAS_AGGR_SINGLE, queue_pps,
+                              TE_MI_MEAS_MULTIPLIER_PLAIN);
+    }
+
+    te_mi_logger_add_comment(logger, NULL, "Wakeups/s", "%.0f",
+                             (double)wakeups / TEST_SEND_DURATION_SEC);
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    CLEANUP_RPC_CLOSE(iut_rpcs, map_fd);
+
+    if (bpf_loaded)
+    {
+        CLEANUP_CHECK_RC(tapi_bpf_rxq_stats_fini(iut_rpcs->ta,
+                                                 iut_if->if_name, bpf_id));
+    }
+
+    te_mi_logger_destroy(logger);
+    te_string_free(&name);
+    free(stats);
+    free(queues);
+    free(cpus);
+
+    TEST_END;
+}
@@ -0,0 +1,300 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-fwd_rfc2544 RFC 2544 forwarding throughput
+ * @ingroup perf
+ * @{
+ *
+ * @objective Find the highest rate at which IUT forwards UDP packets
+ *            of a given frame size without loss (or with loss below
+ *            a threshold) as described in RFC 2544.
+ *
+ * @param env               Testing environment with client and server
+ *                          on Tester connected to different IUT
+ *                          interfaces, IUT forwarding traffic between
+ *                          them (IPv4 or IPv6)
+ * @param frame_size        Size of Ethernet frame including FCS
+ * @param loss_threshold    Acceptable loss, in percent (@c 0 - no loss
+ *                          is allowed)
+ * @param n_threads         Number of sender threads on client (every
+ *                          thread sends its own flow)
+ * @param burst             Number of packets passed to a single
+ *                          @b sendmmsg() call
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/fwd_rfc2544"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "te_units.h"
+#include "tapi_cfg_stats.h"
+
+/** Duration of a single trial, in seconds */
+#define TEST_TRIAL_DURATION_SEC 3
+
+/** Maximum number of trials */
+#define TEST_MAX_TRIALS 14
+
+/**
+ * Search stops when the interval containing throughput becomes less
+ * than this fraction of its upper bound.
+ */
+#define TEST_SEARCH_RESOLUTION 0.01
+
+/** Traffic generation settings */
+typedef struct test_gen {
+    rcf_rpc_server *client_rpcs;            /**< Sender RPC server */
+    rcf_rpc_server *server_rpcs;            /**< Receiver RPC server */
+    const struct if_nameindex *client_if;   /**< Sender interface */
+    const struct if_nameindex *server_if;   /**< Receiver interface */
+    const struct sockaddr *client_addr;     /**< Source address */
+    const struct sockaddr *server_addr;     /**< Destination address */
+    int *cpus;                              /**< CPUs of sender
+                                                 threads */
+    unsigned int n_threads;                 /**< Number of sender
+                                                 threads */
+    unsigned int pkt_size;                  /**< UDP payload size */
+    unsigned int burst;                     /**< Packets per
+                                                 sendmmsg() call */
+} test_gen;
+
+/** Results of a trial */
+typedef struct test_trial {
+    uint64_t rate;      /**< Requested rate, in pps (@c 0 - maximum) */
+    double tx_pps;      /**< Rate of packets sent by client interface */
+    double rx_pps;      /**< Rate of packets received by server
+                             interface */
+    double loss;        /**< Loss, in percent */
+} test_trial;
+
+/**
+ * Send packets from client to server via IUT at a given rate and
+ * compute loss.
+ *
+ * @param gen       Traffic generation settings.
+ * @param rate      Rate, in packets per second (@c 0 - maximum).
+ * @param trial     Where to save results.
+ */
+static void
+run_trial(const test_gen *gen, uint64_t rate, test_trial *trial)
+{
+    tapi_cfg_if_stats client_before;
+    tapi_cfg_if_stats client_after;
+    tapi_cfg_if_stats server_before;
+    tapi_cfg_if_stats server_after;
+    uint64_t sent;
+    uint64_t received;
+
+    CHECK_RC(tapi_cfg_stats_if_stats_get(gen->client_rpcs->ta,
+                                         gen->client_if->if_name,
+                                         &client_before));
+    CHECK_RC(tapi_cfg_stats_if_stats_get(gen->server_rpcs->ta,
+                                         gen->server_if->if_name,
+                                         &server_before));
+
+    gen->client_rpcs->timeout = TE_SEC2MS(TEST_TRIAL_DURATION_SEC + 5);
+    rpc_net_drv_send_pkts_mt(gen->client_rpcs, gen->client_addr,
+                             gen->server_addr, gen->cpus, gen->n_threads,
+                             gen->pkt_size, gen->burst, rate,
+                             TE_SEC2MS(TEST_TRIAL_DURATION_SEC), NULL);
+
+    NET_DRV_WAIT_IF_STATS_UPDATE;
+    CHECK_RC(tapi_cfg_stats_if_stats_get(gen->client_rpcs->ta,
+                                         gen->client_if->if_name,
+                                         &client_after));
+    CHECK_RC(tapi_cfg_stats_if_stats_get(gen->server_rpcs->ta,
+                                         gen->server_if->if_name,
+                                         &server_after));
+
+    sent = client_after.out_ucast_pkts - client_before.out_ucast_pkts;
+    received = server_after.in_ucast_pkts - server_before.in_ucast_pkts;
+
+    trial->rate = rate;
+    trial->tx_pps = (double)sent / TEST_TRIAL_DURATION_SEC;
+    trial->rx_pps = (double)received / TEST_TRIAL_DURATION_SEC;
+    trial->loss = 0;
+    if (sent > received)
+        trial->loss = (double)(sent - received) * 100 / sent;
+
+    RING("Offered %.3f Mpps (requested %" TE_PRINTF_64 "u pps), "
+         "forwarded %.3f Mpps, loss %.4f%%",
+         TE_UNITS_DEC_U2M(trial->tx_pps), rate,
+         TE_UNITS_DEC_U2M(trial->rx_pps), trial->loss);
+}
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *client_rpcs = NULL;
+    rcf_rpc_server *server_rpcs = NULL;
+    const struct if_nameindex *iut_if0 = NULL;
+    const struct if_nameindex *iut_if1 = NULL;
+    const struct if_nameindex *client_if0 = NULL;
+    const struct if_nameindex *server_if0 = NULL;
+    const struct sockaddr *client_addr0 = NULL;
+    const struct sockaddr *server_addr0 = NULL;
+    unsigned int frame_size;
+    double loss_threshold;
+    unsigned int n_threads;
+    unsigned int burst;
+
+    test_gen gen;
+    test_trial trials[TEST_MAX_TRIALS];
+    unsigned int n_trials = 0;
+    test_trial *trial;
+    const test_trial *best = NULL;
+    uint64_t lo;
+    uint64_t hi;
+    te_mi_logger *logger = NULL;
+    te_string str = TE_STRING_INIT;
+    int *cpus = NULL;
+    unsigned int i;
+    int server_s = -1;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(client_rpcs);
+    TEST_GET_PCO(server_rpcs);
+    TEST_GET_IF(iut_if0);
+    TEST_GET_IF(iut_if1);
+    TEST_GET_IF(client_if0);
+    TEST_GET_IF(server_if0);
+    TEST_GET_ADDR(client_rpcs, client_addr0);
+    TEST_GET_ADDR(server_rpcs, server_addr0);
+    TEST_GET_UINT_PARAM(frame_size);
+    TEST_GET_DOUBLE_PARAM(loss_threshold);
+    TEST_GET_UINT_PARAM(n_threads);
+    TEST_GET_UINT_PARAM(burst);
+
+    TEST_STEP("If frames of @p frame_size bytes do not fit current MTU, "
+              "increase it on all the interfaces on the path.");
+    net_drv_perf_ensure_mtu(client_rpcs->ta, client_if0->if_name,
+                            frame_size);
+    net_drv_perf_ensure_mtu(iut_rpcs->ta, iut_if0->if_name, frame_size);
+    net_drv_perf_ensure_mtu(iut_rpcs->ta, iut_if1->if_name, frame_size);
+    net_drv_perf_ensure_mtu(server_rpcs->ta, server_if0->if_name,
+                            frame_size);
+
+    CFG_WAIT_CHANGES;
+
+    TEST_STEP("Create UDP socket on server bound to @p server_addr0 so "
+              "that forwarded packets are delivered to it.");
+    server_s = rpc_socket(server_rpcs,
+                          rpc_socket_domain_by_addr(server_addr0),
+                          RPC_SOCK_DGRAM, RPC_PROTO_DEF);
+    rpc_bind(server_rpcs, server_s, server_addr0);
+
+    gen.client_rpcs = client_rpcs;
+    gen.server_rpcs = server_rpcs;
+    gen.client_if = client_if0;
+    gen.server_if = server_if0;
+    gen.client_addr = client_addr0;
+    gen.server_addr = server_addr0;
+    gen.n_threads = n_threads;
+    gen.burst = burst;
+    gen.pkt_size = net_drv_perf_udp_payload_len(frame_size,
+                                                client_addr0->sa_family);
+    cpus = tapi_calloc(n_threads, sizeof(*cpus));
+    for (i = 0; i < n_threads; i++)
+        cpus[i] = -1;
+    gen.cpus = cpus;
+
+    TEST_STEP("Send UDP packets fitting in @p frame_size bytes frames "
+              "from client to server via IUT at the maximum rate "
+              "client can achieve. If loss does not exceed "
+              "@p loss_threshold, this rate is the result.");
+    trial = &trials[n_trials++];
+    run_trial(&gen, 0, trial);
+    if (trial->rx_pps == 0)
+        TEST_VERDICT("No packets were forwarded by IUT");
+
+    hi = trial->tx_pps;
+    lo = 0;
+    if (trial->loss <= loss_threshold)
+    {
+        best = trial;
+        lo = hi;
+    }
+
+    TEST_STEP("Otherwise binary search the highest rate with loss not "
+              "exceeding @p loss_threshold between zero and the maximum "
+              "rate, running a trial at every step.");
+    while (hi - lo > hi * TEST_SEARCH_RESOLUTION &&
+           n_trials < TEST_MAX_TRIALS)
+    {
+        trial = &trials[n_trials++];
+        run_trial(&gen, (lo + hi) / 2, trial);
+
+        if (trial->loss <= loss_threshold)
+        {
+            lo = trial->rate;
+            best = trial;
+        }
+        else
+        {
+            hi = trial->rate;
+        }
+    }
+
+    TEST_STEP("Report the highest rate with acceptable loss (RFC 2544 "
+              "throughput) and offered load, forwarded rate and loss "
+              "of every trial.");
+    CHECK_RC(te_mi_logger_meas_create("fwd_rfc2544", &logger));
+    te_mi_logger_add_meas_key(logger, NULL, "Frame size", "%u",
+                              frame_size);
+    te_mi_logger_add_meas_key(logger, NULL, "Loss threshold", "%g%%",
+                              loss_threshold);
+
+    for (i = 0; i < n_trials; i++)
+    {
+        te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+                TE_MI_MEAS(PPS, "Offered load", SINGLE,
+                           trials[i].tx_pps, PLAIN),
+                TE_MI_MEAS(PPS, "Forwarded", SINGLE,
+                           trials[i].rx_pps, PLAIN)));
+
+        te_string_reset(&str);
+        te_string_append(&str, "Trial %u loss", i + 1);
+        te_mi_logger_add_comment(logger, NULL, te_string_value(&str),
+                                 "%.4f%% at %.0f pps", trials[i].loss,
+                                 trials[i].tx_pps);
+    }
+
+    if (best == NULL)
+    {
+        CHECK_RC(te_mi_logger_flush(logger));
+        TEST_VERDICT("Loss exceeded the threshold at all tried rates");
+    }
+
+    te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+            TE_MI_MEAS(PPS, "Throughput", SINGLE, best->rx_pps, PLAIN),
+            TE_MI_MEAS(THROUGHPUT, "Throughput", SINGLE,
+                       best->rx_pps * frame_size * 8, PLAIN)));
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    TEST_ARTIFACT("Frame size %u: RFC 2544 throughput %.3f Mpps "
+                  "(%.2f Mbps) with loss %.4f%%, found in %u trials",
+                  frame_size, TE_UNITS_DEC_U2M(best->rx_pps),
+                  TE_UNITS_DEC_U2M(best->rx_pps * frame_size * 8),
+                  best->loss, n_trials);
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    CLEANUP_RPC_CLOSE(server_rpcs, server_s);
+    te_mi_logger_destroy(logger);
+    te_string_free(&str);
+    free(cpus);
+
+    TEST_END;
+}
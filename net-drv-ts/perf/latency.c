@@ -0,0 +1,285 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-latency Request/response latency
+ * @ingroup perf
+ * @{
+ *
+ * @objective Report distribution of request/response round-trip time
+ *            over TCP or UDP depending on interface settings.
+ *
+ * @param env               Testing environment:
+ *                          - @ref env-peer2peer
+ *                          - @ref env-peer2peer_ipv6
+ * @param sock_type         Socket type:
+ *                          - @c SOCK_STREAM
+ *                          - @c SOCK_DGRAM
+ * @param msg_size          Size of request and reply
+ * @param depth             Number of requests in flight
+ * @param rx_coalesce_usecs Value to set for @b rx_coalesce_usecs
+ *                          (@c -1 - keep default settings)
+ * @param rx_max_coalesced_frames   Value to set @b rx_max_coalesced_frames
+ *                                  (@c -1 - keep default settings)
+ * @param rx_ring           Rx rings size (@c -1 - keep default,
+ *                          @c 0 - maximum)
+ * @param tx_ring           Tx rings size (@c -1 - keep default,
+ *                          @c 0 - maximum)
+ * @param channels          Number of combined channels to use
+ *                          (@c -1 - keep default)
+ * @param busy_poll         Busy polling time, in microseconds, set
+ *                          for @b net.core.busy_read and
+ *                          @b net.core.busy_poll on IUT and as
+ *                          @c SO_BUSY_POLL of IUT socket
+ *                          (@c -1 - keep default)
+ * @param napi_defer_hard_irqs  Value to set for @b napi_defer_hard_irqs
+ *                              of IUT interface (@c -1 - keep default)
+ * @param gro_flush_timeout Value to set for @b gro_flush_timeout of IUT
+ *                          interface, in nanoseconds (@c -1 - keep
+ *                          default)
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/latency"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "tapi_cfg_sys.h"
+
+/** How long to send requests, in seconds */
+#define TEST_DURATION_SEC 6
+
+/**
+ * How long the server waits for new requests before terminating,
+ * in milliseconds (it should exceed time after which client considers
+ * requests in flight lost).
+ */
+#define TEST_SERVER_TIME2WAIT 3000
+
+/** Reported percentiles, in thousandths of percent */
+static const unsigned int test_percentiles[] = {
+    50000, 90000, 99000, 99900,
+};
+
+/** Names of reported percentiles */
+static const char *test_percentile_names[] = {
+    "p50", "p90", "p99", "p99.9",
+};
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+    rpc_socket_type sock_type;
+    unsigned int msg_size;
+    unsigned int depth;
+    int rx_coalesce_usecs;
+    int rx_max_coalesced_frames;
+    int rx_ring;
+    int tx_ring;
+    int channels;
+    int busy_poll;
+    int napi_defer_hard_irqs;
+    int gro_flush_timeout;
+
+    uint64_t pct_values[TE_ARRAY_LEN(test_percentiles)];
+    te_mi_logger *logger = NULL;
+    net_drv_rtt_stats stats;
+    te_string str = TE_STRING_INIT;
+    net_drv_cpu_stat cpu_before = NET_DRV_CPU_STAT_INIT;
+    net_drv_cpu_stat cpu_after = NET_DRV_CPU_STAT_INIT;
+    te_vec irq_cpus = TE_VEC_INIT(unsigned int);
+    te_vec irqs = TE_VEC_INIT(unsigned long);
+    te_vec iut_saved = NET_DRV_SYS_SETTINGS_INIT;
+    double util;
+    int64_t rc;
+    unsigned int i;
+    int iut_s = -1;
+    int tst_s = -1;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+    TEST_GET_SOCK_TYPE(sock_type);
+    TEST_GET_UINT_PARAM(msg_size);
+    TEST_GET_UINT_PARAM(depth);
+    TEST_GET_INT_PARAM(rx_coalesce_usecs);
+    TEST_GET_INT_PARAM(rx_max_coalesced_frames);
+    TEST_GET_INT_PARAM(rx_ring);
+    TEST_GET_INT_PARAM(tx_ring);
+    TEST_GET_INT_PARAM(channels);
+    TEST_GET_INT_PARAM(busy_poll);
+    TEST_GET_INT_PARAM(napi_defer_hard_irqs);
+    TEST_GET_INT_PARAM(gro_flush_timeout);
+
+    TEST_STEP("If @p rx_coalesce_usecs or @p rx_max_coalesced_frames is "
+              "not -1, configure Rx coalesce on IUT interface.");
+    net_drv_perf_set_rx_coalesce(iut_rpcs->ta, iut_if->if_name,
+                                 rx_coalesce_usecs,
+                                 rx_max_coalesced_frames);
+
+    TEST_STEP("If @p rx_ring is not -1, set Rx ring size according "
+              "to it on IUT interface.");
+    net_drv_perf_set_ring_size(iut_rpcs->ta, iut_if->if_name,
+                               TRUE, rx_ring);
+
+    TEST_STEP("If @p tx_ring is not -1, set Tx ring size according "
+              "to it on IUT interface.");
+    net_drv_perf_set_ring_size(iut_rpcs->ta, iut_if->if_name,
+                               FALSE, tx_ring);
+
+    TEST_STEP("If @p channels is not -1, set number of combined "
+              "channels on IUT interface according to it.");
+    net_drv_perf_set_channels(iut_rpcs->ta, iut_if->if_name, channels);
+
+    TEST_STEP("If @p busy_poll is not -1, set @b net.core.busy_read "
+              "and @b net.core.busy_poll to it on IUT.");
+    if (busy_poll >= 0)
+    {
+        CHECK_RC(tapi_cfg_sys_set_int(iut_rpcs->ta, busy_poll, NULL,
+                                      "net/core/busy_read"));
+        CHECK_RC(tapi_cfg_sys_set_int(iut_rpcs->ta, busy_poll, NULL,
+                                      "net/core/busy_poll"));
+    }
+
+    CFG_WAIT_CHANGES;
+
+    TEST_STEP("If @p napi_defer_hard_irqs or @p gro_flush_timeout is "
+              "not -1, configure NAPI deferral of IUT interface.");
+    net_drv_perf_set_napi_defer(iut_rpcs, iut_if->if_name,
+                                napi_defer_hard_irqs, gro_flush_timeout,
+                                &iut_saved);
+
+    TEST_STEP("Create a pair of connected sockets of type @p sock_type "
+              "on IUT and Tester.");
+    GEN_CONNECTION(iut_rpcs, tst_rpcs, sock_type, RPC_PROTO_DEF,
+                   iut_addr, tst_addr, &iut_s, &tst_s);
+
+    if (busy_poll > 0)
+    {
+        TEST_SUBSTEP("If @p busy_poll is positive, set @c SO_BUSY_POLL "
+                     "socket option to it on IUT socket.");
+        rpc_setsockopt_int(iut_rpcs, iut_s, RPC_SO_BUSY_POLL, busy_poll);
+    }
+
+    TEST_STEP("Start ping-pong server on Tester which sends back every "
+              "received message.");
+    tst_rpcs->op = RCF_RPC_CALL;
+    rpc_net_drv_pingpong_server(tst_rpcs, tst_s, msg_size,
+                                TEST_SERVER_TIME2WAIT);
+
+    TEST_STEP("Get CPUs handling interrupts of IUT interface queues "
+              "and CPU usage counters on IUT.");
+    if (net_drv_perf_if_irq_cpus(iut_rpcs, iut_if->if_name,
+                                 &irq_cpus, &irqs) != 0)
+        WARN("CPUs handling interrupts of IUT interface are not known");
+    net_drv_perf_cpu_stat_get(iut_rpcs, &cpu_before);
+
+    TEST_STEP("Send requests of @p msg_size bytes from IUT for a few "
+              "seconds, keeping @p depth of them in flight, and collect "
+              "RTT of every request in a histogram on IUT.");
+    iut_rpcs->timeout = TE_SEC2MS(TEST_DURATION_SEC + 5);
+    rc = rpc_net_drv_pingpong_client(iut_rpcs, iut_s, msg_size, depth,
+                                     TE_SEC2MS(TEST_DURATION_SEC),
+                                     test_percentiles,
+                                     TE_ARRAY_LEN(test_percentiles),
+                                     pct_values, &stats);
+
+    net_drv_perf_cpu_stat_get(iut_rpcs, &cpu_after);
+
+    TEST_STEP("Wait until ping-pong server terminates on Tester.");
+    tst_rpcs->timeout = TE_SEC2MS(TEST_DURATION_SEC + 5) +
+                        TEST_SERVER_TIME2WAIT;
+    rpc_net_drv_pingpong_server(tst_rpcs, tst_s, msg_size,
+                                TEST_SERVER_TIME2WAIT);
+
+    if (rc == 0)
+        TEST_VERDICT("No replies were received");
+    if (stats.lost > 0)
+    {
+        WARN("%" TE_PRINTF_64 "u requests or replies were lost",
+             stats.lost);
+    }
+
+    TEST_STEP("Report transaction rate, minimum, mean and maximum RTT "
+              "and RTT percentiles.");
+    CHECK_RC(te_mi_logger_meas_create("latency", &logger));
+
+    te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+            TE_MI_MEAS(RPS, "Transactions", SINGLE,
+                       (double)stats.count / TEST_DURATION_SEC, PLAIN),
+            TE_MI_MEAS(LATENCY, "RTT", MIN, stats.min, NANO),
+            TE_MI_MEAS(LATENCY, "RTT", MEAN, stats.mean, NANO),
+            TE_MI_MEAS(LATENCY, "RTT", MAX, stats.max, NANO)));
+
+    for (i = 0; i < TE_ARRAY_LEN(test_percentiles); i++)
+    {
+        te_string_reset(&str);
+        te_string_append(&str, "RTT %s", test_percentile_names[i]);
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_LATENCY,
+                              te_string_value(&str),
+                              TE_MI_MEAS_AGGR_SINGLE, pct_values[i],
+                              TE_MI_MEAS_MULTIPLIER_NANO);
+    }
+
+    TEST_STEP("Report CPU usage on IUT and utilisation of every CPU "
+              "handling interrupts of IUT interface (busy polling "
+              "moves packets processing from interrupt context to "
+              "the polling application).");
+    net_drv_perf_cpu_usage_mi_log(logger, "IUT", &cpu_before, &cpu_after,
+                                  (double)stats.count * msg_size * 2,
+                                  stats.count * 2);
+    for (i = 0; i < te_vec_size(&irq_cpus); i++)
+    {
+        util = net_drv_perf_cpu_util(&cpu_before, &cpu_after,
+                                     TE_VEC_GET(unsigned int, &irq_cpus, i));
+        if (util < 0)
+            continue;
+
+        te_string_reset(&str);
+        te_string_append(&str, "IRQ %lu CPU",
+                         TE_VEC_GET(unsigned long, &irqs, i));
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_CPU,
+                              te_string_value(&str),
+                              TE_MI_MEAS_AGGR_SINGLE, util,
+                              TE_MI_MEAS_MULTIPLIER_PLAIN);
+    }
+
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    TEST_ARTIFACT("RTT: mean %.1f us, p50 %.1f us, p99 %.1f us, "
+                  "p99.9 %.1f us, max %.1f us",
+                  stats.mean / 1000.0, pct_values[0] / 1000.0,
+                  pct_values[2] / 1000.0, pct_values[3] / 1000.0,
+                  stats.max / 1000.0);
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
+    CLEANUP_RPC_CLOSE(tst_rpcs, tst_s);
+    te_mi_logger_destroy(logger);
+    te_string_free(&str);
+    net_drv_perf_cpu_stat_free(&cpu_before);
+    net_drv_perf_cpu_stat_free(&cpu_after);
+    te_vec_free(&irq_cpus);
+    te_vec_free(&irqs);
+    if (iut_rpcs != NULL)
+        net_drv_perf_restore_sys(iut_rpcs, &iut_saved);
+
+    TEST_END;
+}
@@ -0,0 +1,347 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-mem_footprint Driver memory footprint
+ * @ingroup perf
+ * @{
+ *
+ * @objective Measure how much memory IUT driver consumes depending
+ *            on ring sizes and number of channels.
+ *
+ * @param env               Testing environment:
+ *                          - @ref env-iut_only
+ * @param ring_sizes        Comma-separated list of Rx and Tx ring sizes
+ *                          (sizes not supported by IUT interface are
+ *                          skipped)
+ * @param channels          Comma-separated list of numbers of combined
+ *                          channels (numbers greater than maximum
+ *                          supported by IUT interface are skipped)
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/mem_footprint"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "tapi_cfg_if.h"
+#include "tapi_cfg_if_chan.h"
+
+/** Maximum number of values in a list parameter */
+#define TEST_MAX_VALUES 16
+
+/**
+ * How long to wait after changing rings configuration before taking
+ * memory snapshot, in seconds.
+ */
+#define TEST_SETTLE_TIME_SEC 2
+
+/** Memory usage measured with a single rings configuration */
+typedef struct test_point {
+    unsigned int channels;      /**< Number of combined channels */
+    unsigned int ring_size;     /**< Rx and Tx ring size */
+    int64_t used;               /**< Decrease of free memory compared
+                                     to the initial state, bytes */
+    int64_t slab;               /**< Increase of slab memory, bytes */
+    int64_t node_used;          /**< Decrease of free memory of NUMA
+                                     node of the interface, bytes */
+    int page_pools;             /**< Number of page pools */
+    uint64_t page_pool_mem;     /**< Memory held by page pools, bytes */
+} test_point;
+
+/**
+ * Parse comma-separated list of positive integers.
+ *
+ * @param name      Parameter name.
+ * @param str       String to parse.
+ * @param values    Where to save values.
+ *
+ * @return Number of values.
+ */
+static unsigned int
+parse_list(const char *name, const char *str, unsigned int *values)
+{
+    unsigned int n = 0;
+    const char *p = str;
+    char *end;
+    long val;
+
+    while (*p != '\0')
+    {
+        val = strtol(p, &end, 10);
+        if (end == p || val <= 0 || n == TEST_MAX_VALUES)
+            TEST_FAIL("Invalid list of %s values: '%s'", name, str);
+
+        values[n++] = val;
+
+        p = end;
+        while (*p == ',' || *p == ' ')
+            p++;
+    }
+
+    if (n == 0)
+        TEST_FAIL("Empty list of %s values", name);
+
+    return n;
+}
+
+/** Get free memory of a NUMA node from memory snapshot */
+static int64_t
+node_free(const net_drv_mem_stat *stat, int node)
+{
+    if (node < 0 || (size_t)node >= te_vec_size(&stat->node_free))
+        return 0;
+
+    return TE_VEC_GET(uint64_t, &stat->node_free, node);
+}
+
+/**
+ * Remove values exceeding the maximum supported by the interface
+ * from a list.
+ *
+ * @param name      Parameter name.
+ * @param values    List of values.
+ * @param n         Number of values.
+ * @param max       Maximum supported value.
+ *
+ * @return Number of values left in the list.
+ */
+static unsigned int
+filter_list(const char *name, unsigned int *values, unsigned int n,
+            unsigned int max)
+{
+    unsigned int n_left = 0;
+    unsigned int i;
+
+    for (i = 0; i < n; i++)
+    {
+        if (values[i] > max)
+        {
+            RING("%s value %u is skipped since it is greater than "
+                 "maximum %u supported by IUT interface", name,
+                 values[i], max);
+            continue;
+        }
+
+        values[n_left++] = values[i];
+    }
+
+    if (n_left == 0)
+    {
+        TEST_SKIP("All %s values are greater than maximum supported by "
+                  "IUT interface", name);
+    }
+
+    return n_left;
+}
+
+/** Add memory size measurement in bytes to MI logger */
+static void
+mi_log_bytes(te_mi_logger *logger, te_string *name, double bytes,
+             const char *fmt, ...)
+{
+    va_list ap;
+
+    te_string_reset(name);
+    va_start(ap, fmt);
+    te_string_append_va(name, fmt, ap);
+    va_end(ap);
+
+    te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_MEM,
+                          te_string_value(name), TE_MI_MEAS_AGGR_SINGLE,
+                          bytes, TE_MI_MEAS_MULTIPLIER_PLAIN);
+}
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const char *ring_sizes;
+    const char *channels;
+
+    unsigned int ring_values[TEST_MAX_VALUES];
+    unsigned int chan_values[TEST_MAX_VALUES];
+    unsigned int n_rings;
+    unsigned int n_chans;
+    test_point *points = NULL;
+    test_point *pt;
+    test_point *first;
+    test_point *last;
+    unsigned int n_points;
+    net_drv_mem_stat initial = NET_DRV_MEM_STAT_INIT;
+    net_drv_mem_stat stat = NET_DRV_MEM_STAT_INIT;
+    te_mi_logger *logger = NULL;
+    te_string name = TE_STRING_INIT;
+    double per_desc;
+    double per_chan;
+    int64_t rx_ring_max;
+    int64_t tx_ring_max;
+    int chan_max;
+    int node;
+    unsigned int i;
+    unsigned int j;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_STRING_PARAM(ring_sizes);
+    TEST_GET_STRING_PARAM(channels);
+
+    n_rings = parse_list("ring_sizes", ring_sizes, ring_values);
+    n_chans = parse_list("channels", channels, chan_values);
+
+    TEST_STEP("Skip values of @p ring_sizes and @p channels which are "
+              "greater than maximums supported by IUT interface.");
+    CHECK_RC(tapi_cfg_if_get_max_ring_size(iut_rpcs->ta, iut_if->if_name,
+                                           TRUE, &rx_ring_max));
+    CHECK_RC(tapi_cfg_if_get_max_ring_size(iut_rpcs->ta, iut_if->if_name,
+                                           FALSE, &tx_ring_max));
+    CHECK_RC(tapi_cfg_if_chan_max_get(iut_rpcs->ta, iut_if->if_name,
+                                      TAPI_CFG_IF_CHAN_COMBINED,
+                                      &chan_max));
+
+    n_rings = filter_list("ring_sizes", ring_values, n_rings,
+                          MIN(rx_ring_max, tx_ring_max));
+    n_chans = filter_list("channels", chan_values, n_chans, chan_max);
+    n_points = n_rings * n_chans;
+    points = tapi_calloc(n_points, sizeof(*points));
+
+    node = net_drv_perf_if_numa_node(iut_rpcs, iut_if->if_name);
+
+    TEST_STEP("Take initial snapshot of memory usage on IUT: free "
+              "memory, slab memory, free memory of every NUMA node and "
+              "memory held by page pools of IUT interface.");
+    net_drv_perf_mem_stat_get(iut_rpcs, iut_if->if_name, &initial);
+
+    TEST_STEP("For every number of combined channels from @p channels "
+              "and every ring size from @p ring_sizes:");
+    for (i = 0; i < n_chans; i++)
+    {
+        TEST_SUBSTEP("Set number of combined channels on IUT "
+                     "interface.");
+        net_drv_perf_set_channels(iut_rpcs->ta, iut_if->if_name,
+                                  chan_values[i]);
+
+        for (j = 0; j < n_rings; j++)
+        {
+            pt = &points[i * n_rings + j];
+            pt->channels = chan_values[i];
+            pt->ring_size = ring_values[j];
+
+            TEST_SUBSTEP("Set Rx and Tx ring sizes on IUT interface, "
+                         "wait for a while and take snapshot of memory "
+                         "usage. Compute its change compared to the "
+                         "initial snapshot.");
+            net_drv_perf_set_ring_size(iut_rpcs->ta, iut_if->if_name,
+                                       TRUE, pt->ring_size);
+            net_drv_perf_set_ring_size(iut_rpcs->ta, iut_if->if_name,
+                                       FALSE, pt->ring_size);
+            CFG_WAIT_CHANGES;
+            te_motivated_sleep(TEST_SETTLE_TIME_SEC,
+                               "let the driver reallocate rings and "
+                               "freed memory return to the allocator");
+
+            net_drv_perf_mem_stat_get(iut_rpcs, iut_if->if_name, &stat);
+
+            pt->used = (int64_t)initial.mem_free - (int64_t)stat.mem_free;
+            pt->slab = (int64_t)stat.slab - (int64_t)initial.slab;
+            pt->node_used = node_free(&initial, node) -
+                            node_free(&stat, node);
+            pt->page_pools = stat.page_pools;
+            pt->page_pool_mem = stat.page_pool_mem;
+
+            RING("Channels %u, ring size %u: %jd bytes used, slab "
+                 "%+jd bytes, %jd bytes used on NUMA node %d, %d page "
+                 "pools holding %" TE_PRINTF_64 "u bytes",
+                 pt->channels, pt->ring_size, (intmax_t)pt->used,
+                 (intmax_t)pt->slab, (intmax_t)pt->node_used, node,
+                 pt->page_pools, pt->page_pool_mem);
+        }
+    }
+
+    TEST_STEP("Report memory usage for every configuration, bytes "
+              "consumed per descriptor (for every number of channels, "
+              "from the first and the last of @p ring_sizes, counting "
+              "both Rx and Tx rings of every channel) and bytes "
+              "consumed per channel (for every ring size, from "
+              "the first and the last of @p channels).");
+    CHECK_RC(te_mi_logger_meas_create("mem_footprint", &logger));
+
+    for (i = 0; i < n_points; i++)
+    {
+        pt = &points[i];
+
+        mi_log_bytes(logger, &name, pt->used,
+                     "channels %u ring %u used", pt->channels,
+                     pt->ring_size);
+        mi_log_bytes(logger, &name, pt->slab,
+                     "channels %u ring %u slab", pt->channels,
+                     pt->ring_size);
+        if (node >= 0)
+        {
+            mi_log_bytes(logger, &name, pt->node_used,
+                         "channels %u ring %u used on node %d",
+                         pt->channels, pt->ring_size, node);
+        }
+        if (pt->page_pools >= 0)
+        {
+            mi_log_bytes(logger, &name, pt->page_pool_mem,
+                         "channels %u ring %u page pools",
+                         pt->channels, pt->ring_size);
+        }
+    }
+
+    for (i = 0; i < n_chans && n_rings > 1; i++)
+    {
+        first = &points[i * n_rings];
+        last = &points[i * n_rings + n_rings - 1];
+        if (last->ring_size == first->ring_size)
+            continue;
+
+        per_desc = (double)(last->used - first->used) /
+                   ((double)(last->ring_size - first->ring_size) *
+                    first->channels * 2);
+
+        RING("Channels %u: %.1f bytes per descriptor", first->channels,
+             per_desc);
+        mi_log_bytes(logger, &name, per_desc,
+                     "channels %u bytes per descriptor", first->channels);
+    }
+
+    for (j = 0; j < n_rings && n_chans > 1; j++)
+    {
+        first = &points[j];
+        last = &points[(n_chans - 1) * n_rings + j];
+        if (last->channels == first->channels)
+            continue;
+
+        per_chan = (double)(last->used - first->used) /
+                   ((double)last->channels - first->channels);
+
+        RING("Ring size %u: %.0f bytes per channel", first->ring_size,
+             per_chan);
+        mi_log_bytes(logger, &name, per_chan,
+                     "ring %u bytes per channel", first->ring_size);
+    }
+
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    te_mi_logger_destroy(logger);
+    net_drv_perf_mem_stat_free(&initial);
+    net_drv_perf_mem_stat_free(&stat);
+    te_string_free(&name);
+    free(points);
+
+    TEST_END;
+}
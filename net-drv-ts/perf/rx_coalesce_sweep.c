@@ -0,0 +1,343 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-rx_coalesce_sweep Rx coalescing sweep
+ * @ingroup perf
+ * @{
+ *
+ * @objective Measure throughput, interrupt rate and request/response
+ *            latency for a list of Rx coalescing settings within
+ *            a single run and report latency versus throughput
+ *            frontier.
+ *
+ * @param env               Testing environment:
+ *                          - @ref env-peer2peer
+ *                          - @ref env-peer2peer_ipv6
+ * @param rx_coalesce_usecs Comma-separated list of values of
+ *                          @b rx_coalesce_usecs to try
+ * @param rx_max_coalesced_frames   Value to set @b rx_max_coalesced_frames
+ *                                  (@c -1 - keep default settings)
+ * @param buf_size          Size of buffer passed to every send() call
+ *                          when measuring throughput
+ * @param msg_size          Size of request and reply when measuring
+ *                          latency
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/rx_coalesce_sweep"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "te_units.h"
+
+/** How long to measure throughput at every point, in seconds */
+#define TEST_BULK_DURATION_SEC 4
+
+/** How long to measure latency at every point, in seconds */
+#define TEST_LAT_DURATION_SEC 3
+
+/** How long the ping-pong server waits for requests, in milliseconds */
+#define TEST_SERVER_TIME2WAIT 3000
+
+/** Maximum number of points in a sweep */
+#define TEST_MAX_POINTS 32
+
+/** Reported latency percentiles, in thousandths of percent */
+static const unsigned int test_percentiles[] = { 50000, 99000 };
+
+/** Results measured with a single coalescing setting */
+typedef struct test_point {
+    int usecs;              /**< Value of rx_coalesce_usecs */
+    double throughput;      /**< Throughput, in bits per second */
+    double irq_rate;        /**< Interrupts per second on IUT */
+    uint64_t lat_p50;       /**< Median RTT, in nanoseconds */
+    uint64_t lat_p99;       /**< 99th percentile of RTT, in
+                                 nanoseconds */
+    te_bool frontier;       /**< Whether the point is on the frontier */
+} test_point;
+
+/**
+ * Parse comma-separated list of coalescing values.
+ *
+ * @param str       String to parse.
+ * @param points    Where to save values.
+ *
+ * @return Number of values.
+ */
+static unsigned int
+parse_usecs_list(const char *str, test_point *points)
+{
+    unsigned int n = 0;
+    const char *p = str;
+    char *end;
+    long val;
+
+    while (*p != '\0')
+    {
+        val = strtol(p, &end, 10);
+        if (end == p || val < 0 || n == TEST_MAX_POINTS)
+        {
+            TEST_FAIL("Invalid list of rx_coalesce_usecs values: '%s'",
+                      str);
+        }
+
+        points[n++].usecs = val;
+
+        p = end;
+        while (*p == ',' || *p == ' ')
+            p++;
+    }
+
+    return n;
+}
+
+/**
+ * Mark points on the latency versus throughput frontier, i.e. points
+ * for which no other point has both higher throughput and lower 99th
+ * percentile of RTT.
+ */
+static void
+mark_frontier(test_point *points, unsigned int n)
+{
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; i < n; i++)
+    {
+        points[i].frontier = TRUE;
+        for (j = 0; j < n; j++)
+        {
+            if (j != i &&
+                points[j].throughput >= points[i].throughput &&
+                points[j].lat_p99 <= points[i].lat_p99 &&
+                (points[j].throughput > points[i].throughput ||
+                 points[j].lat_p99 < points[i].lat_p99))
+            {
+                points[i].frontier = FALSE;
+                break;
+            }
+        }
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+    const char *rx_coalesce_usecs;
+    int rx_max_coalesced_frames;
+    unsigned int buf_size;
+    unsigned int msg_size;
+
+    struct sockaddr_storage iut_lat_addr;
+    struct sockaddr_storage tst_lat_addr;
+    test_point points[TEST_MAX_POINTS];
+    unsigned int n_points;
+    test_point *pt;
+    uint64_t pct_values[TE_ARRAY_LEN(test_percentiles)];
+    net_drv_rtt_stats rtt_stats;
+    net_drv_zc_stats send_stats;
+    uint64_t irqs_before;
+    uint64_t irqs_after;
+    uint64_t read;
+    int64_t sent;
+    int drain_rc;
+    te_errno rc;
+    te_mi_logger *logger = NULL;
+    te_string name = TE_STRING_INIT;
+    te_string frontier = TE_STRING_INIT;
+    unsigned int i;
+    int iut_bulk_s = -1;
+    int tst_bulk_s = -1;
+    int iut_lat_s = -1;
+    int tst_lat_s = -1;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+    TEST_GET_STRING_PARAM(rx_coalesce_usecs);
+    TEST_GET_INT_PARAM(rx_max_coalesced_frames);
+    TEST_GET_UINT_PARAM(buf_size);
+    TEST_GET_UINT_PARAM(msg_size);
+
+    memset(points, 0, sizeof(points));
+    n_points = parse_usecs_list(rx_coalesce_usecs, points);
+
+    TEST_STEP("Establish two TCP connections between IUT and Tester: one "
+              "for bulk traffic and another one for request/response "
+              "traffic. They are kept for all the points of the sweep.");
+    GEN_CONNECTION(iut_rpcs, tst_rpcs, RPC_SOCK_STREAM, RPC_PROTO_DEF,
+                   iut_addr, tst_addr, &iut_bulk_s, &tst_bulk_s);
+
+    tapi_sockaddr_clone_exact(iut_addr, &iut_lat_addr);
+    tapi_sockaddr_clone_exact(tst_addr, &tst_lat_addr);
+    CHECK_RC(tapi_allocate_set_port(iut_rpcs, SA(&iut_lat_addr)));
+    CHECK_RC(tapi_allocate_set_port(tst_rpcs, SA(&tst_lat_addr)));
+    GEN_CONNECTION(iut_rpcs, tst_rpcs, RPC_SOCK_STREAM, RPC_PROTO_DEF,
+                   SA(&iut_lat_addr), SA(&tst_lat_addr),
+                   &iut_lat_s, &tst_lat_s);
+
+    for (i = 0; i < n_points; i++)
+    {
+        pt = &points[i];
+
+        TEST_SUBSTEP("Set @b rx_coalesce_usecs to the next value from "
+                     "@p rx_coalesce_usecs list (and "
+                     "@b rx_max_coalesced_frames to "
+                     "@p rx_max_coalesced_frames if it is not -1) on IUT "
+                     "interface.");
+        net_drv_perf_set_rx_coalesce(iut_rpcs->ta, iut_if->if_name,
+                                     pt->usecs, rx_max_coalesced_frames);
+        CFG_WAIT_CHANGES;
+
+        TEST_SUBSTEP("Send data from Tester to IUT over the bulk "
+                     "connection for a few seconds, receiving it on IUT. "
+                     "Compute throughput and rate of interrupts of IUT "
+                     "interface.");
+        rc = net_drv_perf_get_if_interrupts(iut_rpcs, iut_if->if_name,
+                                            &irqs_before);
+        if (rc != 0)
+        {
+            TEST_SKIP("Interrupts of IUT interface cannot be found in "
+                      "/proc/interrupts");
+        }
+
+        iut_rpcs->op = RCF_RPC_CALL;
+        rpc_drain_fd_duration(iut_rpcs, iut_bulk_s, buf_size, -1,
+                              TEST_BULK_DURATION_SEC + 1, NULL);
+
+        tst_rpcs->timeout = TE_SEC2MS(TEST_BULK_DURATION_SEC + 2);
+        sent = rpc_net_drv_send_zc(tst_rpcs, tst_bulk_s, buf_size,
+                                   TE_SEC2MS(TEST_BULK_DURATION_SEC),
+                                   FALSE, &send_stats);
+
+        RPC_AWAIT_ERROR(iut_rpcs);
+        drain_rc = rpc_drain_fd_duration(iut_rpcs, iut_bulk_s, buf_size,
+                                         -1, TEST_BULK_DURATION_SEC + 1,
+                                         &read);
+        if (drain_rc < 0 && RPC_ERRNO(iut_rpcs) != RPC_EAGAIN)
+        {
+            TEST_VERDICT("Receiving data on IUT failed with error "
+                         RPC_ERROR_FMT, RPC_ERROR_ARGS(iut_rpcs));
+        }
+
+        CHECK_RC(net_drv_perf_get_if_interrupts(iut_rpcs, iut_if->if_name,
+                                                &irqs_after));
+
+        if (read != (uint64_t)sent)
+            TEST_VERDICT("Not all the data sent from Tester was received");
+
+        pt->throughput = (double)read * 8 / TEST_BULK_DURATION_SEC;
+        pt->irq_rate = (double)(irqs_after - irqs_before) /
+                       TEST_BULK_DURATION_SEC;
+
+        TEST_SUBSTEP("Send requests from Tester over the request/response "
+                     "connection for a few seconds, replying to them on "
+                     "IUT, and get median and 99th percentile of RTT.");
+        iut_rpcs->op = RCF_RPC_CALL;
+        rpc_net_drv_pingpong_server(iut_rpcs, iut_lat_s, msg_size,
+                                    TEST_SERVER_TIME2WAIT);
+
+        tst_rpcs->timeout = TE_SEC2MS(TEST_LAT_DURATION_SEC + 5);
+        rpc_net_drv_pingpong_client(tst_rpcs, tst_lat_s, msg_size, 1,
+                                    TE_SEC2MS(TEST_LAT_DURATION_SEC),
+                                    test_percentiles,
+                                    TE_ARRAY_LEN(test_percentiles),
+                                    pct_values, &rtt_stats);
+
+        iut_rpcs->timeout = TE_SEC2MS(TEST_LAT_DURATION_SEC + 5) +
+                            TEST_SERVER_TIME2WAIT;
+        rpc_net_drv_pingpong_server(iut_rpcs, iut_lat_s, msg_size,
+                                    TEST_SERVER_TIME2WAIT);
+
+        if (rtt_stats.count == 0)
+            TEST_VERDICT("No replies were received");
+
+        pt->lat_p50 = pct_values[0];
+        pt->lat_p99 = pct_values[1];
+
+        RING("rx_coalesce_usecs %d: throughput %.2f Mbps, %.0f "
+             "interrupts/s, RTT p50 %.1f us, p99 %.1f us", pt->usecs,
+             TE_UNITS_DEC_U2M(pt->throughput), pt->irq_rate,
+             pt->lat_p50 / 1000.0, pt->lat_p99 / 1000.0);
+    }
+
+    TEST_STEP("Report throughput, interrupt rate and RTT for every point "
+              "and the points forming latency versus throughput "
+              "frontier.");
+    mark_frontier(points, n_points);
+
+    CHECK_RC(te_mi_logger_meas_create("rx_coalesce_sweep", &logger));
+    for (i = 0; i < n_points; i++)
+    {
+        pt = &points[i];
+
+        te_string_reset(&name);
+        te_string_append(&name, "rx-usecs %d", pt->usecs);
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_THROUGHPUT,
+                              te_string_value(&name),
+                              TE_MI_MEAS_AGGR_SINGLE, pt->throughput,
+                              TE_MI_MEAS_MULTIPLIER_PLAIN);
+
+        te_string_reset(&name);
+        te_string_append(&name, "rx-usecs %d RTT p50", pt->usecs);
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_LATENCY,
+                              te_string_value(&name),
+                              TE_MI_MEAS_AGGR_SINGLE, pt->lat_p50,
+                              TE_MI_MEAS_MULTIPLIER_NANO);
+
+        te_string_reset(&name);
+        te_string_append(&name, "rx-usecs %d RTT p99", pt->usecs);
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_LATENCY,
+                              te_string_value(&name),
+                              TE_MI_MEAS_AGGR_SINGLE, pt->lat_p99,
+                              TE_MI_MEAS_MULTIPLIER_NANO);
+
+        te_string_reset(&name);
+        te_string_append(&name, "rx-usecs %d interrupts/s", pt->usecs);
+        te_mi_logger_add_comment(logger, NULL, te_string_value(&name),
+                                 "%.0f", pt->irq_rate);
+
+        if (pt->frontier)
+        {
+            te_string_append(&frontier, "%s%d", frontier.len > 0 ?
+                             ", " : "", pt->usecs);
+        }
+    }
+
+    te_mi_logger_add_comment(logger, NULL, "Frontier rx-usecs", "%s",
+                             te_string_value(&frontier));
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    TEST_ARTIFACT("Latency versus throughput frontier is formed by "
+                  "rx_coalesce_usecs values: %s",
+                  te_string_value(&frontier));
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    CLEANUP_RPC_CLOSE(iut_rpcs, iut_bulk_s);
+    CLEANUP_RPC_CLOSE(tst_rpcs, tst_bulk_s);
+    CLEANUP_RPC_CLOSE(iut_rpcs, iut_lat_s);
+    CLEANUP_RPC_CLOSE(tst_rpcs, tst_lat_s);
+    te_mi_logger_destroy(logger);
+    te_string_free(&name);
+    te_string_free(&frontier);
+
+    TEST_END;
+}
@@ -0,0 +1,256 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-tcp_cps TCP connection rate
+ * @ingroup perf
+ * @{
+ *
+ * @objective Measure rate at which short TCP connections can be
+ *            established and torn down and check how they are spread
+ *            across Rx queues of IUT interface.
+ *
+ * @param env               Testing environment:
+ *                          - @ref env-peer2peer
+ *                          - @ref env-peer2peer_ipv6
+ * @param iut_role          Role of IUT:
+ *                          - @c client (IUT opens connections to
+ *                            a server on Tester)
+ *                          - @c server (IUT accepts connections opened
+ *                            from Tester)
+ * @param n_threads         Number of client threads and of server
+ *                          threads
+ * @param msg_size          Size of request and of response sent over
+ *                          every connection
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/tcp_cps"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "tapi_bpf_rxq_stats.h"
+
+/** How long to open connections, in seconds */
+#define TEST_DURATION_SEC 10
+
+/**
+ * How long the server accepts connections after the client stops,
+ * in seconds.
+ */
+#define TEST_SERVER_MARGIN_SEC 2
+
+/** The list of values allowed for parameter of type 'iut_role' */
+#define TEST_IUT_ROLE_MAPPING_LIST  \
+    { "client", TRUE },             \
+    { "server", FALSE }
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+    te_bool iut_client;
+    unsigned int n_threads;
+    unsigned int msg_size;
+
+    rcf_rpc_server *client_rpcs;
+    rcf_rpc_server *server_rpcs;
+    const struct sockaddr *server_addr;
+    struct sockaddr_storage src_addr;
+    struct sockaddr_storage dst_addr;
+
+    te_mi_logger *logger = NULL;
+    te_string name = TE_STRING_INIT;
+    net_drv_cps_thread_stats *client_stats = NULL;
+    tapi_bpf_rxq_stats *rxq_stats = NULL;
+    unsigned int rxq_stats_count = 0;
+    unsigned int bpf_id = 0;
+    te_bool bpf_loaded = FALSE;
+    int *cpus = NULL;
+    int64_t conns;
+    int64_t accepted;
+    uint64_t errors = 0;
+    uint64_t syn_retrans = 0;
+    uint64_t total_pkts = 0;
+    uint64_t max_pkts = 0;
+    unsigned int used_queues = 0;
+    double cps;
+    unsigned int i;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+    TEST_GET_ENUM_PARAM(iut_client, TEST_IUT_ROLE_MAPPING_LIST);
+    TEST_GET_UINT_PARAM(n_threads);
+    TEST_GET_UINT_PARAM(msg_size);
+
+    if (iut_client)
+    {
+        client_rpcs = iut_rpcs;
+        server_rpcs = tst_rpcs;
+        server_addr = tst_addr;
+    }
+    else
+    {
+        client_rpcs = tst_rpcs;
+        server_rpcs = iut_rpcs;
+        server_addr = iut_addr;
+    }
+
+    TEST_STEP("Link @b rxq_stats XDP program to IUT interface and "
+              "configure it to count TCP packets of test connections "
+              "received by IUT (from server address if IUT is client, "
+              "to server address if IUT is server; port of the other "
+              "side is not checked).");
+    CHECK_RC(tapi_bpf_rxq_stats_init(iut_rpcs->ta, iut_if->if_name,
+                                     "rss_bpf", &bpf_id));
+    bpf_loaded = TRUE;
+
+    tapi_sockaddr_clone_exact(tst_addr, &src_addr);
+    tapi_sockaddr_clone_exact(iut_addr, &dst_addr);
+    if (iut_client)
+        te_sockaddr_set_port(SA(&dst_addr), 0);
+    else
+        te_sockaddr_set_port(SA(&src_addr), 0);
+
+    CHECK_RC(tapi_bpf_rxq_stats_reset(iut_rpcs->ta, bpf_id));
+    CHECK_RC(tapi_bpf_rxq_stats_set_params(
+                  iut_rpcs->ta, bpf_id, iut_addr->sa_family,
+                  SA(&src_addr), SA(&dst_addr), IPPROTO_TCP, TRUE));
+    CHECK_RC(tapi_bpf_rxq_stats_clear(iut_rpcs->ta, bpf_id));
+
+    cpus = tapi_calloc(n_threads, sizeof(*cpus));
+    for (i = 0; i < n_threads; i++)
+        cpus[i] = -1;
+
+    TEST_STEP("Start @p n_threads server threads accepting connections "
+              "on the server address with @c SO_REUSEPORT. Every "
+              "accepted connection receives a request of @p msg_size "
+              "bytes, sends a response of the same size and is closed.");
+    server_rpcs->op = RCF_RPC_CALL;
+    rpc_net_drv_cps_server(server_rpcs, server_addr, cpus, n_threads,
+                           msg_size, msg_size,
+                           TE_SEC2MS(TEST_DURATION_SEC +
+                                     TEST_SERVER_MARGIN_SEC), NULL);
+
+    te_motivated_msleep(500, "make sure that server sockets are "
+                        "listening");
+
+    TEST_STEP("For a few seconds open connections to the server from "
+              "@p n_threads client threads as fast as possible, "
+              "exchanging a single request and response over every "
+              "connection and closing it after the server does.");
+    client_rpcs->timeout = TE_SEC2MS(TEST_DURATION_SEC + 5);
+    conns = rpc_net_drv_cps_client(client_rpcs, server_addr, cpus,
+                                   n_threads, msg_size, msg_size,
+                                   TE_SEC2MS(TEST_DURATION_SEC),
+                                   &client_stats, &syn_retrans);
+
+    server_rpcs->timeout = TE_SEC2MS(TEST_SERVER_MARGIN_SEC + 5);
+    accepted = rpc_net_drv_cps_server(server_rpcs, server_addr, cpus,
+                                      n_threads, msg_size, msg_size,
+                                      TE_SEC2MS(TEST_DURATION_SEC +
+                                                TEST_SERVER_MARGIN_SEC),
+                                      NULL);
+
+    for (i = 0; i < n_threads; i++)
+        errors += client_stats[i].errors;
+
+    RING("%jd connections were completed by client, %jd by server, "
+         "%" TE_PRINTF_64 "u connections failed, "
+         "%" TE_PRINTF_64 "u SYN retransmits on client",
+         (intmax_t)conns, (intmax_t)accepted, errors, syn_retrans);
+
+    if (conns == 0)
+        TEST_VERDICT("No connections were completed");
+
+    TEST_STEP("Get numbers of packets of test connections received on "
+              "every Rx queue of IUT.");
+    CHECK_RC(tapi_bpf_rxq_stats_read(iut_rpcs->ta, bpf_id, &rxq_stats,
+                                     &rxq_stats_count));
+    tapi_bpf_rxq_stats_print(NULL, rxq_stats, rxq_stats_count);
+
+    for (i = 0; i < rxq_stats_count; i++)
+    {
+        total_pkts += rxq_stats[i].pkts;
+        max_pkts = MAX(max_pkts, rxq_stats[i].pkts);
+        if (rxq_stats[i].pkts > 0)
+            used_queues++;
+    }
+
+    TEST_STEP("Report connections per second, number of failed "
+              "connections, SYN retransmits and spread of received "
+              "packets across Rx queues of IUT.");
+    cps = (double)conns / TEST_DURATION_SEC;
+
+    TEST_ARTIFACT("IUT %s: %.0f connections/s, %" TE_PRINTF_64 "u failed, "
+                  "%" TE_PRINTF_64 "u SYN retransmits, packets received "
+                  "over %u Rx queues",
+                  TEST_STRING_PARAM(iut_role), cps, errors, syn_retrans,
+                  used_queues);
+
+    CHECK_RC(te_mi_logger_meas_create("tcp_cps", &logger));
+    te_mi_logger_add_meas_key(logger, NULL, "IUT role", "%s",
+                              TEST_STRING_PARAM(iut_role));
+    te_mi_logger_add_meas_key(logger, NULL, "Threads", "%u", n_threads);
+    te_mi_logger_add_meas_key(logger, NULL, "Message size", "%u",
+                              msg_size);
+    te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_RPS, "Connections",
+                          TE_MI_MEAS_AGGR_SINGLE, cps,
+                          TE_MI_MEAS_MULTIPLIER_PLAIN);
+    te_mi_logger_add_comment(logger, NULL, "Failed connections",
+                             "%" TE_PRINTF_64 "u", errors);
+    te_mi_logger_add_comment(logger, NULL, "SYN retransmits",
+                             "%" TE_PRINTF_64 "u", syn_retrans);
+    te_mi_logger_add_comment(logger, NULL, "Rx queues used", "%u",
+                             used_queues);
+    if (total_pkts > 0)
+    {
+        te_mi_logger_add_comment(logger, NULL, "Max Rx queue share",
+                                 "%.1f%%",
+                                 100.0 * max_pkts / total_pkts);
+    }
+
+    for (i = 0; i < rxq_stats_count; i++)
+    {
+        te_string_reset(&name);
+        te_string_append(&name, "Rx queue %u packets",
+                         rxq_stats[i].rx_queue);
+        te_mi_logger_add_comment(logger, NULL, te_string_value(&name),
+                                 "%" TE_PRINTF_64 "u",
+                                 (uint64_t)rxq_stats[i].pkts);
+    }
+
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    if (bpf_loaded)
+    {
+        CLEANUP_CHECK_RC(tapi_bpf_rxq_stats_fini(iut_rpcs->ta,
+                                                 iut_if->if_name, bpf_id));
+    }
+
+    te_mi_logger_destroy(logger);
+    te_string_free(&name);
+    free(client_stats);
+    free(rxq_stats);
+    free(cpus);
+
+    TEST_END;
+}
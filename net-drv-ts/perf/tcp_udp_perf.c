@@ -60,6 +60,45 @@
  *                           - @c 1
  *                           - @c 2
  *                           - @c 4
+ * @param cpu_placement     How to choose CPUs for perf applications on
+ *                          IUT host with respect to IUT interface
+ *                          (applications on other hosts always use CPUs
+ *                          on NUMA node of their interface):
+ *                           - @c any (any free CPU)
+ *                           - @c local_numa (NUMA node of NIC)
+ *                           - @c remote_numa (another NUMA node)
+ *                           - @c irq_core (CPU handling NIC queue
+ *                             interrupts)
+ *                           - @c irq_sibling (hyperthread sibling of CPU
+ *                             handling NIC queue interrupts)
+ * @param irq_affinity      How to route interrupts of IUT interface to
+ *                          CPUs:
+ *                           - @c default (keep, e.g. made by irqbalance)
+ *                           - @c spread (one interrupt per core)
+ *                           - @c single (all interrupts on one core)
+ * @param rps_cpus          RPS CPUs of IUT interface Rx queues:
+ *                           - @c default (keep)
+ *                           - @c off (disable RPS)
+ *                           - @c spread (one core per queue)
+ *                           - @c all (all CPUs for every queue)
+ * @param rfs_flow_entries  Number of RFS flow entries
+ *                          (@b rps_sock_flow_entries, divided evenly
+ *                          between @b rps_flow_cnt of IUT interface
+ *                          Rx queues):
+ *                           - @c -1 (keep default)
+ *                           - @c 0 (disable RFS)
+ *                           - @c 32768
+ * @param xps_cpus          XPS CPUs of IUT interface Tx queues:
+ *                           - @c default (keep)
+ *                           - @c off (disable XPS)
+ *                           - @c spread (one core per queue)
+ * @param threaded_napi     Enable, disable threaded NAPI on IUT
+ *                          interface or preserve default. If enabled,
+ *                          NAPI kernel threads are bound to CPUs
+ *                          grabbed on NUMA node of IUT interface.
+ * @param big_tcp           Enable (GSO and GRO maximum size above 64KB),
+ *                          disable BIG TCP on IUT interface or preserve
+ *                          default.
  *
  * @type performance
  *
@@ -80,39 +119,15 @@
 #include "tapi_job_factory_rpc.h"
 #include "tapi_cfg_cpu.h"
 #include "tapi_cfg_if.h"
-#include "tapi_cfg_if_chan.h"
-#include "tapi_cfg_if_coalesce.h"
+#include "tapi_cfg_stats.h"
 #include "tapi_cfg_if_rss.h"
+#include "tapi_cfg_if_chan.h"
+#include "te_kvpair.h"
 
 #define TEST_BENCH_DURATION_SEC 6
 #define MAX_PERF_INSTS 32
 #define TEST_MAX_LINKS 4
-
-/**
- * The list of values allowed for parameter of type 'bool_with_default'
- */
-#define BOOL_WITH_DEFAULT_MAPPING_LIST  \
-    { "DEFAULT", TE_BOOL3_UNKNOWN },    \
-    { "FALSE",   TE_BOOL3_FALSE },      \
-    { "TRUE",    TE_BOOL3_TRUE }
-
-/**
- * Get the value of parameter of type 'bool_with_default'
- *
- * @param var_name_  Name of the variable used to get the value of
- *                   "var_name_" parameter of type 'bool_with_default' (OUT)
- */
-#define TEST_GET_BOOL_WITH_DEFAULT(var_name_) \
-    TEST_GET_ENUM_PARAM(var_name_, BOOL_WITH_DEFAULT_MAPPING_LIST)
-
-static void
-test_set_if_feature(const char *ta, const char *if_name,
-                    const char *feature_name, te_bool3 value)
-{
-    if (value != TE_BOOL3_UNKNOWN)
-        net_drv_set_if_feature(ta, if_name, feature_name,
-                               value == TE_BOOL3_FALSE ? 0 : 1);
-}
+#define TEST_MAX_NAPI_CPUS 64
 
 static void
 init_perf_insts(tapi_perf_server **servers, tapi_perf_client **clients)
@@ -141,11 +156,15 @@ destroy_perf_insts(tapi_perf_server **perf_server,
 
 static void
 perf_summary_throughput_mi_log(const double server_throughput,
-                               const double client_throughput)
+                               const double client_throughput,
+                               const te_kvpair_h *keys)
 {
     te_mi_logger *logger;
+    te_kvpair *kv;
 
     CHECK_RC(te_mi_logger_meas_create("summary throughput", &logger));
+    TAILQ_FOREACH(kv, keys, links)
+        te_mi_logger_add_meas_key(logger, NULL, kv->key, "%s", kv->value);
 
     te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
             TE_MI_MEAS(THROUGHPUT,
@@ -160,6 +179,191 @@ perf_summary_throughput_mi_log(const double server_throughput,
     te_mi_logger_destroy(logger);
 }
 
+/**
+ * Grab a CPU for a perf application.
+ *
+ * @param rpcs          RPC server on the host where application runs.
+ * @param iut_rpcs      RPC server on IUT.
+ * @param if_name       Interface used by the application.
+ * @param placement     CPU placement to use on IUT host.
+ * @param cpu_id        Where to save grabbed CPU.
+ *
+ * @return Status code.
+ */
+static te_errno
+grab_perf_cpu(rcf_rpc_server *rpcs, rcf_rpc_server *iut_rpcs,
+              const char *if_name, net_drv_cpu_placement placement,
+              tapi_cpu_index_t *cpu_id)
+{
+    te_errno rc;
+
+    if (strcmp(rpcs->ta, iut_rpcs->ta) != 0)
+        placement = NET_DRV_CPU_PLACEMENT_LOCAL_NUMA;
+
+    rc = net_drv_perf_cpu_grab(rpcs, if_name, placement, cpu_id);
+    if (rc == 0)
+    {
+        RING("CPU %lu (NUMA node %lu) is grabbed on %s for traffic "
+             "over %s", cpu_id->thread_id, cpu_id->node_id, rpcs->ta,
+             if_name);
+    }
+
+    return rc;
+}
+
+/**
+ * Bind threaded NAPI kernel threads of an IUT interface to CPUs
+ * grabbed on NUMA node of the interface. As many CPUs as there are
+ * threads are grabbed if possible, otherwise threads share grabbed
+ * CPUs.
+ *
+ * @param iut_rpcs      RPC server on IUT.
+ * @param if_name       IUT interface name.
+ */
+static void
+pin_napi_threads(rcf_rpc_server *iut_rpcs, const char *if_name)
+{
+    int cpus[TEST_MAX_NAPI_CPUS];
+    unsigned int n_cpus = 0;
+    tapi_cpu_index_t cpu_id;
+    int n_threads;
+    te_errno rc;
+
+    n_threads = rpc_net_drv_napi_threads(iut_rpcs, if_name, NULL, 0, NULL);
+    if (n_threads == 0)
+        TEST_VERDICT("No threaded NAPI kernel threads found for IUT "
+                     "interface");
+
+    while (n_cpus < (unsigned int)n_threads &&
+           n_cpus < TE_ARRAY_LEN(cpus))
+    {
+        rc = net_drv_perf_cpu_grab(iut_rpcs, if_name,
+                                   NET_DRV_CPU_PLACEMENT_LOCAL_NUMA,
+                                   &cpu_id);
+        if (rc == TE_RC(TE_TAPI, TE_ENOENT))
+            break;
+        CHECK_RC(rc);
+
+        cpus[n_cpus++] = cpu_id.thread_id;
+    }
+
+    if (n_cpus == 0)
+        TEST_SKIP("No CPUs are available for NAPI threads");
+
+    RING("%d NAPI threads of %s are bound to %u CPUs", n_threads,
+         if_name, n_cpus);
+    rpc_net_drv_napi_threads(iut_rpcs, if_name, cpus, n_cpus, NULL);
+}
+
+/**
+ * Report CPU usage of every threaded NAPI kernel thread.
+ *
+ * @param logger        MI logger.
+ * @param if_name       Interface name.
+ * @param before        Threads before the benchmark.
+ * @param n_before      Number of elements in @p before.
+ * @param after         Threads after the benchmark.
+ * @param n_after       Number of elements in @p after.
+ */
+static void
+napi_threads_mi_log(te_mi_logger *logger, const char *if_name,
+                    const net_drv_napi_thread *before, int n_before,
+                    const net_drv_napi_thread *after, int n_after)
+{
+    te_string name = TE_STRING_INIT;
+    double util;
+    int i;
+    int j;
+
+    for (i = 0; i < n_after; i++)
+    {
+        for (j = 0; j < n_before; j++)
+        {
+            if (before[j].pid == after[i].pid)
+                break;
+        }
+        if (j == n_before || after[i].ts <= before[j].ts)
+            continue;
+
+        /*
+         * Snapshots are taken some time before the benchmark starts and
+         * after it finishes, so CPU time is divided by the real interval
+         * between them.
+         */
+        util = (double)(after[i].cpu_time - before[j].cpu_time) * 100 /
+               (after[i].ts - before[j].ts);
+
+        te_string_reset(&name);
+        te_string_append(&name, "napi/%s-%u CPU", if_name,
+                         after[i].napi_id);
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_CPU,
+                              te_string_value(&name),
+                              TE_MI_MEAS_AGGR_SINGLE, util,
+                              TE_MI_MEAS_MULTIPLIER_PLAIN);
+        RING("NAPI thread %d (%s) used %.1f%% of CPU %d", after[i].pid,
+             te_string_value(&name), util, after[i].cpu);
+    }
+
+    te_string_free(&name);
+}
+
+/**
+ * Get number of packets received and sent over a set of interfaces.
+ *
+ * @param ta        Test Agent name.
+ * @param ifs       Interfaces.
+ * @param n_ifs     Number of interfaces.
+ *
+ * @return Number of packets.
+ */
+static uint64_t
+get_if_packets(const char *ta, const struct if_nameindex **ifs,
+               unsigned int n_ifs)
+{
+    tapi_cfg_if_stats stats;
+    uint64_t packets = 0;
+    unsigned int i;
+
+    for (i = 0; i < n_ifs; i++)
+    {
+        CHECK_RC(tapi_cfg_stats_if_stats_get(ta, ifs[i]->if_name, &stats));
+        packets += stats.in_ucast_pkts + stats.in_nucast_pkts +
+                   stats.out_ucast_pkts + stats.out_nucast_pkts;
+    }
+
+    return packets;
+}
+
+/**
+ * Get per-queue counters of IUT interfaces. If they cannot be obtained
+ * for an interface, its counters vector is left empty.
+ *
+ * @param factory   Job factory on IUT.
+ * @param ifs       IUT interfaces.
+ * @param n_ifs     Number of interfaces.
+ * @param queues    Where to save counters of every interface.
+ */
+static void
+get_queue_stats(tapi_job_factory_t *factory,
+                const struct if_nameindex **ifs, unsigned int n_ifs,
+                te_vec *queues)
+{
+    unsigned int i;
+    te_errno rc;
+
+    for (i = 0; i < n_ifs; i++)
+    {
+        rc = net_drv_perf_queue_stats_get(factory, ifs[i]->if_name,
+                                          &queues[i]);
+        if (rc != 0)
+        {
+            WARN("Failed to get per-queue statistics of %s: %r",
+                 ifs[i]->if_name, rc);
+            te_vec_reset(&queues[i]);
+        }
+    }
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -179,6 +383,23 @@ main(int argc, char *argv[])
     int                                     rx_ring;
     int                                     tx_ring;
     int                                     channels;
+    net_drv_cpu_placement                   cpu_placement;
+    net_drv_cpu_map                         irq_affinity;
+    net_drv_cpu_map                         rps_cpus;
+    int                                     rfs_flow_entries;
+    net_drv_cpu_map                         xps_cpus;
+    te_bool3                                threaded_napi;
+    te_bool3                                big_tcp;
+    net_drv_gso_limits                      gso_limits[TEST_MAX_LINKS];
+    te_bool                                 gso_limits_set[TEST_MAX_LINKS] =
+                                                {};
+    net_drv_napi_thread                    *napi_before[TEST_MAX_LINKS] = {};
+    net_drv_napi_thread                    *napi_after[TEST_MAX_LINKS] = {};
+    int                                     n_napi_before[TEST_MAX_LINKS];
+    int                                     n_napi_after[TEST_MAX_LINKS];
+    te_vec                                  iut_saved =
+                                                NET_DRV_SYS_SETTINGS_INIT;
+    te_kvpair_h                             summary_keys;
 
     rcf_rpc_server                         *server_rpcs = NULL;
     rcf_rpc_server                         *client_rpcs = NULL;
@@ -204,6 +425,29 @@ main(int argc, char *argv[])
     tapi_perf_report                        perf_clients_report[MAX_PERF_INSTS];
     double                                  bits_per_second_server = 0;
     double                                  bits_per_second_client = 0;
+    te_vec                                  server_series =
+                                                TE_VEC_INIT(double);
+    te_vec                                  client_series =
+                                                TE_VEC_INIT(double);
+    te_mi_logger                           *logger = NULL;
+    net_drv_cpu_stat                        server_cpu_before =
+                                                NET_DRV_CPU_STAT_INIT;
+    net_drv_cpu_stat                        server_cpu_after =
+                                                NET_DRV_CPU_STAT_INIT;
+    net_drv_cpu_stat                        client_cpu_before =
+                                                NET_DRV_CPU_STAT_INIT;
+    net_drv_cpu_stat                        client_cpu_after =
+                                                NET_DRV_CPU_STAT_INIT;
+    uint64_t                                server_packets;
+    uint64_t                                client_packets;
+    te_mi_logger                           *cpu_logger = NULL;
+    tapi_job_factory_t                     *iut_factory = NULL;
+    te_vec                                  queues_before[TEST_MAX_LINKS];
+    te_vec                                  queues_after[TEST_MAX_LINKS];
+    te_mi_logger                           *queues_logger = NULL;
+    int                                     rx_queues;
+    int                                     tx_queues;
+    int                                     tx_chans;
 
     tapi_job_factory_t                     *client_factory = NULL;
     tapi_job_factory_t                     *server_factory = NULL;
@@ -221,6 +465,12 @@ main(int argc, char *argv[])
     int cpu_id_val;
 
     init_perf_insts(perf_servers, perf_clients);
+    te_kvpair_init(&summary_keys);
+    for (i = 0; i < TEST_MAX_LINKS; i++)
+    {
+        queues_before[i] = (te_vec)TE_VEC_INIT(net_drv_queue_cnt);
+        queues_after[i] = (te_vec)TE_VEC_INIT(net_drv_queue_cnt);
+    }
 
     TEST_START;
     TEST_GET_PCO(iut_rpcs);
@@ -236,6 +486,13 @@ main(int argc, char *argv[])
     TEST_GET_INT_PARAM(rx_ring);
     TEST_GET_INT_PARAM(tx_ring);
     TEST_GET_INT_PARAM(channels);
+    TEST_GET_CPU_PLACEMENT(cpu_placement);
+    TEST_GET_CPU_MAP(irq_affinity);
+    TEST_GET_CPU_MAP(rps_cpus);
+    TEST_GET_INT_PARAM(rfs_flow_entries);
+    TEST_GET_CPU_MAP(xps_cpus);
+    TEST_GET_BOOL_WITH_DEFAULT(threaded_napi);
+    TEST_GET_BOOL_WITH_DEFAULT(big_tcp);
     TEST_GET_PCO(server_rpcs);
     TEST_GET_PCO(client_rpcs);
     TEST_GET_PERF_BENCH(perf_bench);
@@ -289,158 +546,57 @@ main(int argc, char *argv[])
         const struct if_nameindex *iut_if = iut_ifs[i];
 
         TEST_STEP("Configure Rx checksum offload on IUT interface if specified");
-        test_set_if_feature(iut_rpcs->ta, iut_if->if_name, "rx-checksum", rx_csum);
+        net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                    "rx-checksum", rx_csum);
 
         TEST_STEP("Configure GRO on IUT interface if specified");
-        test_set_if_feature(iut_rpcs->ta, iut_if->if_name, "rx-gro", rx_gro);
+        net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                    "rx-gro", rx_gro);
 
         TEST_STEP("Configure HW VLAN stripping on IUT interface if specified");
-        test_set_if_feature(iut_rpcs->ta, iut_if->if_name, "rx-vlan-hw-parse",
-                            rx_vlan_strip);
+        net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                    "rx-vlan-hw-parse", rx_vlan_strip);
 
         TEST_STEP("Configure Tx checksum offload on IUT interface if specified");
-        tx_csum_feature = (family == AF_INET) ?
-            "tx-checksum-ipv4" : "tx-checksum-ipv6";
-        if (!net_drv_req_if_feature_configurable(iut_rpcs->ta, iut_if->if_name,
-                                                 tx_csum_feature))
-            tx_csum_feature = "tx-checksum-ip-generic";
-        test_set_if_feature(iut_rpcs->ta, iut_if->if_name,
-                            tx_csum_feature, tx_csum);
+        tx_csum_feature = net_drv_perf_tx_csum_feature(iut_rpcs->ta,
+                                                       iut_if->if_name,
+                                                       family);
+        net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                    tx_csum_feature, tx_csum);
 
         TEST_STEP("Configure GSO offload on IUT interface if specified");
-        test_set_if_feature(iut_rpcs->ta, iut_if->if_name,
-                            "tx-gso-partial", tx_gso);
+        net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                    "tx-gso-partial", tx_gso);
 
         TEST_STEP("Configure TSO offload on IUT interface if specified");
-        test_set_if_feature(iut_rpcs->ta, iut_if->if_name,
-                            (family == AF_INET) ?
-                            "tx-tcp-segmentation" : "tx-tcp6-segmentation",
-                            tso);
+        net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                    net_drv_perf_tso_feature(family), tso);
 
         TEST_STEP("Configure HW VLAN insertion on IUT interface if specified");
-        test_set_if_feature(iut_rpcs->ta, iut_if->if_name, "tx-vlan-hw-insert",
-                            tx_vlan_insert);
+        net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                    "tx-vlan-hw-insert", tx_vlan_insert);
 
         TEST_STEP("If @p rx_coalesce_usecs or @p rx_max_coalesced_frames is not "
                   "-1, configure Rx coalesce on IUT interface.");
-        if (rx_coalesce_usecs != -1 || rx_max_coalesced_frames != -1)
-        {
-            TEST_SUBSTEP("Disable @b use_adaptive_rx_coalesce on IUT interface.");
-
-            rc = tapi_cfg_if_coalesce_set(iut_rpcs->ta, iut_if->if_name,
-                                          "use_adaptive_rx_coalesce", 0);
-            if (rc != 0)
-                TEST_VERDICT("Failed to set use_adaptive_rx_coalesce, rc=%r", rc);
-
-            if (rx_coalesce_usecs != -1)
-            {
-                TEST_SUBSTEP("If @p rx_coalesce_usecs is not -1, "
-                             "configure it IUT interface.");
-                CHECK_RC(tapi_cfg_if_coalesce_set_local(iut_rpcs->ta,
-                                                        iut_if->if_name,
-                                                        "rx_coalesce_usecs",
-                                                        rx_coalesce_usecs));
-            }
-            if (rx_max_coalesced_frames != -1)
-            {
-                TEST_SUBSTEP("If @p rx_max_coalesced_frames is not -1, "
-                             "configure it IUT interface.");
-                CHECK_RC(tapi_cfg_if_coalesce_set_local(iut_rpcs->ta,
-                                                        iut_if->if_name,
-                                                        "rx_max_coalesced_frames",
-                                                        rx_max_coalesced_frames));
-            }
-
-            rc = tapi_cfg_if_coalesce_commit(iut_rpcs->ta, iut_if->if_name);
-            if (TE_RC_GET_ERROR(rc) == TE_EOPNOTSUPP)
-                TEST_SKIP("Requested Rx coalesce settings are not supported");
-            if (rc != 0)
-                TEST_VERDICT("Failed to set rx_coalesce_usecs, rc=%r", rc);
-        }
-
-        if (rx_ring != -1)
-        {
-            TEST_STEP("Set Rx ring size according to @p rx_ring on IUT interface.");
-            if (rx_ring == 0)
-                rc = tapi_cfg_if_set_ring_size_to_max(iut_rpcs->ta,
-                                                      iut_if->if_name,
-                                                      TRUE, NULL);
-            else
-                rc = tapi_cfg_if_set_ring_size(iut_rpcs->ta, iut_if->if_name,
-                                               TRUE, rx_ring);
-
-            if (TE_RC_GET_ERROR(rc) == TE_EOPNOTSUPP)
-                TEST_SKIP("Cannot change Rx ring size");
-            else if (rc != 0)
-                TEST_VERDICT("Failed to set Rx ring size: %r", rc);
-        }
-
-        if (tx_ring != -1)
-        {
-            TEST_STEP("Set Tx ring size according to @p tx_ring on IUT interface.");
-            if (tx_ring == 0)
-                rc = tapi_cfg_if_set_ring_size_to_max(iut_rpcs->ta,
-                                                      iut_if->if_name,
-                                                      false, NULL);
-            else
-                rc = tapi_cfg_if_set_ring_size(iut_rpcs->ta, iut_if->if_name,
-                                               false, tx_ring);
-
-            if (TE_RC_GET_ERROR(rc) == TE_EOPNOTSUPP)
-                TEST_SKIP("Cannot change Tx ring size");
-            else if (rc != 0)
-                TEST_VERDICT("Failed to set Tx ring size: %r", rc);
-        }
-
-        if (channels != -1)
-        {
-            int rx_queues;
-
-            TEST_STEP("Set number of combined channels on IUT interface "
-                      "according to @p channels.");
-
-            TEST_SUBSTEP("Get current number of Rx queues on IUT interface");
-            CHECK_RC(tapi_cfg_if_rss_rx_queues_get(iut_rpcs->ta,
-                                                   iut_if->if_name,
-                                                   &rx_queues));
-
-            TEST_SUBSTEP("If current number of Rx queues is more than number "
-                         "channels to be set, update RSS indirection table to "
-                         "use only Rx queues which remain after channels set.");
-            if (rx_queues > channels)
-            {
-                CHECK_RC(tapi_cfg_if_rss_fill_indir_table(iut_rpcs->ta,
-                                                          iut_if->if_name,
-                                                          0, 0, channels - 1));
-                CHECK_RC(tapi_cfg_if_rss_hash_indir_commit(iut_rpcs->ta,
-                                                           iut_if->if_name, 0));
-            }
-
-            TEST_SUBSTEP("Apply number of combined channels on IUT interface "
-                         "according to @p channels.");
-            rc = tapi_cfg_if_chan_cur_set(iut_rpcs->ta, iut_if->if_name,
-                                          TAPI_CFG_IF_CHAN_COMBINED, channels);
-            if (TE_RC_GET_ERROR(rc) == TE_EOPNOTSUPP)
-                TEST_SKIP("Cannot set number of combined channels");
-            else if (rc != 0)
-                TEST_VERDICT("Failed to set number of combined channels: %r", rc);
-
-            TEST_SUBSTEP("If previously used number of Rx queues is less than "
-                         "number of channels, update RSS indirection table to "
-                         "use all Rx queues available after channels set.");
-            if (rx_queues < channels)
-            {
-                CHECK_RC(tapi_cfg_if_rss_fill_indir_table(iut_rpcs->ta,
-                                                          iut_if->if_name,
-                                                          0, 0, channels - 1));
-                CHECK_RC(tapi_cfg_if_rss_hash_indir_commit(iut_rpcs->ta,
-                                                           iut_if->if_name, 0));
-            }
-
-            TEST_SUBSTEP("Print RSS indirection table to be able to double-check.");
-            CHECK_RC(tapi_cfg_if_rss_print_indir_table(iut_rpcs->ta,
-                                                       iut_if->if_name, 0));
-        }
+        net_drv_perf_set_rx_coalesce(iut_rpcs->ta, iut_if->if_name,
+                                     rx_coalesce_usecs,
+                                     rx_max_coalesced_frames);
+
+        TEST_STEP("If @p rx_ring is not -1, set Rx ring size according "
+                  "to it on IUT interface.");
+        net_drv_perf_set_ring_size(iut_rpcs->ta, iut_if->if_name,
+                                   TRUE, rx_ring);
+
+        TEST_STEP("If @p tx_ring is not -1, set Tx ring size according "
+                  "to it on IUT interface.");
+        net_drv_perf_set_ring_size(iut_rpcs->ta, iut_if->if_name,
+                                   FALSE, tx_ring);
+
+        TEST_STEP("If @p channels is not -1, set number of combined "
+                  "channels on IUT interface according to it, updating "
+                  "RSS indirection table to use only available Rx "
+                  "queues.");
+        net_drv_perf_set_channels(iut_rpcs->ta, iut_if->if_name, channels);
     }
 
     for (i = 0; i < n_ports; i++)
@@ -472,6 +628,41 @@ main(int argc, char *argv[])
 
     CFG_WAIT_CHANGES;
 
+    for (i = 0; i < n_iut_ports; ++i)
+    {
+        const char *if_name = iut_ifs[i]->if_name;
+
+        TEST_STEP("If @p irq_affinity is not default, route interrupts "
+                  "of IUT interface to CPUs according to it.");
+        net_drv_perf_set_irq_affinity(iut_rpcs, if_name, irq_affinity,
+                                      &iut_saved);
+
+        TEST_STEP("If @p rps_cpus is not default, set RPS CPUs of "
+                  "IUT interface Rx queues according to it.");
+        net_drv_perf_set_rps(iut_rpcs, if_name, rps_cpus, &iut_saved);
+
+        TEST_STEP("If @p rfs_flow_entries is not -1, configure RFS "
+                  "flow tables according to it.");
+        net_drv_perf_set_rfs(iut_rpcs, if_name, rfs_flow_entries,
+                             &iut_saved);
+
+        TEST_STEP("If @p xps_cpus is not default, set XPS CPUs of "
+                  "IUT interface Tx queues according to it.");
+        net_drv_perf_set_xps(iut_rpcs, if_name, xps_cpus, &iut_saved);
+
+        TEST_STEP("Enable or disable threaded NAPI on IUT interface "
+                  "according to @p threaded_napi if it is not default.");
+        net_drv_perf_set_threaded_napi(iut_rpcs, if_name, threaded_napi,
+                                       &iut_saved);
+
+        TEST_STEP("Enable or disable BIG TCP on IUT interface according "
+                  "to @p big_tcp if it is not default.");
+        gso_limits_set[i] = net_drv_perf_set_big_tcp(
+                                iut_rpcs, if_name,
+                                server_addrs[i < n_ports ? i : 0]->sa_family,
+                                big_tcp, &gso_limits[i]);
+    }
+
     TEST_STEP("Set default perf options");
     tapi_perf_opts_init(&perf_opts);
 
@@ -483,16 +674,20 @@ main(int argc, char *argv[])
     perf_opts.duration_sec = TEST_BENCH_DURATION_SEC;
     perf_opts.dual = dual_mode;
     /*
-     * To force server to print a report at the end of test even if it lost
-     * connection with client (iperf tool issue, Bug 9714).
+     * Interval reports are used to get throughput time series. Besides,
+     * they force server to print a report at the end of test even if
+     * it lost connection with client (iperf tool issue, Bug 9714).
      */
-    perf_opts.interval_sec = perf_opts.duration_sec;
+    perf_opts.interval_sec = NET_DRV_PERF_INTERVAL_SEC;
 
     TEST_STEP("Allocate server ports for perf applications");
     CHECK_RC(tapi_allocate_port_range(server_rpcs, server_ports,
                                       n_perf_insts * n_ports));
 
-    TEST_STEP("Start server and create client perf applications");
+    TEST_STEP("Start server and create client perf applications. "
+              "Bind every application to its own CPU chosen according "
+              "to @p cpu_placement if it runs on IUT host, or to a CPU "
+              "on NUMA node of its interface otherwise.");
     CHECK_RC(tapi_job_factory_rpc_create(server_rpcs, &server_factory));
     CHECK_RC(tapi_job_factory_rpc_create(client_rpcs, &client_factory));
 
@@ -501,7 +696,9 @@ main(int argc, char *argv[])
         const struct sockaddr *server_addr = server_addrs[i / n_perf_insts];
         const struct sockaddr *client_addr = client_addrs[i / n_perf_insts];
 
-        rc = tapi_cfg_cpu_grab_by_prop(server_rpcs->ta, NULL, &cpu_id);
+        rc = grab_perf_cpu(server_rpcs, iut_rpcs,
+                           server_ifs[i / n_perf_insts]->if_name,
+                           cpu_placement, &cpu_id);
         if (rc != 0 && rc == TE_RC(TE_TAPI, TE_ENOENT))
             TEST_SKIP("%d/%d CPUs are available for servers",
                       i, n_perf_insts * n_ports);
@@ -528,7 +725,9 @@ main(int argc, char *argv[])
 
         CHECK_RC(tapi_perf_server_start_unreliable(perf_servers[i]));
 
-        rc = tapi_cfg_cpu_grab_by_prop(client_rpcs->ta, NULL, &cpu_id);
+        rc = grab_perf_cpu(client_rpcs, iut_rpcs,
+                           client_ifs[i / n_perf_insts]->if_name,
+                           cpu_placement, &cpu_id);
         if (rc != 0 && rc == TE_RC(TE_TAPI, TE_ENOENT))
             TEST_SKIP("%d/%d CPUs are available for clients", i, n_perf_insts);
         CHECK_RC(rc);
@@ -542,9 +741,38 @@ main(int argc, char *argv[])
                                          exec_param));
     }
 
+    if (threaded_napi == TE_BOOL3_TRUE)
+    {
+        TEST_STEP("If @p threaded_napi is @c TRUE, bind NAPI kernel "
+                  "threads of IUT interfaces to CPUs grabbed on NUMA "
+                  "node of the interfaces.");
+        for (i = 0; i < n_iut_ports; i++)
+            pin_napi_threads(iut_rpcs, iut_ifs[i]->if_name);
+    }
+
     VSLEEP(1, "ensure all perf servers has started");
     CHECK_RC(tapi_env_stats_gather(&env));
 
+    TEST_STEP("Get CPU usage counters and number of packets passed "
+              "over test interfaces on server and client hosts, and "
+              "CPU time of threaded NAPI kernel threads on IUT.");
+    server_packets = get_if_packets(server_rpcs->ta, server_ifs, n_ports);
+    client_packets = get_if_packets(client_rpcs->ta, client_ifs, n_ports);
+    net_drv_perf_cpu_stat_get(server_rpcs, &server_cpu_before);
+    net_drv_perf_cpu_stat_get(client_rpcs, &client_cpu_before);
+    for (i = 0; i < n_iut_ports; i++)
+    {
+        n_napi_before[i] = rpc_net_drv_napi_threads(iut_rpcs,
+                                                    iut_ifs[i]->if_name,
+                                                    NULL, 0,
+                                                    &napi_before[i]);
+    }
+
+    TEST_STEP("Get per-queue packets and bytes counters of IUT "
+              "interfaces with @b ethtool @b -S.");
+    CHECK_RC(tapi_job_factory_rpc_create(iut_rpcs, &iut_factory));
+    get_queue_stats(iut_factory, iut_ifs, n_iut_ports, queues_before);
+
     TEST_STEP("Start perf clients");
     for (i = 0; i < n_perf_insts * n_ports; i++)
         CHECK_RC(tapi_perf_client_start(perf_clients[i]));
@@ -555,12 +783,36 @@ main(int argc, char *argv[])
                                        TAPI_PERF_TIMEOUT_DEFAULT));
     }
 
+    TEST_STEP("Get CPU usage counters on server and client hosts and "
+              "CPU time of NAPI threads on IUT again once the benchmark "
+              "is finished.");
+    net_drv_perf_cpu_stat_get(server_rpcs, &server_cpu_after);
+    net_drv_perf_cpu_stat_get(client_rpcs, &client_cpu_after);
+    for (i = 0; i < n_iut_ports; i++)
+    {
+        n_napi_after[i] = rpc_net_drv_napi_threads(iut_rpcs,
+                                                   iut_ifs[i]->if_name,
+                                                   NULL, 0,
+                                                   &napi_after[i]);
+    }
+
+    TEST_STEP("If @p irq_affinity is not default, check that interrupts "
+              "of IUT interface are still routed to the configured CPUs "
+              "(i.e. irqbalance did not move them during the benchmark).");
+    for (i = 0; i < n_iut_ports; i++)
+    {
+        net_drv_perf_check_irq_affinity(iut_rpcs, iut_ifs[i]->if_name,
+                                        irq_affinity);
+    }
+
     /*
      * Time is relative and goes differently on different hosts.
      * Sometimes we need to wait for a few moments until report is ready.
      */
     VSLEEP(2, "ensure perf server has printed its report");
 
+    get_queue_stats(iut_factory, iut_ifs, n_iut_ports, queues_after);
+
     for (i = 0; i < n_perf_insts * n_ports; i++)
     {
         CHECK_RC(tapi_perf_server_get_dump_check_report(perf_servers[i],
@@ -575,27 +827,155 @@ main(int argc, char *argv[])
 
         bits_per_second_server += perf_servers_report[i].bits_per_second;
         bits_per_second_client += perf_clients_report[i].bits_per_second;
+
+        CHECK_RC(net_drv_perf_add_intervals(perf_bench,
+                                te_string_value(&perf_servers[i]->app.stdout),
+                                perf_opts.interval_sec, &server_series));
+        CHECK_RC(net_drv_perf_add_intervals(perf_bench,
+                                te_string_value(&perf_clients[i]->app.stdout),
+                                perf_opts.interval_sec, &client_series));
     }
 
+    TEST_STEP("Report per-interval throughput summed over all perf "
+              "instances together with its minimum, mean and standard "
+              "deviation to reveal throughput drops and instability.");
+    CHECK_RC(te_mi_logger_meas_create("interval throughput", &logger));
+    net_drv_perf_series_mi_log(logger, "Server", &server_series);
+    net_drv_perf_series_mi_log(logger, "Client", &client_series);
+    CHECK_RC(te_mi_logger_flush(logger));
+
     TEST_ARTIFACT("Server throughput: %.2f Mbps",
                   TE_UNITS_DEC_U2M(bits_per_second_server));
 
     TEST_ARTIFACT("Client throughput: %.2f Mbps",
                   TE_UNITS_DEC_U2M(bits_per_second_client));
 
+    CHECK_RC(te_kvpair_add(&summary_keys, "CPU placement", "%s",
+                           TEST_STRING_PARAM(cpu_placement)));
+    CHECK_RC(te_kvpair_add(&summary_keys, "IRQ affinity", "%s",
+                           TEST_STRING_PARAM(irq_affinity)));
+    CHECK_RC(te_kvpair_add(&summary_keys, "RPS", "%s",
+                           TEST_STRING_PARAM(rps_cpus)));
+    CHECK_RC(te_kvpair_add(&summary_keys, "RFS flow entries", "%d",
+                           rfs_flow_entries));
+    CHECK_RC(te_kvpair_add(&summary_keys, "XPS", "%s",
+                           TEST_STRING_PARAM(xps_cpus)));
+    CHECK_RC(te_kvpair_add(&summary_keys, "Threaded NAPI", "%s",
+                           TEST_STRING_PARAM(threaded_napi)));
+    CHECK_RC(te_kvpair_add(&summary_keys, "BIG TCP", "%s",
+                           TEST_STRING_PARAM(big_tcp)));
     perf_summary_throughput_mi_log(bits_per_second_server,
-                                   bits_per_second_client);
+                                   bits_per_second_client,
+                                   &summary_keys);
+
+    TEST_STEP("Report CPU utilisation, share of softirqs in it and "
+              "CPU cycles spent per byte and per packet on server and "
+              "client hosts, and CPU usage of every threaded NAPI kernel "
+              "thread of IUT interfaces.");
+    server_packets = get_if_packets(server_rpcs->ta, server_ifs, n_ports) -
+                     server_packets;
+    client_packets = get_if_packets(client_rpcs->ta, client_ifs, n_ports) -
+                     client_packets;
+
+    CHECK_RC(te_mi_logger_meas_create("cpu usage", &cpu_logger));
+    net_drv_perf_cpu_usage_mi_log(cpu_logger, "Server",
+                                  &server_cpu_before, &server_cpu_after,
+                                  bits_per_second_server *
+                                  TEST_BENCH_DURATION_SEC / 8,
+                                  server_packets);
+    net_drv_perf_cpu_usage_mi_log(cpu_logger, "Client",
+                                  &client_cpu_before, &client_cpu_after,
+                                  bits_per_second_client *
+                                  TEST_BENCH_DURATION_SEC / 8,
+                                  client_packets);
+    for (i = 0; i < n_iut_ports; i++)
+    {
+        napi_threads_mi_log(cpu_logger, iut_ifs[i]->if_name,
+                            napi_before[i], n_napi_before[i],
+                            napi_after[i], n_napi_after[i]);
+    }
+    CHECK_RC(te_mi_logger_flush(cpu_logger));
+
+    TEST_STEP("Report per-queue packet and bit rates on IUT interfaces "
+              "and how evenly traffic is spread over queues in use "
+              "(maximum to mean ratio and Jain's fairness index).");
+    CHECK_RC(te_mi_logger_meas_create("queues distribution",
+                                      &queues_logger));
+    for (i = 0; i < n_iut_ports; i++)
+    {
+        rc = tapi_cfg_if_rss_rx_queues_get(iut_rpcs->ta,
+                                           iut_ifs[i]->if_name,
+                                           &rx_queues);
+        if (rc != 0)
+            rx_queues = 0;
+
+        /*
+         * Every combined channel and every Tx-only channel has
+         * its own Tx queue.
+         */
+        rc = tapi_cfg_if_chan_cur_get(iut_rpcs->ta, iut_ifs[i]->if_name,
+                                      TAPI_CFG_IF_CHAN_COMBINED,
+                                      &tx_queues);
+        if (rc == 0)
+        {
+            rc = tapi_cfg_if_chan_cur_get(iut_rpcs->ta,
+                                          iut_ifs[i]->if_name,
+                                          TAPI_CFG_IF_CHAN_TX, &tx_chans);
+        }
+        if (rc == 0)
+            tx_queues += tx_chans;
+        else
+            tx_queues = 0;
+
+        net_drv_perf_queue_stats_mi_log(queues_logger, iut_ifs[i]->if_name,
+                                        &queues_before[i],
+                                        &queues_after[i], rx_queues,
+                                        tx_queues,
+                                        TEST_BENCH_DURATION_SEC);
+    }
+    CHECK_RC(te_mi_logger_flush(queues_logger));
 
     TEST_SUCCESS;
 
 cleanup:
     destroy_perf_insts(perf_servers, perf_clients, n_perf_insts * n_ports);
+    te_vec_free(&server_series);
+    te_vec_free(&client_series);
+    te_mi_logger_destroy(logger);
+    te_mi_logger_destroy(cpu_logger);
+    net_drv_perf_cpu_stat_free(&server_cpu_before);
+    net_drv_perf_cpu_stat_free(&server_cpu_after);
+    net_drv_perf_cpu_stat_free(&client_cpu_before);
+    net_drv_perf_cpu_stat_free(&client_cpu_after);
     free(server_addr_str);
     free(client_addr_str);
     tapi_job_factory_destroy(client_factory);
     tapi_job_factory_destroy(server_factory);
+    tapi_job_factory_destroy(iut_factory);
+    te_mi_logger_destroy(queues_logger);
+    for (i = 0; i < TEST_MAX_LINKS; i++)
+    {
+        te_vec_free(&queues_before[i]);
+        te_vec_free(&queues_after[i]);
+        free(napi_before[i]);
+        free(napi_after[i]);
+    }
 
     CLEANUP_CHECK_RC(tapi_env_stats_gather_and_log_diff(&env));
+    if (iut_rpcs != NULL)
+        net_drv_perf_restore_sys(iut_rpcs, &iut_saved);
+    for (i = 0; i < n_iut_ports; i++)
+    {
+        if (gso_limits_set[i])
+        {
+            CLEANUP_CHECK_RC(net_drv_set_gso_limits(
+                    iut_rpcs, iut_ifs[i]->if_name,
+                    server_addrs[i < n_ports ? i : 0]->sa_family,
+                    gso_limits[i].gso_max_size,
+                    gso_limits[i].gro_max_size));
+        }
+    }
+    te_kvpair_fini(&summary_keys);
 
     TEST_END;
 }
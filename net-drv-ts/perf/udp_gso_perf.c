@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-udp_gso_perf UDP segmentation offload performance
+ * @ingroup perf
+ * @{
+ *
+ * @objective Measure packet rate and CPU usage of sending UDP
+ *            super-buffers with @c UDP_SEGMENT with UDP segmentation
+ *            offload enabled or disabled.
+ *
+ * @param env               Testing environment:
+ *                          - @ref env-peer2peer
+ *                          - @ref env-peer2peer_ipv6
+ * @param tx_udp_seg        Enable, disable UDP segmentation offload
+ *                          (@b tx-udp-segmentation) or preserve default
+ * @param gso_size          Size of UDP payload of a segment
+ * @param segs              Number of segments in a super-buffer
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/udp_gso_perf"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "te_units.h"
+
+/** How long to send data, in seconds */
+#define TEST_SEND_DURATION_SEC 6
+
+/**
+ * How long to wait for new data on Tester before stopping receiving,
+ * in milliseconds
+ */
+#define TEST_RECV_TIME2WAIT 1000
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+    te_bool3 tx_udp_seg;
+    unsigned int gso_size;
+    unsigned int segs;
+
+    te_mi_logger *logger = NULL;
+    net_drv_udp_gso_stats gso_stats;
+    net_drv_udp_gro_stats gro_stats;
+    double tx_pps;
+    double rx_pps;
+    double cpu_usage;
+    int64_t sent;
+    int64_t rc;
+    int iut_s = -1;
+    int tst_s = -1;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+    TEST_GET_BOOL_WITH_DEFAULT(tx_udp_seg);
+    TEST_GET_UINT_PARAM(gso_size);
+    TEST_GET_UINT_PARAM(segs);
+
+    TEST_STEP("Configure UDP segmentation offload on IUT interface if "
+              "specified.");
+    net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                "tx-udp-segmentation", tx_udp_seg);
+
+    CFG_WAIT_CHANGES;
+
+    TEST_STEP("Create a pair of connected UDP sockets on IUT and Tester.");
+    GEN_CONNECTION(iut_rpcs, tst_rpcs, RPC_SOCK_DGRAM, RPC_PROTO_DEF,
+                   iut_addr, tst_addr, &iut_s, &tst_s);
+
+    TEST_STEP("Start receiving data on Tester with @c UDP_GRO enabled "
+              "to reduce receiving overhead.");
+    tst_rpcs->op = RCF_RPC_CALL;
+    rpc_net_drv_recv_udp_gro(tst_rpcs, tst_s, TRUE, TEST_RECV_TIME2WAIT,
+                             NULL);
+
+    TEST_STEP("Send super-buffers of @p segs * @p gso_size bytes with "
+              "@c UDP_SEGMENT control message from IUT for a few "
+              "seconds.");
+    RPC_AWAIT_ERROR(iut_rpcs);
+    iut_rpcs->timeout = TE_SEC2MS(TEST_SEND_DURATION_SEC + 2);
+    sent = rpc_net_drv_send_udp_gso(iut_rpcs, iut_s, gso_size * segs,
+                                    gso_size,
+                                    TE_SEC2MS(TEST_SEND_DURATION_SEC), 0,
+                                    &gso_stats);
+
+    TEST_STEP("Wait until receiving data on Tester terminates.");
+    memset(&gro_stats, 0, sizeof(gro_stats));
+    RPC_AWAIT_ERROR(tst_rpcs);
+    tst_rpcs->timeout = TE_SEC2MS(TEST_SEND_DURATION_SEC + 5);
+    rc = rpc_net_drv_recv_udp_gro(tst_rpcs, tst_s, TRUE,
+                                  TEST_RECV_TIME2WAIT, &gro_stats);
+    if (rc < 0)
+    {
+        TEST_VERDICT("Receiving data on Tester failed with error "
+                     RPC_ERROR_FMT, RPC_ERROR_ARGS(tst_rpcs));
+    }
+
+    if (sent < 0)
+    {
+        if (RPC_ERRNO(iut_rpcs) == RPC_EOPNOTSUPP)
+            TEST_SKIP("UDP_SEGMENT is not supported on IUT");
+
+        TEST_VERDICT("Sending with UDP_SEGMENT failed on IUT with error "
+                     RPC_ERROR_FMT, RPC_ERROR_ARGS(iut_rpcs));
+    }
+
+    TEST_STEP("Report rate of sent and received UDP datagrams and CPU "
+              "usage of IUT sending thread.");
+    tx_pps = (double)gso_stats.segs / TEST_SEND_DURATION_SEC;
+    rx_pps = (double)gro_stats.segs / TEST_SEND_DURATION_SEC;
+    cpu_usage = (double)gso_stats.cpu_time * 100 /
+                (TEST_SEND_DURATION_SEC * 1e9);
+
+    TEST_ARTIFACT("Sent %.3f Mpps, received %.3f Mpps, CPU usage %.1f%%",
+                  TE_UNITS_DEC_U2M(tx_pps), TE_UNITS_DEC_U2M(rx_pps),
+                  cpu_usage);
+
+    CHECK_RC(te_mi_logger_meas_create("udp_gso_perf", &logger));
+    te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+            TE_MI_MEAS(PPS, "Sent", SINGLE, tx_pps, PLAIN),
+            TE_MI_MEAS(PPS, "Received", SINGLE, rx_pps, PLAIN),
+            TE_MI_MEAS(CPU, "Sender", SINGLE, cpu_usage, PLAIN)));
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    TEST_STEP("Check that some data was received on Tester.");
+    if (gro_stats.segs == 0)
+        TEST_VERDICT("No data was received on Tester");
+    if (gro_stats.segs < gso_stats.segs)
+    {
+        RING("%" TE_PRINTF_64 "u of %" TE_PRINTF_64 "u datagrams were "
+             "lost", gso_stats.segs - gro_stats.segs, gso_stats.segs);
+    }
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
+    CLEANUP_RPC_CLOSE(tst_rpcs, tst_s);
+    te_mi_logger_destroy(logger);
+
+    TEST_END;
+}
@@ -0,0 +1,213 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-udp_pps Small packets receive rate
+ * @ingroup perf
+ * @{
+ *
+ * @objective Measure sustained rate (in Mpps) and loss of UDP packets
+ *            of a given frame size received on IUT.
+ *
+ * @param env               Testing environment:
+ *                          - @ref env-peer2peer
+ *                          - @ref env-peer2peer_ipv6
+ * @param frame_size        Size of Ethernet frame including FCS:
+ *                          - @c 64
+ *                          - @c 128
+ *                          - @c 256
+ *                          - @c 512
+ *                          - @c 1024
+ *                          - @c 1518
+ *                          - @c 9018 (jumbo)
+ * @param n_threads         Number of sender threads on Tester (every
+ *                          thread sends its own flow)
+ * @param burst             Number of packets passed to a single
+ *                          @b sendmmsg() call
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/udp_pps"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "te_units.h"
+#include "tapi_cfg_stats.h"
+#include "tapi_bpf_rxq_stats.h"
+
+/** How long to send packets, in seconds */
+#define TEST_SEND_DURATION_SEC 6
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct if_nameindex *tst_if = NULL;
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+    unsigned int frame_size;
+    unsigned int n_threads;
+    unsigned int burst;
+
+    struct sockaddr_storage src_addr;
+    te_mi_logger *logger = NULL;
+    net_drv_send_thread_stats *stats = NULL;
+    tapi_bpf_rxq_stats *rxq_stats = NULL;
+    unsigned int rxq_stats_count = 0;
+    unsigned int bpf_id = 0;
+    te_bool bpf_loaded = FALSE;
+    tapi_cfg_if_stats tst_stats_before;
+    tapi_cfg_if_stats tst_stats_after;
+    int *cpus = NULL;
+    unsigned int pkt_size;
+    int64_t generated;
+    uint64_t sent;
+    uint64_t received = 0;
+    double tx_pps;
+    double rx_pps;
+    double loss = 0;
+    unsigned int i;
+    int iut_s = -1;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_IF(tst_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+    TEST_GET_UINT_PARAM(frame_size);
+    TEST_GET_UINT_PARAM(n_threads);
+    TEST_GET_UINT_PARAM(burst);
+
+    pkt_size = net_drv_perf_udp_payload_len(frame_size,
+                                            iut_addr->sa_family);
+
+    TEST_STEP("If frames of @p frame_size bytes do not fit current MTU, "
+              "increase it on IUT and Tester.");
+    net_drv_perf_ensure_mtu(iut_rpcs->ta, iut_if->if_name, frame_size);
+    net_drv_perf_ensure_mtu(tst_rpcs->ta, tst_if->if_name, frame_size);
+
+    CFG_WAIT_CHANGES;
+
+    TEST_STEP("Create UDP socket on IUT bound to @p iut_addr so that "
+              "received packets are delivered to it.");
+    iut_s = rpc_socket(iut_rpcs, rpc_socket_domain_by_addr(iut_addr),
+                       RPC_SOCK_DGRAM, RPC_PROTO_DEF);
+    rpc_bind(iut_rpcs, iut_s, iut_addr);
+
+    TEST_STEP("Link @b rxq_stats XDP program to IUT interface and "
+              "configure it to count UDP packets sent from @p tst_addr "
+              "to @p iut_addr (source port is not checked since every "
+              "sender thread uses its own one).");
+    CHECK_RC(tapi_bpf_rxq_stats_init(iut_rpcs->ta, iut_if->if_name,
+                                     "rss_bpf", &bpf_id));
+    bpf_loaded = TRUE;
+
+    tapi_sockaddr_clone_exact(tst_addr, &src_addr);
+    te_sockaddr_set_port(SA(&src_addr), 0);
+
+    CHECK_RC(tapi_bpf_rxq_stats_reset(iut_rpcs->ta, bpf_id));
+    CHECK_RC(tapi_bpf_rxq_stats_set_params(
+                  iut_rpcs->ta, bpf_id, iut_addr->sa_family,
+                  SA(&src_addr), iut_addr, IPPROTO_UDP, TRUE));
+    CHECK_RC(tapi_bpf_rxq_stats_clear(iut_rpcs->ta, bpf_id));
+
+    TEST_STEP("Get statistics of Tester interface.");
+    NET_DRV_WAIT_IF_STATS_UPDATE;
+    CHECK_RC(tapi_cfg_stats_if_stats_get(tst_rpcs->ta, tst_if->if_name,
+                                         &tst_stats_before));
+
+    TEST_STEP("Send UDP packets fitting in @p frame_size bytes frames "
+              "from Tester to IUT at the maximum rate for a few seconds "
+              "from @p n_threads threads, passing @p burst packets to "
+              "every @b sendmmsg() call.");
+    cpus = tapi_calloc(n_threads, sizeof(*cpus));
+    for (i = 0; i < n_threads; i++)
+        cpus[i] = -1;
+
+    tst_rpcs->timeout = TE_SEC2MS(TEST_SEND_DURATION_SEC + 5);
+    generated = rpc_net_drv_send_pkts_mt(tst_rpcs, tst_addr, iut_addr,
+                                         cpus, n_threads, pkt_size, burst,
+                                         0,
+                                         TE_SEC2MS(TEST_SEND_DURATION_SEC),
+                                         &stats);
+    for (i = 0; i < n_threads; i++)
+    {
+        RING("Thread %u: %" TE_PRINTF_64 "u packets sent, "
+             "%" TE_PRINTF_64 "u sendmmsg() failures", i,
+             stats[i].pkts, stats[i].errors);
+    }
+
+    TEST_STEP("Wait for a while and get statistics of Tester interface "
+              "again to compute number of packets sent from Tester. "
+              "Get number of test packets received on IUT from "
+              "@b rxq_stats XDP program.");
+    NET_DRV_WAIT_IF_STATS_UPDATE;
+    CHECK_RC(tapi_cfg_stats_if_stats_get(tst_rpcs->ta, tst_if->if_name,
+                                         &tst_stats_after));
+
+    sent = tst_stats_after.out_ucast_pkts - tst_stats_before.out_ucast_pkts;
+
+    CHECK_RC(tapi_bpf_rxq_stats_read(iut_rpcs->ta, bpf_id, &rxq_stats,
+                                     &rxq_stats_count));
+    tapi_bpf_rxq_stats_print(NULL, rxq_stats, rxq_stats_count);
+    for (i = 0; i < rxq_stats_count; i++)
+        received += rxq_stats[i].pkts;
+
+    RING("%" TE_PRINTF_64 "d packets were passed to sendmmsg(), "
+         "%" TE_PRINTF_64 "u were sent by Tester interface, "
+         "%" TE_PRINTF_64 "u were received by IUT interface",
+         generated, sent, received);
+
+    if (received == 0)
+        TEST_VERDICT("No packets were received on IUT");
+
+    TEST_STEP("Report sustained rate of sent and received packets and "
+              "loss.");
+    tx_pps = (double)sent / TEST_SEND_DURATION_SEC;
+    rx_pps = (double)received / TEST_SEND_DURATION_SEC;
+    if (sent > received)
+        loss = (double)(sent - received) * 100 / sent;
+
+    TEST_ARTIFACT("Frame size %u: sent %.3f Mpps, received %.3f Mpps, "
+                  "loss %.2f%%", frame_size, TE_UNITS_DEC_U2M(tx_pps),
+                  TE_UNITS_DEC_U2M(rx_pps), loss);
+
+    CHECK_RC(te_mi_logger_meas_create("udp_pps", &logger));
+    te_mi_logger_add_meas_key(logger, NULL, "Frame size", "%u",
+                              frame_size);
+    te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+            TE_MI_MEAS(PPS, "Sent", SINGLE, tx_pps, PLAIN),
+            TE_MI_MEAS(PPS, "Received", SINGLE, rx_pps, PLAIN),
+            TE_MI_MEAS(THROUGHPUT, "Received", SINGLE,
+                       rx_pps * frame_size * 8, PLAIN)));
+    te_mi_logger_add_comment(logger, NULL, "Loss", "%.2f%%", loss);
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    if (bpf_loaded)
+    {
+        CLEANUP_CHECK_RC(tapi_bpf_rxq_stats_fini(iut_rpcs->ta,
+                                                 iut_if->if_name, bpf_id));
+    }
+
+    CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
+    te_mi_logger_destroy(logger);
+    free(stats);
+    free(rxq_stats);
+    free(cpus);
+
+    TEST_END;
+}
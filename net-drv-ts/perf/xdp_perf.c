@@ -0,0 +1,306 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-xdp_perf XDP fast path packet rate
+ * @ingroup perf
+ * @{
+ *
+ * @objective Measure rate of UDP packets processed on IUT and CPU cost
+ *            per packet when a minimal XDP program is attached to IUT
+ *            interface in native mode.
+ *
+ * @param env               Testing environment:
+ *                          - @ref env-peer2peer
+ *                          - @ref env-peer2peer_ipv6
+ * @param xdp_action        Action returned by XDP program:
+ *                          - @c none (no XDP program, baseline)
+ *                          - @c pass (@c XDP_PASS)
+ *                          - @c drop (@c XDP_DROP)
+ *                          - @c tx (@c XDP_TX, packets are sent back
+ *                            to Tester with MAC addresses swapped)
+ * @param frame_size        Size of Ethernet frame including FCS:
+ *                          - @c 64
+ *                          - @c 1518
+ * @param n_threads         Number of sender threads on Tester (every
+ *                          thread sends its own flow)
+ * @param burst             Number of packets passed to a single
+ *                          @b sendmmsg() call
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/xdp_perf"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "te_units.h"
+#include "tapi_cfg_stats.h"
+#include "tapi_bpf.h"
+#include "tapi_rpc_misc.h"
+
+/** How long to send packets, in seconds */
+#define TEST_SEND_DURATION_SEC 6
+
+/** Subdirectory of agent directory with BPF object files */
+#define TEST_BPF_DIR "net_drv_bpf"
+
+/** Name of BPF object file with XDP programs */
+#define TEST_BPF_OBJ "xdp_action.o"
+
+/** Action of XDP program */
+typedef enum test_xdp_action {
+    TEST_XDP_NONE,      /**< No XDP program */
+    TEST_XDP_PASS,      /**< XDP_PASS */
+    TEST_XDP_DROP,      /**< XDP_DROP */
+    TEST_XDP_TX,        /**< XDP_TX */
+} test_xdp_action;
+
+/** The list of values allowed for parameter of type 'xdp_action' */
+#define TEST_XDP_ACTION_MAPPING_LIST \
+    { "none",   TEST_XDP_NONE },     \
+    { "pass",   TEST_XDP_PASS },     \
+    { "drop",   TEST_XDP_DROP },     \
+    { "tx",     TEST_XDP_TX }
+
+/**
+ * Get the value of parameter of type 'xdp_action'
+ *
+ * @param var_name_  Name of the variable used to get the value of
+ *                   "var_name_" parameter of type 'xdp_action' (OUT)
+ */
+#define TEST_GET_XDP_ACTION(var_name_) \
+    TEST_GET_ENUM_PARAM(var_name_, TEST_XDP_ACTION_MAPPING_LIST)
+
+/**
+ * Check that XDP program is attached to an interface in native
+ * (driver) mode, skip the test otherwise.
+ *
+ * @param rpcs          RPC server.
+ * @param if_name       Interface name.
+ */
+static void
+check_xdp_native(rcf_rpc_server *rpcs, const char *if_name)
+{
+    rpc_wait_status status;
+    char *out = NULL;
+
+    RPC_AWAIT_ERROR(rpcs);
+    status = rpc_shell_get_all(rpcs, &out, "ip link show dev %s", -1,
+                               if_name);
+    if (status.flag != RPC_WAIT_STATUS_EXITED || status.value != 0)
+    {
+        free(out);
+        TEST_FAIL("Failed to get link attributes of %s", if_name);
+    }
+
+    /* Native mode is shown as "prog/xdp", generic as "prog/xdpgeneric" */
+    if (strstr(out, "prog/xdp ") == NULL)
+    {
+        RING("%s", out);
+        free(out);
+        TEST_SKIP("XDP program is not attached in native mode");
+    }
+
+    free(out);
+}
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct if_nameindex *tst_if = NULL;
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+    test_xdp_action xdp_action;
+    unsigned int frame_size;
+    unsigned int n_threads;
+    unsigned int burst;
+
+    te_mi_logger *logger = NULL;
+    net_drv_cpu_stat cpu_before = NET_DRV_CPU_STAT_INIT;
+    net_drv_cpu_stat cpu_after = NET_DRV_CPU_STAT_INIT;
+    tapi_cfg_if_stats iut_stats_before;
+    tapi_cfg_if_stats iut_stats_after;
+    tapi_cfg_if_stats tst_stats_before;
+    tapi_cfg_if_stats tst_stats_after;
+    char *agt_dir = NULL;
+    te_string path = TE_STRING_INIT;
+    unsigned int bpf_id = 0;
+    te_bool bpf_loaded = FALSE;
+    te_bool xdp_linked = FALSE;
+    int *cpus = NULL;
+    unsigned int pkt_size;
+    uint64_t sent;
+    uint64_t received;
+    uint64_t returned = 0;
+    double tx_pps;
+    double rx_pps;
+    double ret_pps = 0;
+    unsigned int i;
+    int iut_s = -1;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_IF(tst_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+    TEST_GET_XDP_ACTION(xdp_action);
+    TEST_GET_UINT_PARAM(frame_size);
+    TEST_GET_UINT_PARAM(n_threads);
+    TEST_GET_UINT_PARAM(burst);
+
+    pkt_size = net_drv_perf_udp_payload_len(frame_size,
+                                            iut_addr->sa_family);
+
+    TEST_STEP("If frames of @p frame_size bytes do not fit current MTU, "
+              "increase it on IUT and Tester.");
+    net_drv_perf_ensure_mtu(iut_rpcs->ta, iut_if->if_name, frame_size);
+    net_drv_perf_ensure_mtu(tst_rpcs->ta, tst_if->if_name, frame_size);
+
+    CFG_WAIT_CHANGES;
+
+    if (xdp_action != TEST_XDP_NONE)
+    {
+        TEST_STEP("If @p xdp_action is not @c none, load XDP program "
+                  "returning the action and attach it to IUT interface. "
+                  "Skip the test if it is not attached in native mode.");
+        CHECK_RC(cfg_get_instance_string_fmt(&agt_dir, "/agent:%s/dir:",
+                                             iut_rpcs->ta));
+        te_string_append(&path, "%s/" TEST_BPF_DIR "/" TEST_BPF_OBJ,
+                         agt_dir);
+
+        CHECK_RC(tapi_bpf_obj_init(iut_rpcs->ta, te_string_value(&path),
+                                   TAPI_BPF_PROG_TYPE_XDP, &bpf_id));
+        bpf_loaded = TRUE;
+
+        te_string_reset(&path);
+        te_string_append(&path, "xdp_%s", TEST_STRING_PARAM(xdp_action));
+        CHECK_RC(tapi_bpf_prog_link(iut_rpcs->ta, iut_if->if_name, bpf_id,
+                                    TAPI_BPF_LINK_XDP,
+                                    te_string_value(&path)));
+        xdp_linked = TRUE;
+
+        check_xdp_native(iut_rpcs, iut_if->if_name);
+    }
+
+    TEST_STEP("Create UDP socket on IUT bound to @p iut_addr so that "
+              "packets passed to network stack are delivered to it.");
+    iut_s = rpc_socket(iut_rpcs, rpc_socket_domain_by_addr(iut_addr),
+                       RPC_SOCK_DGRAM, RPC_PROTO_DEF);
+    rpc_bind(iut_rpcs, iut_s, iut_addr);
+
+    TEST_STEP("Get statistics of IUT and Tester interfaces and CPU usage "
+              "counters on IUT.");
+    NET_DRV_WAIT_IF_STATS_UPDATE;
+    CHECK_RC(tapi_cfg_stats_if_stats_get(iut_rpcs->ta, iut_if->if_name,
+                                         &iut_stats_before));
+    CHECK_RC(tapi_cfg_stats_if_stats_get(tst_rpcs->ta, tst_if->if_name,
+                                         &tst_stats_before));
+    net_drv_perf_cpu_stat_get(iut_rpcs, &cpu_before);
+
+    TEST_STEP("Send UDP packets fitting in @p frame_size bytes frames "
+              "from Tester to IUT at the maximum rate for a few seconds "
+              "from @p n_threads threads.");
+    cpus = tapi_calloc(n_threads, sizeof(*cpus));
+    for (i = 0; i < n_threads; i++)
+        cpus[i] = -1;
+
+    tst_rpcs->timeout = TE_SEC2MS(TEST_SEND_DURATION_SEC + 5);
+    rpc_net_drv_send_pkts_mt(tst_rpcs, tst_addr, iut_addr, cpus, n_threads,
+                             pkt_size, burst, 0,
+                             TE_SEC2MS(TEST_SEND_DURATION_SEC), NULL);
+
+    TEST_STEP("Get CPU usage counters on IUT and statistics of IUT and "
+              "Tester interfaces again. Compute number of packets sent "
+              "from Tester, received on IUT and (if @p xdp_action is "
+              "@c tx) returned back to Tester.");
+    net_drv_perf_cpu_stat_get(iut_rpcs, &cpu_after);
+    NET_DRV_WAIT_IF_STATS_UPDATE;
+    CHECK_RC(tapi_cfg_stats_if_stats_get(iut_rpcs->ta, iut_if->if_name,
+                                         &iut_stats_after));
+    CHECK_RC(tapi_cfg_stats_if_stats_get(tst_rpcs->ta, tst_if->if_name,
+                                         &tst_stats_after));
+
+    sent = tst_stats_after.out_ucast_pkts - tst_stats_before.out_ucast_pkts;
+    received = iut_stats_after.in_ucast_pkts -
+               iut_stats_before.in_ucast_pkts;
+    if (xdp_action == TEST_XDP_TX)
+    {
+        returned = tst_stats_after.in_ucast_pkts -
+                   tst_stats_before.in_ucast_pkts;
+    }
+
+    RING("%" TE_PRINTF_64 "u packets were sent by Tester interface, "
+         "%" TE_PRINTF_64 "u were received by IUT interface, "
+         "%" TE_PRINTF_64 "u were received back by Tester interface",
+         sent, received, returned);
+
+    if (received == 0)
+        TEST_VERDICT("No packets were received on IUT");
+    if (xdp_action == TEST_XDP_TX && returned == 0)
+        TEST_VERDICT("No packets were sent back by XDP program");
+
+    TEST_STEP("Report rates of sent, received and returned packets and "
+              "CPU usage on IUT including CPU cycles per received "
+              "packet.");
+    tx_pps = (double)sent / TEST_SEND_DURATION_SEC;
+    rx_pps = (double)received / TEST_SEND_DURATION_SEC;
+    ret_pps = (double)returned / TEST_SEND_DURATION_SEC;
+
+    TEST_ARTIFACT("XDP action %s, frame size %u: sent %.3f Mpps, "
+                  "received %.3f Mpps, returned %.3f Mpps",
+                  TEST_STRING_PARAM(xdp_action), frame_size,
+                  TE_UNITS_DEC_U2M(tx_pps), TE_UNITS_DEC_U2M(rx_pps),
+                  TE_UNITS_DEC_U2M(ret_pps));
+
+    CHECK_RC(te_mi_logger_meas_create("xdp_perf", &logger));
+    te_mi_logger_add_meas_key(logger, NULL, "XDP action", "%s",
+                              TEST_STRING_PARAM(xdp_action));
+    te_mi_logger_add_meas_key(logger, NULL, "Frame size", "%u",
+                              frame_size);
+    te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+            TE_MI_MEAS(PPS, "Sent", SINGLE, tx_pps, PLAIN),
+            TE_MI_MEAS(PPS, "Received", SINGLE, rx_pps, PLAIN)));
+    if (xdp_action == TEST_XDP_TX)
+    {
+        te_mi_logger_add_meas(logger, NULL, TE_MI_MEAS_PPS, "Returned",
+                              TE_MI_MEAS_AGGR_SINGLE, ret_pps,
+                              TE_MI_MEAS_MULTIPLIER_PLAIN);
+    }
+    net_drv_perf_cpu_usage_mi_log(logger, "IUT", &cpu_before, &cpu_after,
+                                  (double)received * frame_size, received);
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
+
+    if (xdp_linked)
+    {
+        CLEANUP_CHECK_RC(tapi_bpf_prog_unlink(iut_rpcs->ta, iut_if->if_name,
+                                              TAPI_BPF_LINK_XDP));
+    }
+    if (bpf_loaded)
+        CLEANUP_CHECK_RC(tapi_bpf_obj_fini(iut_rpcs->ta, bpf_id));
+
+    te_mi_logger_destroy(logger);
+    net_drv_perf_cpu_stat_free(&cpu_before);
+    net_drv_perf_cpu_stat_free(&cpu_after);
+    te_string_free(&path);
+    free(agt_dir);
+    free(cpus);
+
+    TEST_END;
+}
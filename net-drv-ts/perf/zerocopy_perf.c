@@ -0,0 +1,249 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* (c) Copyright 2026 OKTET Labs Ltd. All rights reserved. */
+/*
+ * Net Driver Test Suite
+ * Performance testing
+ */
+
+/** @defgroup perf-zerocopy_perf MSG_ZEROCOPY transmit performance
+ * @ingroup perf
+ * @{
+ *
+ * @objective Compare TCP transmit throughput and CPU usage of
+ *            zero-copy send with plain send() and check that data
+ *            is really sent without copying.
+ *
+ * @param env               Testing environment:
+ *                          - @ref env-peer2peer
+ *                          - @ref env-peer2peer_ipv6
+ * @param tx_csum           Enable, disable Tx checksum offload or
+ *                          preserve default (without it kernel disables
+ *                          scatter-gather and copies data of every
+ *                          zero-copy send, so copying is expected)
+ * @param tso               Enable, disable TSO offload or
+ *                          preserve default
+ * @param buf_size          Size of buffer passed to every send() call
+ *
+ * @type performance
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME  "perf/zerocopy_perf"
+
+#include "net_drv_test.h"
+#include "te_mi_log.h"
+#include "te_units.h"
+
+/** How long to send data in every mode, in seconds */
+#define TEST_SEND_DURATION_SEC 6
+
+/** Results of sending data in a single mode */
+typedef struct test_send_result {
+    int64_t sent;               /**< Number of sent bytes */
+    net_drv_zc_stats stats;     /**< Sending statistics */
+} test_send_result;
+
+/**
+ * Send data from IUT, receiving it on Tester.
+ *
+ * @param iut_rpcs      RPC server on IUT.
+ * @param iut_s         IUT socket.
+ * @param tst_rpcs      RPC server on Tester.
+ * @param tst_s         Tester socket.
+ * @param buf_size      Size of buffer passed to send().
+ * @param zerocopy      Whether to use @c MSG_ZEROCOPY.
+ * @param res           Where to save results.
+ */
+static void
+send_data(rcf_rpc_server *iut_rpcs, int iut_s,
+          rcf_rpc_server *tst_rpcs, int tst_s,
+          unsigned int buf_size, te_bool zerocopy,
+          test_send_result *res)
+{
+    const char *mode = zerocopy ? "MSG_ZEROCOPY" : "send()";
+    uint64_t read = 0;
+    int rc;
+
+    tst_rpcs->op = RCF_RPC_CALL;
+    rpc_drain_fd_duration(tst_rpcs, tst_s, buf_size, -1,
+                          TEST_SEND_DURATION_SEC + 1, NULL);
+
+    RPC_AWAIT_ERROR(iut_rpcs);
+    iut_rpcs->timeout = TE_SEC2MS(TEST_SEND_DURATION_SEC + 2);
+    res->sent = rpc_net_drv_send_zc(iut_rpcs, iut_s, buf_size,
+                                    TE_SEC2MS(TEST_SEND_DURATION_SEC),
+                                    zerocopy, &res->stats);
+    if (res->sent < 0)
+    {
+        rpc_drain_fd_duration(tst_rpcs, tst_s, buf_size, -1,
+                              TEST_SEND_DURATION_SEC + 1, NULL);
+
+        if (zerocopy && RPC_ERRNO(iut_rpcs) == RPC_EOPNOTSUPP)
+            TEST_SKIP("MSG_ZEROCOPY is not supported on IUT");
+
+        TEST_VERDICT("Sending with %s failed on IUT with error "
+                     RPC_ERROR_FMT, mode, RPC_ERROR_ARGS(iut_rpcs));
+    }
+
+    RPC_AWAIT_ERROR(tst_rpcs);
+    rc = rpc_drain_fd_duration(tst_rpcs, tst_s, buf_size, -1,
+                               TEST_SEND_DURATION_SEC + 1, &read);
+    if (rc < 0 && RPC_ERRNO(tst_rpcs) != RPC_EAGAIN)
+    {
+        TEST_VERDICT("Receiving data sent with %s failed on Tester with "
+                     "error " RPC_ERROR_FMT, mode,
+                     RPC_ERROR_ARGS(tst_rpcs));
+    }
+
+    if (read != (uint64_t)res->sent)
+    {
+        TEST_VERDICT("Number of bytes received on Tester does not match "
+                     "number of bytes sent with %s", mode);
+    }
+}
+
+/**
+ * Print and report as MI measurements results of sending data
+ * in a single mode.
+ *
+ * @param logger    MI logger.
+ * @param mode      Name of the mode.
+ * @param res       Results.
+ */
+static void
+log_send_result(te_mi_logger *logger, const char *mode,
+                const test_send_result *res)
+{
+    double throughput;
+    double cpu_usage;
+    double cpu_per_gb = 0;
+    te_string name = TE_STRING_INIT;
+
+    throughput = (double)res->sent * 8 / TEST_SEND_DURATION_SEC;
+    cpu_usage = (double)res->stats.cpu_time * 100 /
+                (TEST_SEND_DURATION_SEC * 1e9);
+    if (res->sent > 0)
+        cpu_per_gb = (double)res->stats.cpu_time / res->sent;
+
+    TEST_ARTIFACT("%s: throughput %.2f Mbps, CPU usage %.1f%%, "
+                  "%.3f CPU seconds per GB",
+                  mode, TE_UNITS_DEC_U2M(throughput), cpu_usage,
+                  cpu_per_gb);
+
+    te_string_append(&name, "%s CPU seconds per GB", mode);
+
+    te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+            TE_MI_MEAS(THROUGHPUT, mode, SINGLE, throughput, PLAIN),
+            TE_MI_MEAS(CPU, mode, SINGLE, cpu_usage, PLAIN),
+            TE_MI_MEAS(CPU, te_string_value(&name), SINGLE, cpu_per_gb,
+                       PLAIN)));
+
+    te_string_free(&name);
+}
+
+int
+main(int argc, char *argv[])
+{
+    rcf_rpc_server *iut_rpcs = NULL;
+    rcf_rpc_server *tst_rpcs = NULL;
+    const struct if_nameindex *iut_if = NULL;
+    const struct sockaddr *iut_addr = NULL;
+    const struct sockaddr *tst_addr = NULL;
+    te_bool3 tx_csum;
+    te_bool3 tso;
+    unsigned int buf_size;
+
+    te_mi_logger *logger = NULL;
+    test_send_result plain_res;
+    test_send_result zc_res;
+    int iut_s = -1;
+    int tst_s = -1;
+
+    TEST_START;
+    TEST_GET_PCO(iut_rpcs);
+    TEST_GET_PCO(tst_rpcs);
+    TEST_GET_IF(iut_if);
+    TEST_GET_ADDR(iut_rpcs, iut_addr);
+    TEST_GET_ADDR(tst_rpcs, tst_addr);
+    TEST_GET_BOOL_WITH_DEFAULT(tx_csum);
+    TEST_GET_BOOL_WITH_DEFAULT(tso);
+    TEST_GET_UINT_PARAM(buf_size);
+
+    TEST_STEP("Configure Tx checksum offload on IUT interface if "
+              "specified.");
+    net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                net_drv_perf_tx_csum_feature(
+                                                iut_rpcs->ta,
+                                                iut_if->if_name,
+                                                iut_addr->sa_family),
+                                tx_csum);
+
+    TEST_STEP("Configure TSO offload on IUT interface if specified.");
+    net_drv_perf_set_if_feature(iut_rpcs->ta, iut_if->if_name,
+                                net_drv_perf_tso_feature(
+                                                iut_addr->sa_family),
+                                tso);
+
+    CFG_WAIT_CHANGES;
+
+    TEST_STEP("Establish connection between a pair of TCP sockets "
+              "on IUT and Tester.");
+    GEN_CONNECTION(iut_rpcs, tst_rpcs, RPC_SOCK_STREAM, RPC_PROTO_DEF,
+                   iut_addr, tst_addr, &iut_s, &tst_s);
+
+    CHECK_RC(te_mi_logger_meas_create("zerocopy_perf", &logger));
+
+    TEST_STEP("Send data from IUT with plain @b send() for a few seconds, "
+              "passing @p buf_size bytes to every call. Receive and "
+              "count all the data on Tester.");
+    send_data(iut_rpcs, iut_s, tst_rpcs, tst_s, buf_size, FALSE,
+              &plain_res);
+
+    TEST_STEP("Send data from IUT with @c MSG_ZEROCOPY for the same time, "
+              "reading zero-copy completions from socket error queue. "
+              "Receive and count all the data on Tester.");
+    send_data(iut_rpcs, iut_s, tst_rpcs, tst_s, buf_size, TRUE,
+              &zc_res);
+
+    TEST_STEP("Report throughput and CPU usage of IUT sending thread "
+              "in both modes.");
+    log_send_result(logger, "send()", &plain_res);
+    log_send_result(logger, "MSG_ZEROCOPY", &zc_res);
+    CHECK_RC(te_mi_logger_flush(logger));
+
+    RING("MSG_ZEROCOPY: %" TE_PRINTF_64 "u send calls, "
+         "%" TE_PRINTF_64 "u completions, %" TE_PRINTF_64 "u of them "
+         "reported copying", zc_res.stats.calls,
+         zc_res.stats.zc_completed, zc_res.stats.zc_copied);
+
+    TEST_STEP("Check that completions were received for all zero-copy "
+              "sends and, unless @p tx_csum is @c FALSE, that data was not "
+              "copied by kernel instead of being sent by NIC directly "
+              "from user buffer. Without Tx checksum offload kernel "
+              "cannot use scatter-gather and always copies data, in this "
+              "case only the cost of such fallback is measured.");
+    if (zc_res.stats.zc_completed == 0)
+        TEST_VERDICT("No zero-copy completions were received");
+
+    if (zc_res.stats.zc_completed < zc_res.stats.calls)
+        WARN_VERDICT("Not all zero-copy completions were received");
+
+    if (tx_csum != TE_BOOL3_FALSE)
+    {
+        if (zc_res.stats.zc_copied == zc_res.stats.zc_completed)
+            TEST_VERDICT("Data was copied for all zero-copy sends");
+        else if (zc_res.stats.zc_copied > 0)
+            TEST_VERDICT("Data was copied for some zero-copy sends");
+    }
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
+    CLEANUP_RPC_CLOSE(tst_rpcs, tst_s);
+    te_mi_logger_destroy(logger);
+
+    TEST_END;
+}
@@ -23,6 +23,11 @@
  * @param iters          How many times to fill rules table and
  *                       remove all the added rules
  *
+ * @note Time taken by every rule insertion and deletion is measured.
+ *       Latency profile per range of table fill levels is printed for
+ *       every iteration and reported as MI measurements for the first
+ *       one.
+ *
  * @par Scenario:
  */
 
@@ -34,6 +39,108 @@
 #include "tapi_bpf_rxq_stats.h"
 #include "tapi_cfg_rx_rule.h"
 #include "common_rss.h"
+#include "te_mi_log.h"
+#include "te_string.h"
+
+/** Number of table fill levels in a bucket of latency statistics */
+#define RULES_BUCKET_SIZE 256
+
+/** Append latency statistics to a string */
+static void
+append_lat(te_string *str, const char *op, const net_drv_rx_rules_lat *lat)
+{
+    unsigned int i;
+
+    if (lat->count == 0)
+        return;
+
+    te_string_append(str, "  %s: count=%u min=%" TE_PRINTF_64 "u ns "
+                     "avg=%" TE_PRINTF_64 "u ns max=%" TE_PRINTF_64 "u ns "
+                     "hist(log2 us)=[",
+                     op, lat->count, lat->min, lat->total / lat->count,
+                     lat->max);
+    for (i = 0; i < TE_ARRAY_LEN(lat->hist); i++)
+        te_string_append(str, "%s%u", i == 0 ? "" : " ", lat->hist[i]);
+    te_string_append(str, "]\n");
+}
+
+/** Add MI measurements for latency statistics of a bucket */
+static void
+add_lat_meas(te_mi_logger *logger, const char *op, unsigned int first,
+             unsigned int last, const net_drv_rx_rules_lat *lat)
+{
+    char name[64];
+
+    if (lat->count == 0)
+        return;
+
+    TE_SPRINTF(name, "%s latency at %u-%u rules", op, first, last);
+
+    te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+            TE_MI_MEAS(LATENCY, name, MIN, lat->min, NANO),
+            TE_MI_MEAS(LATENCY, name, MEAN,
+                       (double)lat->total / lat->count, NANO),
+            TE_MI_MEAS(LATENCY, name, MAX, lat->max, NANO)));
+}
+
+/**
+ * Print latency profile of Rx rules table filling and clearing,
+ * optionally reporting it as MI measurements.
+ *
+ * @param rules_count     Number of added rules.
+ * @param prof            Latency profile.
+ * @param logger          MI logger (may be @c NULL).
+ */
+static void
+log_rx_rules_prof(unsigned int rules_count,
+                  const net_drv_rx_rules_prof *prof,
+                  te_mi_logger *logger)
+{
+    te_string str = TE_STRING_INIT;
+    double ins_rate = 0;
+    double del_rate = 0;
+    unsigned int first;
+    unsigned int last;
+    unsigned int i;
+
+    if (prof->ins_time > 0)
+        ins_rate = 1e9 * rules_count / prof->ins_time;
+    if (prof->del_time > 0)
+        del_rate = 1e9 * prof->del_count / prof->del_time;
+
+    te_string_append(&str, "Insertion rate: %.1f rules/s\n"
+                     "Deletion rate: %.1f rules/s\n", ins_rate, del_rate);
+
+    if (logger != NULL)
+    {
+        te_mi_logger_add_meas_vec(logger, NULL, TE_MI_MEAS_V(
+                TE_MI_MEAS(RPS, "Rx rules insertion", SINGLE,
+                           ins_rate, PLAIN),
+                TE_MI_MEAS(RPS, "Rx rules deletion", SINGLE,
+                           del_rate, PLAIN)));
+    }
+
+    for (i = 0; i < prof->buckets_num; i++)
+    {
+        first = i * RULES_BUCKET_SIZE;
+        last = first + RULES_BUCKET_SIZE - 1;
+
+        te_string_append(&str, "Rules %u-%u:\n", first, last);
+        append_lat(&str, "insert", &prof->buckets[i].ins);
+        append_lat(&str, "delete", &prof->buckets[i].del);
+
+        if (logger != NULL)
+        {
+            add_lat_meas(logger, "Insertion", first, last,
+                         &prof->buckets[i].ins);
+            add_lat_meas(logger, "Deletion", first, last,
+                         &prof->buckets[i].del);
+        }
+    }
+
+    RING("Rx rules latency profile:\n%s", te_string_value(&str));
+    te_string_free(&str);
+}
 
 int
 main(int argc, char *argv[])
@@ -58,6 +165,9 @@ main(int argc, char *argv[])
     unsigned int rules_num;
     cfg_handle *rules_handles = NULL;
 
+    net_drv_rx_rules_prof prof = { 0 };
+    te_mi_logger *logger = NULL;
+
     TEST_START;
     TEST_GET_PCO(iut_rpcs);
     TEST_GET_PCO(tst_rpcs);
@@ -102,13 +212,18 @@ main(int argc, char *argv[])
                      "until adding the next one fails. Then remove all "
                      "the added rules. Check that the count of added rules "
                      "does not decrease in comparison to the previous "
-                     "iteration.");
+                     "iteration. Measure time taken by every insertion "
+                     "and deletion.");
+
+        free(prof.buckets);
+        memset(&prof, 0, sizeof(prof));
 
         RPC_AWAIT_ERROR(iut_rpcs);
         rc = rpc_net_drv_too_many_rx_rules(iut_rpcs, iut_s, iut_if->if_name,
                                            tst_addr, iut_addr, sock_type,
                                            spec_loc, rss_ctx.rx_queues,
-                                           &rules_count, NULL);
+                                           RULES_BUCKET_SIZE,
+                                           &rules_count, NULL, &prof);
         if (rc < 0)
         {
             TEST_VERDICT("rpc_net_drv_too_many_rx_rules() failed with "
@@ -118,6 +233,18 @@ main(int argc, char *argv[])
         if (rules_count == 0)
             TEST_VERDICT("No Rx rules were added on IUT");
 
+        TEST_SUBSTEP("Print latency profile of insertions and deletions "
+                     "per range of table fill levels. On the first "
+                     "iteration report it also as MI measurements.");
+        if (i == 0)
+        {
+            CHECK_RC(te_mi_logger_meas_create("too_many_rx_rules",
+                                              &logger));
+        }
+        log_rx_rules_prof(rules_count, &prof, i == 0 ? logger : NULL);
+        if (i == 0)
+            CHECK_RC(te_mi_logger_flush(logger));
+
         if (prev_rules_count > 0 && rules_count < prev_rules_count &&
             !dec_count_verdict)
         {
@@ -135,6 +262,8 @@ cleanup:
 
     net_drv_rss_ctx_release(&rss_ctx);
     CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
+    free(prof.buckets);
+    te_mi_logger_destroy(logger);
 
     TEST_END;
 }
@@ -71,7 +71,7 @@
 /** How long to send packets from Tester, in milliseconds */
 #define SEND_TIME 2000
 
-/** Data passed to and from CSAP callback */
+/** Data passed to and from CSAP callback and Rx packets processing */
 typedef struct test_cb_args {
     /** Value of rx_max_coalesced_frames */
     unsigned int coalesce_frames;
@@ -86,8 +86,10 @@ typedef struct test_cb_args {
     /** Current element in delayed_pkt_ids vector. */
     unsigned int cur_delayed_idx;
 
-    /** Timestamp of the previous packet */
+    /** Timestamp of the previous packet captured on Tester */
     struct timeval prev_ts;
+    /** Rx timestamp of the previous packet received on IUT, in ns */
+    uint64_t prev_rx_ts;
     /** Size the current packet group */
     unsigned int cur_group_size;
 
@@ -124,6 +126,7 @@ typedef struct test_cb_args {
       .delayed_pkt_ids = TE_VEC_INIT(uint64_t),     \
       .cur_delayed_idx = 0,                         \
       .prev_ts = { 0, },                            \
+      .prev_rx_ts = 0,                              \
       .cur_group_size = 0,                          \
       .n_pkts = 0,                                  \
       .cur_pkt_id = 0,                              \
@@ -285,48 +288,26 @@ cleanup:
     asn_free_value(pkt);
 }
 
-/** CSAP callback for processing captured Rx packets */
+/** Process a packet received on IUT */
 static void
-process_rx_pkts(asn_value *pkt, void *user_data)
+process_rx_pkt(test_cb_args *args, const net_drv_pkt_ts *pkt)
 {
-    struct timeval ts;
-    te_errno rc;
-
-    test_cb_args *args = (test_cb_args *)user_data;
-
     args->n_pkts++;
+    args->cur_pkt_id = pkt->id;
 
-    if (args->failed)
-        goto cleanup;
-
-    rc = tapi_tad_get_pkt_rx_ts(pkt, &ts);
-    if (rc != 0)
-    {
-        args->failed = TRUE;
-        goto cleanup;
-    }
-
-    rc = get_pkt_id(pkt, &args->cur_pkt_id);
-    if (rc != 0)
+    if (args->n_pkts > 1 &&
+        pkt->ts - args->prev_rx_ts > TE_US2NS(MIN_GROUP_DELAY))
     {
-        args->failed = TRUE;
-        goto cleanup;
-    }
-
-    if (args->n_pkts > 1 && TIMEVAL_SUB(ts, args->prev_ts) > MIN_GROUP_DELAY)
         finish_pkt_group(args);
+    }
 
-    args->prev_ts = ts;
+    args->prev_rx_ts = pkt->ts;
     args->cur_group_size++;
-
-cleanup:
-
-    asn_free_value(pkt);
 }
 
 /**
- * Finalize computation of packet statistics after CSAP captured
- * the last packet.
+ * Finalize computation of packet statistics after the last received
+ * packet is processed.
  */
 static void
 finalize_stats(test_cb_args *args)
@@ -368,11 +349,13 @@ main(int argc, char *argv[])
     uint64_t prev_adaptive_rx;
     te_bool restore_prev_values = FALSE;
 
-    csap_handle_t csap_rx = CSAP_INVALID_HANDLE;
     csap_handle_t csap_tx = CSAP_INVALID_HANDLE;
     tapi_tad_trrecv_cb_data csap_cb_data;
     test_cb_args cb_args = TEST_CB_ARGS_INIT;
-    int rc_aux;
+    net_drv_pkt_ts *rx_pkts = NULL;
+    unsigned int rx_pkts_num = 0;
+    unsigned int i;
+    int64_t rc_aux;
     double avg_err;
     double dev_err;
 
@@ -484,44 +467,32 @@ main(int argc, char *argv[])
                                    NULL, TAD_TIMEOUT_INF, 0,
                                    RCF_TRRECV_PACKETS));
 
-    TEST_STEP("Create a CSAP on IUT to capture packets received from "
-              "Tester.");
-
-    CHECK_RC(tapi_udp_ip_eth_csap_create(iut_rpcs->ta, 0, iut_if->if_name,
-                                         TAD_ETH_RECV_DEF |
-                                         TAD_ETH_RECV_NO_PROMISC,
-                                         NULL, NULL,
-                                         iut_addr->sa_family,
-                                         TAD_SA2ARGS(iut_addr, tst_addr),
-                                         &csap_rx));
-
-    CHECK_RC(tapi_tad_trrecv_start(iut_rpcs->ta, 0, csap_rx,
-                                   NULL, TAD_TIMEOUT_INF, 0,
-                                   RCF_TRRECV_PACKETS));
-
-    TEST_STEP("For some time send UDP packets from Tester to IUT, "
-              "waiting a little after sending every packet. Receive "
-              "and check data on IUT.");
+    TEST_STEP("For some time send UDP packets from Tester to IUT one by "
+              "one, pacing them on @c CLOCK_MONOTONIC_RAW so that "
+              "they are sent with the chosen delay. Receive and check "
+              "data on IUT with recvmmsg(), getting software Rx "
+              "timestamp of every packet.");
 
     tst_rpcs->op = RCF_RPC_CALL;
-    rpc_net_drv_send_pkts_exact_delay(tst_rpcs, tst_s, send_delay,
-                                      SEND_TIME);
+    rpc_net_drv_send_pkts_burst(tst_rpcs, tst_s, 1, TE_US2NS(send_delay),
+                                SEND_TIME);
 
     RPC_AWAIT_ERROR(iut_rpcs);
-    rc_aux = rpc_net_drv_recv_pkts_exact_delay(iut_rpcs, iut_s,
-                                               TAPI_WAIT_NETWORK_DELAY);
+    rc_aux = rpc_net_drv_recv_pkts_ts(iut_rpcs, iut_s,
+                                      TAPI_WAIT_NETWORK_DELAY, NULL, 0,
+                                      &rx_pkts, &rx_pkts_num);
     if (rc_aux < 0)
     {
-        ERROR_VERDICT("rpc_net_drv_recv_pkts_exact_delay() failed: ",
+        ERROR_VERDICT("rpc_net_drv_recv_pkts_ts() failed: ",
                       RPC_ERROR_FMT, RPC_ERROR_ARGS(iut_rpcs));
     }
 
     RPC_AWAIT_ERROR(tst_rpcs);
-    rc = rpc_net_drv_send_pkts_exact_delay(tst_rpcs, tst_s, send_delay,
-                                           SEND_TIME);
+    rc = rpc_net_drv_send_pkts_burst(tst_rpcs, tst_s, 1,
+                                     TE_US2NS(send_delay), SEND_TIME);
     if (rc < 0)
     {
-        ERROR_VERDICT("rpc_net_drv_send_pkts_exact_delay() failed: ",
+        ERROR_VERDICT("rpc_net_drv_send_pkts_burst() failed: ",
                       RPC_ERROR_FMT, RPC_ERROR_ARGS(tst_rpcs));
     }
 
@@ -551,20 +522,17 @@ main(int argc, char *argv[])
                   "on Tester");
     }
 
-    TEST_STEP("Investigate timestamps of packets captured by CSAP on IUT. "
+    TEST_STEP("Investigate Rx timestamps of packets received on IUT. "
               "Packets should be received in groups of @p coalesce_frames "
               "separated by larger delays.");
 
     cb_args.n_pkts = 0;
-    csap_cb_data.callback = &process_rx_pkts;
+    for (i = 0; i < rx_pkts_num; i++)
+        process_rx_pkt(&cb_args, &rx_pkts[i]);
 
-    CHECK_RC(tapi_tad_trrecv_stop(iut_rpcs->ta, 0, csap_rx,
-                                  &csap_cb_data, NULL));
-    RING("%u packets captured on IUT", cb_args.n_pkts);
+    RING("%u packets received on IUT", cb_args.n_pkts);
     if (cb_args.n_pkts == 0)
-        TEST_VERDICT("No packets were captured by IUT CSAP");
-    if (cb_args.failed)
-        TEST_FAIL("Failed to process some of the captured packets on IUT");
+        TEST_VERDICT("No packets were received on IUT");
 
     finalize_stats(&cb_args);
 
@@ -594,12 +562,6 @@ cleanup:
                                                csap_tx));
     }
 
-    if (csap_rx != CSAP_INVALID_HANDLE)
-    {
-        CLEANUP_CHECK_RC(tapi_tad_csap_destroy(iut_rpcs->ta, 0,
-                                               csap_rx));
-    }
-
     CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
     CLEANUP_RPC_CLOSE(tst_rpcs, tst_s);
 
@@ -642,6 +604,7 @@ cleanup:
     }
 
     te_vec_free(&cb_args.delayed_pkt_ids);
+    free(rx_pkts);
 
     TEST_END;
 }
@@ -31,15 +31,11 @@
 #define TE_TEST_NAME "rx_path/rx_coalesce_usecs"
 
 #include "net_drv_test.h"
-#include "tapi_eth.h"
-#include "tapi_udp.h"
 #include "tapi_cfg_if_coalesce.h"
 #include "tapi_cfg_rx_rule.h"
 #include "tapi_cfg_if_chan.h"
-#include "tapi_mem.h"
 
 #include <math.h>
-#include <byteswap.h>
 
 /**
  * Minimum delay between packets after which the next packet
@@ -82,286 +78,36 @@ static unsigned int min_group_delay = 100;
 /** How long to send packets from Tester, in milliseconds */
 #define SEND_TIME 2000
 
-/** Data passed to and from CSAP callback */
-typedef struct test_cb_args {
-    /** Value of rx_coalesce_usecs */
-    unsigned int coalesce_usecs;
-    /** Delay after sending a packet on Tester */
-    unsigned int pkt_send_delay;
+/** Number of buckets in histogram of gaps between packet groups */
+#define GAP_HIST_BUCKETS 16
 
-    /**
-     * Numbers of Tx packets with too big delays before
-     * them
-     */
-    te_vec delayed_pkt_ids;
-    /** Current element in delayed_pkt_ids vector. */
-    unsigned int cur_delayed_idx;
-
-    /** Timestamp of the previous packet */
-    struct timeval prev_ts;
-    /** Timestamp of the first packet in the current packet group */
-    struct timeval cur_group_ts;
-
-    /** Number of captured packets */
-    unsigned int n_pkts;
-    /** Id of the last captured packet */
-    uint64_t cur_pkt_id;
-    /** Number of packet groups */
-    unsigned int n_groups;
-    /** Total duration of all Rx packet groups, in us */
-    double total_groups_time;
-    /**
-     * Sum of squared deviations of actual packet group durations
-     * from rx_coalesce_usecs
-     */
-    double squared_dev_sum;
-    /** Average duration of a packet group */
-    double avg_group_time;
-    /**
-     * Square root of average squared deviation of packet group
-     * duration from rx_coalesce_usecs
-     */
-    double group_time_dev;
-
-    /** Will be set to TRUE if packet processing failed */
-    te_bool failed;
-} test_cb_args;
-
-/** Initializer for test_cb_args */
-#define TEST_CB_ARGS_INIT \
-    {                                               \
-      .coalesce_usecs = 0,                          \
-      .pkt_send_delay = 0,                          \
-      .delayed_pkt_ids = TE_VEC_INIT(uint64_t),     \
-      .cur_delayed_idx = 0,                         \
-      .prev_ts = { 0, },                            \
-      .cur_group_ts = { 0, },                       \
-      .n_pkts = 0,                                  \
-      .cur_pkt_id = 0,                              \
-      .n_groups = 0,                                \
-      .total_groups_time = 0.0,                     \
-      .squared_dev_sum = 0.0,                       \
-      .avg_group_time = 0.0,                        \
-      .group_time_dev = 0.0,                        \
-      .failed = FALSE,                              \
-    }
-
-/**
- * Finalize the current packet group, update related
- * statistics.
- */
+/** Log histogram of gaps between packet groups */
 static void
-finish_pkt_group(test_cb_args *args, struct timeval *ts)
+log_gap_hist(const net_drv_pkt_groups *groups, unsigned int bucket_width)
 {
-    double group_duration;
-    double duration_deviation;
-    te_bool skip_group = FALSE;
-    unsigned int tx_pkt_id;
-    unsigned int tx_delays_num;
-
-    tx_delays_num = te_vec_size(&args->delayed_pkt_ids);
-    if (args->cur_delayed_idx < tx_delays_num)
+    te_string str = TE_STRING_INIT;
+    unsigned int i;
+
+    for (i = 0; i < groups->gap_hist_len; i++)
     {
-        tx_pkt_id = TE_VEC_GET(uint64_t, &args->delayed_pkt_ids,
-                               args->cur_delayed_idx);
-        if (args->cur_pkt_id >= tx_pkt_id)
+        if (i + 1 < groups->gap_hist_len)
         {
-            /*
-             * If the current packet was sent after an unexpectedly big
-             * delay, it is hard to estimate real duration of the
-             * last packet group, so ignore it.
-             */
-            skip_group = TRUE;
-
-            for (args->cur_delayed_idx++;
-                 args->cur_delayed_idx < tx_delays_num;
-                 args->cur_delayed_idx++)
-            {
-                tx_pkt_id = TE_VEC_GET(uint64_t, &args->delayed_pkt_ids,
-                                       args->cur_delayed_idx);
-                if (tx_pkt_id > args->cur_pkt_id)
-                    break;
-            }
+            te_string_append(&str, "%u - %u us: %u\n",
+                             min_group_delay + i * bucket_width,
+                             min_group_delay + (i + 1) * bucket_width,
+                             groups->gap_hist[i]);
+        }
+        else
+        {
+            te_string_append(&str, "%u us and more: %u\n",
+                             min_group_delay + i * bucket_width,
+                             groups->gap_hist[i]);
         }
     }
 
-    if (!skip_group)
-    {
-        args->n_groups++;
-
-        group_duration = TIMEVAL_SUB(*ts, args->cur_group_ts);
-        args->total_groups_time += group_duration;
-        duration_deviation = group_duration - args->coalesce_usecs;
-        args->squared_dev_sum += duration_deviation * duration_deviation;
-    }
-
-    args->cur_group_ts = *ts;
-}
-
-/**
- * Get Id of the packet (64-bit ordinal number stored in its payload).
- */
-static te_errno
-get_pkt_id(asn_value *pkt, uint64_t *id)
-{
-    int pld_len;
-    size_t field_len;
-    char *buf = NULL;
-    int i;
-    te_errno rc;
-
-    pld_len = asn_get_length(pkt, "payload.#bytes");
-    if (pld_len < 0)
-    {
-        ERROR("%s(): failed to get length of payload.#bytes",
-              __FUNCTION__);
-        return TE_EBADMSG;
-    }
-
-    buf = tapi_calloc(pld_len, 1);
-
-    field_len = pld_len;
-    rc = asn_read_value_field(pkt, buf, &field_len, "payload.#bytes");
-    if (rc != 0)
-    {
-        ERROR("%s(): failed to read payload.#bytes, rc=%r",
-              __FUNCTION__, rc);
-        free(buf);
-        return rc;
-    }
-
-    /*
-     * Skip padding which may be present in short Ethernet frame.
-     * Packet Id is always followed by 0xff byte to make this possible.
-     */
-    for (i = field_len - 1; i >= 0 && buf[i] == 0; i--);
-    if (i < (int)sizeof(uint64_t))
-    {
-        ERROR("%s(): failed to parse payload.#bytes",
-              __FUNCTION__);
-        free(buf);
-        return TE_EBADMSG;
-    }
-
-    *id = *(uint64_t *)&buf[i - 8];
-    if (htonl(1) != 1)
-        *id = bswap_64(*id);
-
-    free(buf);
-    return 0;
-}
-
-/** CSAP callback for processing captured Tx packets */
-static void
-process_tx_pkts(asn_value *pkt, void *user_data)
-{
-    struct timeval ts;
-    te_errno rc;
-
-    test_cb_args *args = (test_cb_args *)user_data;
-
-    args->n_pkts++;
-
-    if (args->failed)
-        goto cleanup;
-
-    rc = tapi_tad_get_pkt_rx_ts(pkt, &ts);
-    if (rc != 0)
-    {
-        args->failed = TRUE;
-        goto cleanup;
-    }
-
-    rc = get_pkt_id(pkt, &args->cur_pkt_id);
-    if (rc != 0)
-    {
-        args->failed = TRUE;
-        goto cleanup;
-    }
-
-    if (args->n_pkts == 1)
-    {
-        args->prev_ts = ts;
-    }
-    else
-    {
-        if (TIMEVAL_SUB(ts, args->prev_ts) > args->pkt_send_delay * 5)
-            TE_VEC_APPEND(&args->delayed_pkt_ids, args->cur_pkt_id);
-
-        args->prev_ts = ts;
-    }
-
-cleanup:
-
-    asn_free_value(pkt);
-}
-
-/** CSAP callback for processing captured Rx packets */
-static void
-process_rx_pkts(asn_value *pkt, void *user_data)
-{
-    struct timeval ts;
-    te_errno rc;
-
-    test_cb_args *args = (test_cb_args *)user_data;
-
-    args->n_pkts++;
-
-    if (args->failed)
-        goto cleanup;
-
-    rc = tapi_tad_get_pkt_rx_ts(pkt, &ts);
-    if (rc != 0)
-    {
-        args->failed = TRUE;
-        goto cleanup;
-    }
-
-    rc = get_pkt_id(pkt, &args->cur_pkt_id);
-    if (rc != 0)
-    {
-        args->failed = TRUE;
-        goto cleanup;
-    }
-
-    if (args->n_pkts == 1)
-    {
-        args->prev_ts = ts;
-        args->cur_group_ts = ts;
-    }
-    else
-    {
-        if (TIMEVAL_SUB(ts, args->prev_ts) > min_group_delay)
-            finish_pkt_group(args, &ts);
-
-        args->prev_ts = ts;
-    }
-
-cleanup:
-
-    asn_free_value(pkt);
-}
-
-/**
- * Finalize computation of packet statistics after CSAP captured
- * the last packet.
- */
-static void
-finalize_stats(test_cb_args *args)
-{
-    if (args->n_groups == 0)
-    {
-        WARN_ARTIFACT("No packet groups with measurable duration was detected");
-        return;
-    }
-
-    args->avg_group_time = args->total_groups_time / args->n_groups;
-    args->group_time_dev = sqrt(args->squared_dev_sum / args->n_groups);
-
-    RING_ARTIFACT("Number of packet groups: %u\n"
-                  "Average group time: %.3f microseconds\n"
-                  "Group time deviation: %.3f",
-                  args->n_groups, args->avg_group_time, args->group_time_dev);
+    RING("Histogram of gaps between packet groups:\n%s",
+         te_string_value(&str));
+    te_string_free(&str);
 }
 
 int
@@ -371,7 +117,6 @@ main(int argc, char *argv[])
     rcf_rpc_server *tst_rpcs = NULL;
 
     const struct if_nameindex *iut_if = NULL;
-    const struct if_nameindex *tst_if = NULL;
     const struct sockaddr *iut_addr = NULL;
     const struct sockaddr *tst_addr = NULL;
 
@@ -389,11 +134,9 @@ main(int argc, char *argv[])
     bool restore_prev_values = false;
     bool remove_rule = false;
 
-    csap_handle_t csap_rx = CSAP_INVALID_HANDLE;
-    csap_handle_t csap_tx = CSAP_INVALID_HANDLE;
-    tapi_tad_trrecv_cb_data csap_cb_data;
-    test_cb_args cb_args = TEST_CB_ARGS_INIT;
-    int rc_aux;
+    net_drv_pkt_groups groups = { .gap_hist = NULL };
+    unsigned int bucket_width;
+    int64_t rc_aux;
 
     tapi_cfg_rx_rule_flow flow_type;
     int64_t location = TAPI_CFG_RX_RULE_ANY;
@@ -408,7 +151,6 @@ main(int argc, char *argv[])
     TEST_GET_PCO(iut_rpcs);
     TEST_GET_PCO(tst_rpcs);
     TEST_GET_IF(iut_if);
-    TEST_GET_IF(tst_if);
     TEST_GET_ADDR(iut_rpcs, iut_addr);
     TEST_GET_ADDR(tst_rpcs, tst_addr);
     TEST_GET_INT_PARAM(coalesce_usecs);
@@ -561,117 +303,85 @@ main(int argc, char *argv[])
     if (rc != 0)
         TEST_VERDICT("Failed to set rx_coalesce_usecs, rc=%r", rc);
 
-    TEST_STEP("Create a CSAP on Tester to capture packets sent from it "
-              "to IUT.");
-
-    CHECK_RC(tapi_udp_ip_eth_csap_create(tst_rpcs->ta, 0, tst_if->if_name,
-                                         TAD_ETH_RECV_OUT |
-                                         TAD_ETH_RECV_NO_PROMISC,
-                                         NULL, NULL,
-                                         iut_addr->sa_family,
-                                         TAD_SA2ARGS(iut_addr, tst_addr),
-                                         &csap_tx));
-
-    CHECK_RC(tapi_tad_trrecv_start(tst_rpcs->ta, 0, csap_tx,
-                                   NULL, TAD_TIMEOUT_INF, 0,
-                                   RCF_TRRECV_PACKETS));
+    TEST_STEP("For some time send UDP packets from Tester to IUT one by "
+              "one, pacing them on @c CLOCK_MONOTONIC_RAW so that "
+              "they are sent with the chosen delay. Tester marks "
+              "packets sent after unexpectedly big delays.");
 
-    TEST_STEP("Create a CSAP on IUT to capture packets received from "
-              "Tester.");
-
-    CHECK_RC(tapi_udp_ip_eth_csap_create(iut_rpcs->ta, 0, iut_if->if_name,
-                                         TAD_ETH_RECV_DEF |
-                                         TAD_ETH_RECV_NO_PROMISC,
-                                         NULL, NULL,
-                                         iut_addr->sa_family,
-                                         TAD_SA2ARGS(iut_addr, tst_addr),
-                                         &csap_rx));
-
-    CHECK_RC(tapi_tad_trrecv_start(iut_rpcs->ta, 0, csap_rx,
-                                   NULL, TAD_TIMEOUT_INF, 0,
-                                   RCF_TRRECV_PACKETS));
+    tst_rpcs->op = RCF_RPC_CALL;
+    rpc_net_drv_send_pkts_burst(tst_rpcs, tst_s, 1, TE_US2NS(send_delay),
+                                SEND_TIME);
 
-    TEST_STEP("For some time send UDP packets from Tester to IUT, "
-              "waiting a little after sending every packet. Receive "
-              "and check data on IUT.");
+    TEST_STEP("Receive and check packets on IUT with "
+              "@b net_drv_recv_pkts_groups() RPC. It splits packets into "
+              "groups separated by delays larger than minimum group "
+              "delay according to their software Rx timestamps and "
+              "computes statistics of group durations on IUT. Groups "
+              "affected by delays on Tester are ignored.");
 
-    tst_rpcs->op = RCF_RPC_CALL;
-    rpc_net_drv_send_pkts_exact_delay(tst_rpcs, tst_s, send_delay,
-                                      SEND_TIME);
+    bucket_width = MAX(min_group_delay, (unsigned int)coalesce_usecs / 4);
 
     RPC_AWAIT_ERROR(iut_rpcs);
-    rc_aux = rpc_net_drv_recv_pkts_exact_delay(iut_rpcs, iut_s,
-                                               TAPI_WAIT_NETWORK_DELAY);
+    rc_aux = rpc_net_drv_recv_pkts_groups(iut_rpcs, iut_s,
+                                          TAPI_WAIT_NETWORK_DELAY, NULL,
+                                          min_group_delay, coalesce_usecs,
+                                          bucket_width, GAP_HIST_BUCKETS,
+                                          &groups);
     if (rc_aux < 0)
     {
-        ERROR_VERDICT("rpc_net_drv_recv_pkts_exact_delay() failed: ",
+        ERROR_VERDICT("rpc_net_drv_recv_pkts_groups() failed: ",
                       RPC_ERROR_FMT, RPC_ERROR_ARGS(iut_rpcs));
     }
 
     RPC_AWAIT_ERROR(tst_rpcs);
-    rc = rpc_net_drv_send_pkts_exact_delay(tst_rpcs, tst_s, send_delay,
-                                           SEND_TIME);
+    rc = rpc_net_drv_send_pkts_burst(tst_rpcs, tst_s, 1,
+                                     TE_US2NS(send_delay), SEND_TIME);
     if (rc < 0)
     {
-        ERROR_VERDICT("rpc_net_drv_send_pkts_exact_delay() failed: ",
+        ERROR_VERDICT("rpc_net_drv_send_pkts_burst() failed: ",
                       RPC_ERROR_FMT, RPC_ERROR_ARGS(tst_rpcs));
     }
 
     if (rc < 0 || rc_aux < 0)
         TEST_STOP;
 
-    rcf_tr_op_log(FALSE);
-    memset(&csap_cb_data, 0, sizeof(csap_cb_data));
-    csap_cb_data.callback = &process_tx_pkts;
-    csap_cb_data.user_data = &cb_args;
-
-    cb_args.coalesce_usecs = coalesce_usecs;
-    cb_args.pkt_send_delay = send_delay;
-
-    TEST_STEP("Investigate timestamps of Tx packets captured by Tester "
-              "CSAP. Memorize numbers of packets sent after big delays "
-              "to ignore them when computing coalescing statistics on "
-              "IUT.");
-    CHECK_RC(tapi_tad_trrecv_stop(tst_rpcs->ta, 0, csap_tx,
-                                  &csap_cb_data, NULL));
-    RING("%u packets sent from Tester", cb_args.n_pkts);
-    if (cb_args.n_pkts == 0)
-        TEST_VERDICT("No packets were captured by Tester CSAP");
-    if (cb_args.failed)
-    {
-        TEST_FAIL("Failed to process some of the captured packets "
-                  "on Tester");
-    }
+    RING("%jd packets received on IUT", (intmax_t)rc_aux);
+    if (rc_aux == 0)
+        TEST_VERDICT("No packets were received on IUT");
 
-    TEST_STEP("Investigate timestamps of packets captured by CSAP on IUT. "
-              "If @p coalesce_usecs is @c 0, there should be only small "
-              "delays after every packet. If @p coalesce_usecs is "
-              "not zero, packets should be received in groups separated "
-              "by larger delays.");
+    TEST_STEP("Check statistics of packet groups. If @p coalesce_usecs "
+              "is @c 0, there should be only small delays after every "
+              "packet. If @p coalesce_usecs is not zero, packets should "
+              "be received in groups separated by larger delays.");
 
-    cb_args.n_pkts = 0;
-    csap_cb_data.callback = &process_rx_pkts;
+    log_gap_hist(&groups, bucket_width);
 
-    CHECK_RC(tapi_tad_trrecv_stop(iut_rpcs->ta, 0, csap_rx,
-                                  &csap_cb_data, NULL));
-    RING("%u packets captured on IUT", cb_args.n_pkts);
-    if (cb_args.n_pkts == 0)
-        TEST_VERDICT("No packets were captured by IUT CSAP");
-    if (cb_args.failed)
-        TEST_FAIL("Failed to process some of the captured packets on IUT");
+    if (groups.n_groups == 0)
+    {
+        WARN_ARTIFACT("No packet groups with measurable duration was "
+                      "detected");
+    }
+    else
+    {
+        RING_ARTIFACT("Number of packet groups: %u\n"
+                      "Skipped packet groups: %u\n"
+                      "Average group time: %.3f microseconds\n"
+                      "Group time deviation: %.3f",
+                      groups.n_groups, groups.skipped_groups,
+                      groups.avg_group_time, groups.group_time_dev);
+    }
 
-    finalize_stats(&cb_args);
     if (coalesce_usecs > 0)
     {
         double avg_err;
         double dev_err;
 
-        if (cb_args.n_groups == 0)
+        if (groups.n_groups == 0)
             TEST_FAIL("Failed to get statistics for packet groups");
 
-        avg_err = fabs(cb_args.avg_group_time - coalesce_usecs) /
+        avg_err = fabs(groups.avg_group_time - coalesce_usecs) /
             coalesce_usecs;
-        dev_err = cb_args.group_time_dev / coalesce_usecs;
+        dev_err = groups.group_time_dev / coalesce_usecs;
 
         RING_ARTIFACT("Average group time error: %.3f\n"
                       "Group time deviation error: %.3f",
@@ -685,7 +395,7 @@ main(int argc, char *argv[])
     }
     else
     {
-        if ((double)(cb_args.n_groups) / cb_args.n_pkts > MAX_UNEXP_DELAYS)
+        if ((double)groups.n_groups / rc_aux > MAX_UNEXP_DELAYS)
             TEST_VERDICT("Too many big delays between packets");
     }
 
@@ -693,18 +403,6 @@ main(int argc, char *argv[])
 
 cleanup:
 
-    if (csap_tx != CSAP_INVALID_HANDLE)
-    {
-        CLEANUP_CHECK_RC(tapi_tad_csap_destroy(tst_rpcs->ta, 0,
-                                               csap_tx));
-    }
-
-    if (csap_rx != CSAP_INVALID_HANDLE)
-    {
-        CLEANUP_CHECK_RC(tapi_tad_csap_destroy(iut_rpcs->ta, 0,
-                                               csap_rx));
-    }
-
     CLEANUP_RPC_CLOSE(iut_rpcs, iut_s);
     CLEANUP_RPC_CLOSE(tst_rpcs, tst_s);
 
@@ -759,7 +457,7 @@ cleanup:
                                               location));
     }
 
-    te_vec_free(&cb_args.delayed_pkt_ids);
+    free(groups.gap_hist);
 
     TEST_END;
 }
@@ -22,6 +22,8 @@
  *                        @p send_time expires.
  * @param conns_num       How many connections should send and receive
  *                        data.
+ * @param uring           If @c TRUE, send and receive data with io_uring
+ *                        to generate higher load.
  *
  * @par Scenario:
  *
@@ -63,6 +65,7 @@ main(int argc, char **argv)
 
     int send_time;
     te_bool unload_once;
+    te_bool uring;
 
     int conns_num;
     int flows_num;
@@ -84,6 +87,7 @@ main(int argc, char **argv)
     TEST_GET_INT_PARAM(send_time);
     TEST_GET_BOOL_PARAM(unload_once);
     TEST_GET_INT_PARAM(conns_num);
+    TEST_GET_BOOL_PARAM(uring);
 
     CHECK_NOT_NULL(iut_drv_name = net_drv_driver_name(iut_rpcs->ta));
 
@@ -129,6 +133,7 @@ main(int argc, char **argv)
             flow->ignore_send_err = TRUE;
             flow->min_size = 1;
             flow->max_size = MAX_SEND_SIZE;
+            flow->use_uring = uring;
 
             net_drv_flow_prepare(flow);
         }
@@ -138,8 +143,9 @@ main(int argc, char **argv)
     CHECK_RC(cfg_create_backup(&cfg_bkp));
 
     TEST_STEP("Start sending and receiving data simultaneously in both "
-              "directions over each connected socket pair. This "
-              "should continue until @p send_time expires.");
+              "directions over each connected socket pair (with "
+              "io_uring if @p uring is @c TRUE). This should continue "
+              "until @p send_time expires.");
     for (j = 0; j < flows_num; j++)
         net_drv_flow_start(&flows[j]);
 
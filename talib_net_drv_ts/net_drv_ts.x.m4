@@ -1,6 +1,21 @@
 /* SPDX-License-Identifier: Apache-2.0 */
 /* Copyright (C) 2023 OKTET Labs Ltd. All rights reserved. */
 
+const NET_DRV_RX_RULES_LAT_BINS = 16;
+
+struct tarpc_net_drv_rx_rules_lat {
+    uint32_t count;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    uint32_t hist[NET_DRV_RX_RULES_LAT_BINS];
+};
+
+struct tarpc_net_drv_rx_rules_bucket {
+    struct tarpc_net_drv_rx_rules_lat ins;
+    struct tarpc_net_drv_rx_rules_lat del;
+};
+
 struct tarpc_net_drv_too_many_rx_rules_in {
     struct tarpc_in_arg common;
 
@@ -11,6 +26,7 @@ struct tarpc_net_drv_too_many_rx_rules_in {
     tarpc_int sock_type;
     tarpc_bool any_location;
     tarpc_uint queues_num;
+    tarpc_uint bucket_size;
 };
 
 struct tarpc_net_drv_too_many_rx_rules_out {
@@ -18,6 +34,10 @@ struct tarpc_net_drv_too_many_rx_rules_out {
 
     tarpc_uint rules_count;
     tarpc_uint add_errno;
+    struct tarpc_net_drv_rx_rules_bucket buckets<>;
+    uint64_t ins_time;
+    uint64_t del_time;
+    tarpc_uint del_count;
     tarpc_int retval;
 };
 
@@ -35,6 +55,21 @@ struct tarpc_net_drv_send_pkts_exact_delay_out {
     int64_t retval;
 };
 
+struct tarpc_net_drv_send_pkts_burst_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    uint32_t burst;
+    uint64_t gap;
+    uint32_t time2run;
+};
+
+struct tarpc_net_drv_send_pkts_burst_out {
+    struct tarpc_out_arg common;
+
+    int64_t retval;
+};
+
 struct tarpc_net_drv_recv_pkts_exact_delay_in {
     struct tarpc_in_arg common;
 
@@ -48,6 +83,356 @@ struct tarpc_net_drv_recv_pkts_exact_delay_out {
     int64_t retval;
 };
 
+struct tarpc_net_drv_pkt_ts {
+    uint64_t id;
+    uint64_t ts;
+};
+
+struct tarpc_net_drv_recv_pkts_ts_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    uint32_t time2wait;
+    string hw_ts_if<>;
+    uint32_t max_pkts;
+};
+
+struct tarpc_net_drv_recv_pkts_ts_out {
+    struct tarpc_out_arg common;
+
+    struct tarpc_net_drv_pkt_ts pkts<>;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_recv_pkts_groups_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    uint32_t time2wait;
+    string hw_ts_if<>;
+    uint32_t min_group_delay;
+    uint32_t exp_group_time;
+    uint32_t bucket_width;
+    uint32_t buckets_num;
+};
+
+struct tarpc_net_drv_recv_pkts_groups_out {
+    struct tarpc_out_arg common;
+
+    uint64_t n_groups;
+    uint64_t skipped_groups;
+    uint64_t avg_group_time;
+    uint64_t group_time_var;
+    uint32_t gap_hist<>;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_send_thread_stats {
+    uint64_t pkts;
+    uint64_t bytes;
+    uint64_t errors;
+};
+
+struct tarpc_net_drv_send_pkts_mt_in {
+    struct tarpc_in_arg common;
+
+    struct tarpc_sa src_addr;
+    struct tarpc_sa dst_addr;
+    tarpc_int cpus<>;
+    uint32_t pkt_size;
+    uint32_t burst;
+    uint64_t rate;
+    uint32_t time2run;
+};
+
+struct tarpc_net_drv_send_pkts_mt_out {
+    struct tarpc_out_arg common;
+
+    struct tarpc_net_drv_send_thread_stats stats<>;
+    int64_t retval;
+};
+
+/** Fields which can be collected by net_drv_capture_pkts() */
+enum tarpc_net_drv_capt_field {
+    TARPC_NET_DRV_CAPT_TS = 0x1,
+    TARPC_NET_DRV_CAPT_LEN = 0x2,
+    TARPC_NET_DRV_CAPT_VLAN = 0x4,
+    TARPC_NET_DRV_CAPT_TCP_SEQ = 0x8,
+    TARPC_NET_DRV_CAPT_TCP_LEN = 0x10,
+    TARPC_NET_DRV_CAPT_TCP_FLAGS = 0x20
+};
+
+struct tarpc_net_drv_bpf_insn {
+    uint16_t code;
+    uint8_t jt;
+    uint8_t jf;
+    uint32_t k;
+};
+
+struct tarpc_net_drv_capture_pkts_in {
+    struct tarpc_in_arg common;
+
+    string if_name<>;
+    struct tarpc_net_drv_bpf_insn filter<>;
+    uint32_t fields;
+    uint32_t time2run;
+    uint32_t max_pkts;
+};
+
+struct tarpc_net_drv_capture_pkts_out {
+    struct tarpc_out_arg common;
+
+    uint8_t records<>;
+    uint64_t drops;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_send_zc_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    uint32_t buf_size;
+    uint32_t time2run;
+    tarpc_bool zerocopy;
+};
+
+struct tarpc_net_drv_send_zc_out {
+    struct tarpc_out_arg common;
+
+    uint64_t calls;
+    uint64_t zc_completed;
+    uint64_t zc_copied;
+    uint64_t cpu_time;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_send_udp_gso_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    uint32_t buf_len;
+    uint32_t gso_size;
+    uint32_t time2run;
+    uint32_t max_calls;
+};
+
+struct tarpc_net_drv_send_udp_gso_out {
+    struct tarpc_out_arg common;
+
+    uint64_t calls;
+    uint64_t segs;
+    uint64_t cpu_time;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_recv_udp_gro_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    tarpc_bool gro;
+    uint32_t time2wait;
+};
+
+struct tarpc_net_drv_recv_udp_gro_out {
+    struct tarpc_out_arg common;
+
+    uint64_t segs;
+    uint64_t bytes;
+    uint64_t coalesced;
+    uint32_t max_segs;
+    uint32_t gso_size;
+    uint64_t gso_size_mismatch;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_pingpong_client_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    uint32_t msg_size;
+    uint32_t depth;
+    uint32_t time2run;
+    uint32_t percentiles<>;
+};
+
+struct tarpc_net_drv_pingpong_client_out {
+    struct tarpc_out_arg common;
+
+    uint64_t lost;
+    uint64_t min;
+    uint64_t max;
+    uint64_t mean;
+    uint64_t pct_values<>;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_pingpong_server_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    uint32_t msg_size;
+    uint32_t time2wait;
+};
+
+struct tarpc_net_drv_pingpong_server_out {
+    struct tarpc_out_arg common;
+
+    int64_t retval;
+};
+
+struct tarpc_net_drv_uring_send_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    uint32_t min_size;
+    uint32_t max_size;
+    uint32_t depth;
+    uint32_t time2run;
+    tarpc_bool ignore_err;
+};
+
+struct tarpc_net_drv_uring_send_out {
+    struct tarpc_out_arg common;
+
+    uint64_t completions;
+    uint64_t errors;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_uring_recv_in {
+    struct tarpc_in_arg common;
+
+    tarpc_int s;
+    uint32_t buf_size;
+    uint32_t bufs_num;
+    uint32_t time2run;
+};
+
+struct tarpc_net_drv_uring_recv_out {
+    struct tarpc_out_arg common;
+
+    uint64_t completions;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_napi_thread {
+    tarpc_int pid;
+    uint32_t napi_id;
+    uint64_t cpu_time;
+    uint64_t ts;
+    tarpc_int cpu;
+};
+
+struct tarpc_net_drv_napi_threads_in {
+    struct tarpc_in_arg common;
+
+    string if_name<>;
+    tarpc_int cpus<>;
+};
+
+struct tarpc_net_drv_napi_threads_out {
+    struct tarpc_out_arg common;
+
+    struct tarpc_net_drv_napi_thread threads<>;
+    int64_t retval;
+};
+
+/** Flags of AF_XDP sockets created by net_drv_xsk_batch() */
+enum tarpc_net_drv_xsk_flag {
+    TARPC_NET_DRV_XSK_COPY = 0x1,
+    TARPC_NET_DRV_XSK_ZEROCOPY = 0x2,
+    TARPC_NET_DRV_XSK_NEED_WAKEUP = 0x4
+};
+
+/** What net_drv_xsk_batch() does with received packets */
+enum tarpc_net_drv_xsk_mode {
+    TARPC_NET_DRV_XSK_RX_DROP = 0,
+    TARPC_NET_DRV_XSK_FWD = 1
+};
+
+struct tarpc_net_drv_xsk_queue_stats {
+    uint64_t rx_pkts;
+    uint64_t tx_pkts;
+    uint64_t wakeups;
+};
+
+struct tarpc_net_drv_xsk_batch_in {
+    struct tarpc_in_arg common;
+
+    string if_name<>;
+    tarpc_int map_fd;
+    uint32_t queues<>;
+    tarpc_int cpus<>;
+    uint32_t frame_size;
+    uint32_t frames_num;
+    uint32_t ring_size;
+    uint32_t flags;
+    tarpc_net_drv_xsk_mode mode;
+    uint32_t batch;
+    uint32_t time2run;
+};
+
+struct tarpc_net_drv_xsk_batch_out {
+    struct tarpc_out_arg common;
+
+    struct tarpc_net_drv_xsk_queue_stats stats<>;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_cps_thread_stats {
+    uint64_t conns;
+    uint64_t errors;
+};
+
+struct tarpc_net_drv_cps_client_in {
+    struct tarpc_in_arg common;
+
+    struct tarpc_sa dst_addr;
+    tarpc_int cpus<>;
+    uint32_t req_size;
+    uint32_t resp_size;
+    uint32_t time2run;
+};
+
+struct tarpc_net_drv_cps_client_out {
+    struct tarpc_out_arg common;
+
+    struct tarpc_net_drv_cps_thread_stats stats<>;
+    uint64_t syn_retrans;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_cps_server_in {
+    struct tarpc_in_arg common;
+
+    struct tarpc_sa addr;
+    tarpc_int cpus<>;
+    uint32_t req_size;
+    uint32_t resp_size;
+    uint32_t time2run;
+};
+
+struct tarpc_net_drv_cps_server_out {
+    struct tarpc_out_arg common;
+
+    struct tarpc_net_drv_cps_thread_stats stats<>;
+    int64_t retval;
+};
+
+struct tarpc_net_drv_page_pools_in {
+    struct tarpc_in_arg common;
+
+    string if_name<>;
+};
+
+struct tarpc_net_drv_page_pools_out {
+    struct tarpc_out_arg common;
+
+    uint64_t inflight;
+    uint64_t inflight_mem;
+    int64_t retval;
+};
+
 program net_drv_ts
 {
     version ver0
@@ -55,5 +440,22 @@ program net_drv_ts
         RPC_DEF(net_drv_too_many_rx_rules)
         RPC_DEF(net_drv_send_pkts_exact_delay)
         RPC_DEF(net_drv_recv_pkts_exact_delay)
+        RPC_DEF(net_drv_send_pkts_burst)
+        RPC_DEF(net_drv_recv_pkts_ts)
+        RPC_DEF(net_drv_recv_pkts_groups)
+        RPC_DEF(net_drv_send_pkts_mt)
+        RPC_DEF(net_drv_capture_pkts)
+        RPC_DEF(net_drv_send_zc)
+        RPC_DEF(net_drv_send_udp_gso)
+        RPC_DEF(net_drv_recv_udp_gro)
+        RPC_DEF(net_drv_pingpong_client)
+        RPC_DEF(net_drv_pingpong_server)
+        RPC_DEF(net_drv_uring_send)
+        RPC_DEF(net_drv_uring_recv)
+        RPC_DEF(net_drv_napi_threads)
+        RPC_DEF(net_drv_xsk_batch)
+        RPC_DEF(net_drv_cps_client)
+        RPC_DEF(net_drv_cps_server)
+        RPC_DEF(net_drv_page_pools)
     } = 1;
 } = 2;
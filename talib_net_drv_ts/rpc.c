@@ -13,13 +13,48 @@
 
 #include <linux/sockios.h>
 #include <byteswap.h>
+#include <ctype.h>
+#include <dirent.h>
 #include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <net/if.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <linux/filter.h>
+#include <netinet/ip.h>
+#include <netinet/ip6.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include <sys/syscall.h>
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#if __has_include(<linux/if_xdp.h>)
+#include <linux/if_xdp.h>
+#include <linux/bpf.h>
+#endif
+#if __has_include(<linux/netdev.h>)
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+#include <linux/netdev.h>
+#endif
+#endif
 
 #include "logger_api.h"
 #include "rpc_server.h"
 #include "tarpc.h"
 #include "te_errno.h"
 #include "te_alloc.h"
+#include "te_dbuf.h"
 #include "te_sockaddr.h"
 #include "te_str.h"
 #include "te_vector.h"
@@ -27,9 +62,98 @@
 #include "te_sleep.h"
 #include "te_time.h"
 
+/** Get current time of CLOCK_MONOTONIC_RAW in nanoseconds */
+static uint64_t
+get_mono_raw_ns(void)
+{
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts) != 0)
+        TE_FATAL_ERROR("clock_gettime() failed: %r", te_rc_os2te(errno));
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * Update latency statistics of Rx rules insertion or deletion.
+ *
+ * @param lat     Statistics to update.
+ * @param t       Duration of an operation, in nanoseconds.
+ */
+static void
+rx_rules_lat_update(tarpc_net_drv_rx_rules_lat *lat, uint64_t t)
+{
+    unsigned int bin = 0;
+    uint64_t us = t / 1000;
+
+    /*
+     * The first bin counts durations less than 1 microsecond, bin N
+     * counts durations in [2^(N-1), 2^N) microseconds, the last bin
+     * counts all the longer durations.
+     */
+    while (us > 0 && bin < TE_ARRAY_LEN(lat->hist) - 1)
+    {
+        us >>= 1;
+        bin++;
+    }
+
+    if (lat->count == 0 || t < lat->min)
+        lat->min = t;
+    if (t > lat->max)
+        lat->max = t;
+
+    lat->count++;
+    lat->total += t;
+    lat->hist[bin]++;
+}
+
+/**
+ * Get statistics bucket corresponding to a given Rx rules table fill
+ * level, allocating it if necessary.
+ *
+ * @param out         Where buckets are stored.
+ * @param bucket_size Number of fill levels covered by a bucket.
+ * @param level       Number of rules in the table before the operation.
+ *
+ * @return Pointer to the bucket or @c NULL if @p bucket_size is zero or
+ *         memory allocation failed.
+ */
+static tarpc_net_drv_rx_rules_bucket *
+rx_rules_bucket_get(tarpc_net_drv_too_many_rx_rules_out *out,
+                    unsigned int bucket_size, unsigned int level)
+{
+    tarpc_net_drv_rx_rules_bucket *buckets;
+    unsigned int idx;
+    unsigned int num;
+
+    if (bucket_size == 0)
+        return NULL;
+
+    idx = level / bucket_size;
+    num = out->buckets.buckets_len;
+    if (idx >= num)
+    {
+        buckets = realloc(out->buckets.buckets_val,
+                          (idx + 1) * sizeof(*buckets));
+        if (buckets == NULL)
+        {
+            ERROR("%s(): failed to allocate memory for statistics",
+                  __FUNCTION__);
+            return NULL;
+        }
+
+        memset(&buckets[num], 0, (idx + 1 - num) * sizeof(*buckets));
+        out->buckets.buckets_val = buckets;
+        out->buckets.buckets_len = idx + 1;
+    }
+
+    return &out->buckets.buckets_val[idx];
+}
+
 /*
  * Create a lot of Rx classification rules until trying to add the next
- * rule fails. Then remove all the added rules.
+ * rule fails. Then remove all the added rules. Measure how long every
+ * insertion and deletion takes.
  */
 static int
 too_many_rx_rules(tarpc_net_drv_too_many_rx_rules_in *in,
@@ -47,6 +171,11 @@ too_many_rx_rules(tarpc_net_drv_too_many_rx_rules_in *in,
     uint32_t real_loc;
     uint32_t *loc_ptr;
 
+    tarpc_net_drv_rx_rules_bucket *bucket;
+    uint64_t op_start;
+    uint64_t op_time;
+    unsigned int level;
+
     te_errno err;
     int rc = 0;
     int result = 0;
@@ -162,13 +291,20 @@ too_many_rx_rules(tarpc_net_drv_too_many_rx_rules_in *in,
                 ip6_spec->pdst = htons(dst_port);
             }
 
+            op_start = get_mono_raw_ns();
             rc = ioctl(in->fd, SIOCETHTOOL, &ifr);
+            op_time = get_mono_raw_ns() - op_start;
             if (rc < 0)
             {
                 out->add_errno = te_rc_os2te(errno);
                 goto finish;
             }
 
+            out->ins_time += op_time;
+            bucket = rx_rules_bucket_get(out, in->bucket_size, rules_count);
+            if (bucket != NULL)
+                rx_rules_lat_update(&bucket->ins, op_time);
+
             real_loc = rule.fs.location;
             err = TE_VEC_APPEND(&added_rules, real_loc);
             if (err != 0)
@@ -191,11 +327,24 @@ finish:
     memset(&rule.fs.m_u, 0, sizeof(rule.fs.m_u));
     rule.cmd = ETHTOOL_SRXCLSRLDEL;
 
+    level = rules_count;
     TE_VEC_FOREACH(&added_rules, loc_ptr)
     {
         rule.fs.location = *loc_ptr;
+        op_start = get_mono_raw_ns();
         rc = ioctl(in->fd, SIOCETHTOOL, &ifr);
-        if (rc < 0)
+        op_time = get_mono_raw_ns() - op_start;
+        if (rc >= 0)
+        {
+            out->del_time += op_time;
+            out->del_count++;
+            bucket = rx_rules_bucket_get(out, in->bucket_size, level);
+            if (bucket != NULL)
+                rx_rules_lat_update(&bucket->del, op_time);
+
+            level--;
+        }
+        else
         {
             err = te_rc_os2te(errno);
             te_rpc_error_set(TE_RC(TE_TA_UNIX, err),
@@ -234,6 +383,18 @@ typedef struct net_drv_exact_delay_payload {
     uint8_t last_byte;
 } __attribute__((packed)) net_drv_exact_delay_payload;
 
+/** Last byte of payload of a packet sent in time */
+#define NET_DRV_PLD_LAST_BYTE 0xff
+
+/** Last byte of payload of a packet sent after unexpectedly big delay */
+#define NET_DRV_PLD_LAST_BYTE_DELAYED 0xfe
+
+/**
+ * Delay before a packet is unexpectedly big if it is this number of
+ * times longer than the requested one.
+ */
+#define NET_DRV_SEND_DELAYED_FACTOR 5
+
 static int64_t
 send_pkts_exact_delay(tarpc_net_drv_send_pkts_exact_delay_in *in)
 {
@@ -247,13 +408,12 @@ send_pkts_exact_delay(tarpc_net_drv_send_pkts_exact_delay_in *in)
     struct timeval tv_now;
     long int time_diff = 0;
     long int exp_diff = 0;
+    long int prev_diff = 0;
 
     rc = te_gettimeofday(&tv_start, NULL);
     if (rc != 0)
         TE_FATAL_ERROR("gettimeofday() failed: %r", rc);
 
-    pld.last_byte = 0xff;
-
     while (TRUE)
     {
         if (swap_required)
@@ -289,6 +449,19 @@ send_pkts_exact_delay(tarpc_net_drv_send_pkts_exact_delay_in *in)
         if (TE_US2MS(time_diff) > in->time2run)
             break;
 
+        /*
+         * Mark packets sent after unexpectedly big delay so that
+         * receiver can take it into account.
+         */
+        if (id > 0 && in->delay > 0 &&
+            time_diff - prev_diff >
+                    (long int)in->delay * NET_DRV_SEND_DELAYED_FACTOR)
+            pld.last_byte = NET_DRV_PLD_LAST_BYTE_DELAYED;
+        else
+            pld.last_byte = NET_DRV_PLD_LAST_BYTE;
+
+        prev_diff = time_diff;
+
         os_rc = send(in->s, &pld, sizeof(pld), 0);
         if (os_rc < 0)
         {
@@ -314,13 +487,166 @@ TARPC_FUNC_STANDALONE(net_drv_send_pkts_exact_delay, {},
     MAKE_CALL(out->retval = send_pkts_exact_delay(in));
 })
 
+/** Maximum number of packets passed to a single sendmmsg() call */
+#define NET_DRV_MAX_BURST 1024
+
 static int64_t
-recv_pkts_exact_delay(tarpc_net_drv_recv_pkts_exact_delay_in *in)
+send_pkts_burst(tarpc_net_drv_send_pkts_burst_in *in)
 {
+    net_drv_exact_delay_payload plds[NET_DRV_MAX_BURST];
+    struct iovec iovs[NET_DRV_MAX_BURST];
+    struct mmsghdr msgs[NET_DRV_MAX_BURST];
+    te_bool swap_required = (htonl(1) != 1);
+    uint64_t time2run_ns = (uint64_t)in->time2run * 1000000ULL;
     uint64_t id = 0;
+    uint64_t burst_idx = 0;
+    uint64_t start;
+    uint64_t now;
+    uint64_t prev = 0;
+    unsigned int sent;
+    unsigned int i;
+    int os_rc;
+
+    if (in->burst == 0 || in->burst > NET_DRV_MAX_BURST)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "burst size must be in range [1, %u]",
+                         NET_DRV_MAX_BURST);
+        return -1;
+    }
+
+    memset(msgs, 0, sizeof(msgs));
+    for (i = 0; i < in->burst; i++)
+    {
+        plds[i].last_byte = NET_DRV_PLD_LAST_BYTE;
+        iovs[i].iov_base = &plds[i];
+        iovs[i].iov_len = sizeof(plds[i]);
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    start = get_mono_raw_ns();
+
+    while (TRUE)
+    {
+        /*
+         * Send bursts at moments 0, g, 2g, 3g, ... where g is the
+         * requested gap. As in send_pkts_exact_delay(), missed moments
+         * are skipped rather than sent back-to-back. Busy loop is used
+         * since sleeping is too imprecise for microsecond gaps.
+         */
+        while (TRUE)
+        {
+            now = get_mono_raw_ns() - start;
+            if (in->gap == 0 || now >= burst_idx * in->gap)
+                break;
+        }
+
+        if (now > time2run_ns)
+            break;
+
+        if (in->gap > 0)
+            burst_idx = now / in->gap + 1;
+
+        for (i = 0; i < in->burst; i++)
+        {
+            if (swap_required)
+                plds[i].id = bswap_64(id + i);
+            else
+                plds[i].id = id + i;
+        }
+
+        /*
+         * Mark the first packet of a burst sent after unexpectedly
+         * big delay so that receiver can take it into account.
+         */
+        if (id > 0 && in->gap > 0 &&
+            now - prev > in->gap * NET_DRV_SEND_DELAYED_FACTOR)
+            plds[0].last_byte = NET_DRV_PLD_LAST_BYTE_DELAYED;
+        else
+            plds[0].last_byte = NET_DRV_PLD_LAST_BYTE;
+
+        prev = now;
+
+        for (sent = 0; sent < in->burst; sent += os_rc)
+        {
+            os_rc = sendmmsg(in->s, msgs + sent, in->burst - sent, 0);
+            if (os_rc < 0)
+            {
+                te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                                 "sendmmsg() failed");
+                return -1;
+            }
+
+            for (i = sent; i < sent + (unsigned int)os_rc; i++)
+            {
+                if (msgs[i].msg_len != sizeof(plds[i]))
+                {
+                    te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EMSGSIZE),
+                                     "sendmmsg() sent incorrect number "
+                                     "of bytes");
+                    return -1;
+                }
+            }
+        }
+
+        id += in->burst;
+    }
+
+    return id;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_send_pkts_burst, {},
+{
+    MAKE_CALL(out->retval = send_pkts_burst(in));
+})
+
+/**
+ * Check that a packet sent by send_pkts_exact_delay() or send_pkts_burst()
+ * is not reordered or duplicated with respect to the previously received
+ * one.
+ *
+ * @param pld         Received payload.
+ * @param last_id     Id of the previously received packet (@c -1 if there
+ *                    was no such packet), updated on success.
+ *
+ * @return @c 0 on success, @c -1 on failure (RPC error is set).
+ */
+static int
+exact_delay_check_pld(const net_drv_exact_delay_payload *pld,
+                      int64_t *last_id)
+{
+    uint64_t id;
+
+    if (htonl(1) != 1)
+        id = bswap_64(pld->id);
+    else
+        id = pld->id;
+
+    if ((int64_t)id < *last_id)
+    {
+        ERROR("Packet %ju was received after packet %ju",
+              (uintmax_t)id, (uintmax_t)*last_id);
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EILSEQ),
+                         "received packet is out of order");
+        return -1;
+    }
+    else if ((int64_t)id == *last_id)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EILSEQ),
+                         "received packet is a duplicate");
+        return -1;
+    }
+
+    *last_id = id;
+    return 0;
+}
+
+static int64_t
+recv_pkts_exact_delay(tarpc_net_drv_recv_pkts_exact_delay_in *in)
+{
     int64_t last_id = -1;
     uint64_t pkts_count = 0;
-    te_bool swap_required = (htonl(1) != 1);
     net_drv_exact_delay_payload pld;
     int os_rc;
     struct pollfd pfd;
@@ -364,27 +690,9 @@ recv_pkts_exact_delay(tarpc_net_drv_recv_pkts_exact_delay_in *in)
             return -1;
         }
 
-        if (swap_required)
-            id = bswap_64(pld.id);
-        else
-            id = pld.id;
-
-        if ((int64_t)id < last_id)
-        {
-            ERROR("Packet %ju was received after packet %ju",
-                  (uintmax_t)id, (uintmax_t)last_id);
-            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EILSEQ),
-                             "received packet is out of order");
+        if (exact_delay_check_pld(&pld, &last_id) < 0)
             return -1;
-        }
-        else if (id == last_id)
-        {
-            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EILSEQ),
-                             "received packet is a duplicate");
-            return -1;
-        }
 
-        last_id = id;
         pkts_count++;
     }
 
@@ -395,3 +703,4288 @@ TARPC_FUNC_STANDALONE(net_drv_recv_pkts_exact_delay, {},
 {
     MAKE_CALL(out->retval = recv_pkts_exact_delay(in));
 })
+
+/** Maximum number of packets retrieved by a single recvmmsg() call */
+#define NET_DRV_MAX_RECV_BATCH 64
+
+/** Size of control data buffer for a single received packet */
+#define NET_DRV_TS_CMSG_LEN CMSG_SPACE(sizeof(struct scm_timestamping))
+
+/**
+ * Get Rx timestamp of a packet from control messages.
+ *
+ * @param msg     Received message.
+ * @param hw_ts   If @c TRUE, get hardware timestamp, otherwise software
+ *                one.
+ * @param ts      Where to save timestamp, in nanoseconds.
+ *
+ * @return @c 0 on success, @c -1 if timestamp is not found.
+ */
+static int
+get_rx_ts(struct msghdr *msg, te_bool hw_ts, uint64_t *ts)
+{
+    struct cmsghdr *cmsg;
+    struct scm_timestamping *tss;
+    struct timespec *tsp;
+
+    for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL;
+         cmsg = CMSG_NXTHDR(msg, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET ||
+            cmsg->cmsg_type != SCM_TIMESTAMPING)
+            continue;
+
+        tss = (struct scm_timestamping *)CMSG_DATA(cmsg);
+        /*
+         * Software timestamp is in the first element,
+         * raw hardware one - in the third element.
+         */
+        tsp = &tss->ts[hw_ts ? 2 : 0];
+        if (tsp->tv_sec == 0 && tsp->tv_nsec == 0)
+            return -1;
+
+        *ts = (uint64_t)tsp->tv_sec * 1000000000ULL + tsp->tv_nsec;
+        return 0;
+    }
+
+    return -1;
+}
+
+/**
+ * Enable hardware timestamping of all received packets on an interface.
+ *
+ * @param s         Socket on which to call ioctl().
+ * @param if_name   Interface name.
+ * @param saved     Where to save the previous configuration.
+ *
+ * @return @c 0 on success, @c -1 on failure (RPC error is set).
+ */
+static int
+hwtstamp_rx_enable(int s, const char *if_name,
+                   struct hwtstamp_config *saved)
+{
+    struct hwtstamp_config cfg;
+    struct ifreq ifr;
+
+    memset(&ifr, 0, sizeof(ifr));
+    TE_STRLCPY(ifr.ifr_name, if_name, sizeof(ifr.ifr_name));
+
+    memset(saved, 0, sizeof(*saved));
+    ifr.ifr_data = (caddr_t)saved;
+    if (ioctl(s, SIOCGHWTSTAMP, &ifr) < 0)
+    {
+        /*
+         * SIOCGHWTSTAMP is not supported by old kernels and some
+         * drivers; timestamping is disabled by default then.
+         */
+        memset(saved, 0, sizeof(*saved));
+        saved->tx_type = HWTSTAMP_TX_OFF;
+        saved->rx_filter = HWTSTAMP_FILTER_NONE;
+    }
+
+    cfg = *saved;
+    cfg.rx_filter = HWTSTAMP_FILTER_ALL;
+    ifr.ifr_data = (caddr_t)&cfg;
+    if (ioctl(s, SIOCSHWTSTAMP, &ifr) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to enable hardware Rx timestamping "
+                         "on %s", if_name);
+        return -1;
+    }
+
+    if (cfg.rx_filter != HWTSTAMP_FILTER_ALL)
+    {
+        ifr.ifr_data = (caddr_t)saved;
+        if (ioctl(s, SIOCSHWTSTAMP, &ifr) < 0)
+        {
+            ERROR("Failed to restore hardware timestamping "
+                  "configuration of %s, errno=%r", if_name,
+                  te_rc_os2te(errno));
+        }
+
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EOPNOTSUPP),
+                         "%s cannot timestamp all received packets",
+                         if_name);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Restore hardware timestamping configuration of an interface.
+ *
+ * @param s         Socket on which to call ioctl().
+ * @param if_name   Interface name.
+ * @param saved     Configuration to restore.
+ */
+static void
+hwtstamp_restore(int s, const char *if_name, struct hwtstamp_config *saved)
+{
+    struct ifreq ifr;
+
+    memset(&ifr, 0, sizeof(ifr));
+    TE_STRLCPY(ifr.ifr_name, if_name, sizeof(ifr.ifr_name));
+    ifr.ifr_data = (caddr_t)saved;
+
+    if (ioctl(s, SIOCSHWTSTAMP, &ifr) < 0)
+    {
+        ERROR("Failed to restore hardware timestamping configuration "
+              "of %s, errno=%r", if_name, te_rc_os2te(errno));
+    }
+}
+
+/**
+ * Callback processing a received packet.
+ *
+ * @param id        Packet Id.
+ * @param ts        Rx timestamp, in nanoseconds.
+ * @param delayed   Whether the packet was sent after unexpectedly big
+ *                  delay.
+ * @param data      User data.
+ *
+ * @return @c 0 on success, @c -1 on failure (RPC error should be set).
+ */
+typedef int (*recv_ts_cb)(uint64_t id, uint64_t ts, te_bool delayed,
+                          void *data);
+
+/**
+ * Receive and check packets sent by send_pkts_exact_delay() or
+ * send_pkts_burst() with recvmmsg(), get Rx timestamp of every packet
+ * and pass it to a callback.
+ *
+ * @param s           Socket FD.
+ * @param time2wait   How long to wait for new data, in milliseconds.
+ * @param hw_ts_if    If not empty, enable hardware Rx timestamping on
+ *                    this interface for the duration of the call and use
+ *                    hardware timestamps. Otherwise use software ones.
+ * @param cb          Callback to call for every packet.
+ * @param cb_data     Data passed to the callback.
+ *
+ * @return Number of received packets on success, @c -1 on failure.
+ */
+static int64_t
+recv_pkts_ts_gen(int s, unsigned int time2wait, const char *hw_ts_if,
+                 recv_ts_cb cb, void *cb_data)
+{
+    te_bool hw_ts = (hw_ts_if != NULL && *hw_ts_if != '\0');
+    struct hwtstamp_config hwts_saved;
+    net_drv_exact_delay_payload plds[NET_DRV_MAX_RECV_BATCH];
+    struct iovec iovs[NET_DRV_MAX_RECV_BATCH];
+    struct mmsghdr msgs[NET_DRV_MAX_RECV_BATCH];
+    uint8_t cmsg_bufs[NET_DRV_MAX_RECV_BATCH][NET_DRV_TS_CMSG_LEN];
+    int64_t last_id = -1;
+    int64_t pkts_count = 0;
+    int64_t result = -1;
+    uint64_t ts;
+    struct pollfd pfd;
+    int ts_flags;
+    int os_rc;
+    int i;
+
+    if (hw_ts)
+    {
+        if (hwtstamp_rx_enable(s, hw_ts_if, &hwts_saved) < 0)
+            return -1;
+
+        ts_flags = SOF_TIMESTAMPING_RX_HARDWARE |
+                   SOF_TIMESTAMPING_RAW_HARDWARE;
+    }
+    else
+    {
+        ts_flags = SOF_TIMESTAMPING_RX_SOFTWARE |
+                   SOF_TIMESTAMPING_SOFTWARE;
+    }
+
+    if (setsockopt(s, SOL_SOCKET, SO_TIMESTAMPING, &ts_flags,
+                   sizeof(ts_flags)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to enable SO_TIMESTAMPING");
+        if (hw_ts)
+            hwtstamp_restore(s, hw_ts_if, &hwts_saved);
+        return -1;
+    }
+
+    memset(&pfd, 0, sizeof(pfd));
+    pfd.fd = s;
+    pfd.events = POLLIN;
+
+    while (TRUE)
+    {
+        os_rc = poll(&pfd, 1, time2wait);
+        if (os_rc < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "poll() failed");
+            goto finish;
+        }
+        else if (os_rc == 0)
+        {
+            break;
+        }
+        else if (pfd.revents != POLLIN)
+        {
+            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EFAIL),
+                             "poll() returned unexpected events");
+            goto finish;
+        }
+
+        memset(msgs, 0, sizeof(msgs));
+        for (i = 0; i < NET_DRV_MAX_RECV_BATCH; i++)
+        {
+            iovs[i].iov_base = &plds[i];
+            iovs[i].iov_len = sizeof(plds[i]);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = cmsg_bufs[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(cmsg_bufs[i]);
+        }
+
+        os_rc = recvmmsg(s, msgs, NET_DRV_MAX_RECV_BATCH,
+                         MSG_DONTWAIT, NULL);
+        if (os_rc < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "recvmmsg() failed");
+            goto finish;
+        }
+
+        for (i = 0; i < os_rc; i++)
+        {
+            if (msgs[i].msg_len != sizeof(plds[i]))
+            {
+                te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EMSGSIZE),
+                                 "recvmmsg() returned packet of "
+                                 "incorrect size");
+                goto finish;
+            }
+
+            if (exact_delay_check_pld(&plds[i], &last_id) < 0)
+                goto finish;
+
+            if (get_rx_ts(&msgs[i].msg_hdr, hw_ts, &ts) < 0)
+            {
+                te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOENT),
+                                 "no %s Rx timestamp for a packet",
+                                 hw_ts ? "hardware" : "software");
+                goto finish;
+            }
+
+            pkts_count++;
+
+            if (cb(last_id, ts,
+                   plds[i].last_byte == NET_DRV_PLD_LAST_BYTE_DELAYED,
+                   cb_data) < 0)
+                goto finish;
+        }
+    }
+
+    result = pkts_count;
+
+finish:
+
+    ts_flags = 0;
+    if (setsockopt(s, SOL_SOCKET, SO_TIMESTAMPING, &ts_flags,
+                   sizeof(ts_flags)) < 0)
+    {
+        ERROR("Failed to disable SO_TIMESTAMPING, errno=%r",
+              te_rc_os2te(errno));
+    }
+
+    if (hw_ts)
+        hwtstamp_restore(s, hw_ts_if, &hwts_saved);
+
+    return result;
+}
+
+/** Data for recv_pkts_ts_store_cb() */
+typedef struct recv_pkts_ts_store {
+    /** Maximum number of stored timestamps (@c 0 - unlimited) */
+    unsigned int max_pkts;
+    /** Array of stored timestamps */
+    tarpc_net_drv_pkt_ts *pkts;
+    /** Number of stored timestamps */
+    unsigned int pkts_num;
+    /** Number of allocated elements in pkts array */
+    unsigned int pkts_max;
+} recv_pkts_ts_store;
+
+/** Callback storing Rx timestamps in array */
+static int
+recv_pkts_ts_store_cb(uint64_t id, uint64_t ts, te_bool delayed,
+                      void *data)
+{
+    recv_pkts_ts_store *store = data;
+    tarpc_net_drv_pkt_ts *new_pkts;
+
+    UNUSED(delayed);
+
+    if (store->max_pkts != 0 && store->pkts_num >= store->max_pkts)
+        return 0;
+
+    if (store->pkts_num == store->pkts_max)
+    {
+        store->pkts_max = (store->pkts_max == 0 ? 1024 :
+                           store->pkts_max * 2);
+        new_pkts = realloc(store->pkts,
+                           store->pkts_max * sizeof(*new_pkts));
+        if (new_pkts == NULL)
+        {
+            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                             "failed to allocate memory for timestamps");
+            return -1;
+        }
+        store->pkts = new_pkts;
+    }
+
+    store->pkts[store->pkts_num].id = id;
+    store->pkts[store->pkts_num].ts = ts;
+    store->pkts_num++;
+
+    return 0;
+}
+
+static int64_t
+recv_pkts_ts(tarpc_net_drv_recv_pkts_ts_in *in,
+             tarpc_net_drv_recv_pkts_ts_out *out)
+{
+    recv_pkts_ts_store store = { .max_pkts = in->max_pkts };
+    int64_t result;
+
+    result = recv_pkts_ts_gen(in->s, in->time2wait, in->hw_ts_if,
+                              recv_pkts_ts_store_cb, &store);
+    if (result < 0)
+    {
+        free(store.pkts);
+        return result;
+    }
+
+    out->pkts.pkts_val = store.pkts;
+    out->pkts.pkts_len = store.pkts_num;
+    return result;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_recv_pkts_ts, {},
+{
+    MAKE_CALL(out->retval = recv_pkts_ts(in, out));
+})
+
+/** Data for recv_pkts_groups_cb() */
+typedef struct pkt_groups_stats {
+    /** Minimum delay separating packet groups, in nanoseconds */
+    uint64_t min_group_delay;
+    /** Expected duration of a packet group, in nanoseconds */
+    uint64_t exp_group_time;
+    /** Width of a bucket in histogram of gaps, in nanoseconds */
+    uint64_t bucket_width;
+    /**
+     * Whether a packet sent after unexpectedly big delay was received
+     * in the current group after its first packet
+     */
+    te_bool delayed;
+
+    /** Number of processed packets */
+    uint64_t n_pkts;
+    /** Timestamp of the previous packet */
+    uint64_t prev_ts;
+    /** Timestamp of the first packet in the current group */
+    uint64_t cur_group_ts;
+
+    /** Number of finished packet groups */
+    uint64_t n_groups;
+    /** Number of packet groups ignored due to delays on sender */
+    uint64_t skipped_groups;
+    /** Total duration of finished packet groups, in nanoseconds */
+    double total_groups_time;
+    /**
+     * Sum of squared deviations of group durations from the
+     * expected one
+     */
+    double squared_dev_sum;
+    /** Histogram of gaps between groups */
+    uint32_t *gap_hist;
+    /** Number of buckets in gap_hist */
+    unsigned int gap_hist_len;
+} pkt_groups_stats;
+
+/** Callback detecting packet groups separated by big gaps */
+static int
+recv_pkts_groups_cb(uint64_t id, uint64_t ts, te_bool delayed,
+                    void *data)
+{
+    pkt_groups_stats *grp = data;
+    uint64_t gap;
+    uint64_t bucket;
+    double duration_dev;
+
+    UNUSED(id);
+
+    grp->n_pkts++;
+    if (grp->n_pkts == 1)
+    {
+        grp->prev_ts = ts;
+        grp->cur_group_ts = ts;
+        return 0;
+    }
+
+    gap = (ts > grp->prev_ts ? ts - grp->prev_ts : 0);
+    grp->prev_ts = ts;
+    if (gap <= grp->min_group_delay)
+    {
+        if (delayed)
+            grp->delayed = TRUE;
+
+        return 0;
+    }
+
+    if (delayed || grp->delayed)
+    {
+        /*
+         * If the current packet or a packet in the last group
+         * was sent after an unexpectedly big delay, it is hard to
+         * estimate real duration of the last packet group, so
+         * ignore it.
+         */
+        grp->delayed = FALSE;
+        grp->skipped_groups++;
+        grp->cur_group_ts = ts;
+        return 0;
+    }
+
+    /*
+     * Group duration is measured between the first packets of
+     * subsequent groups, the same way as rx_path/rx_coalesce_usecs
+     * does it.
+     */
+    grp->n_groups++;
+    grp->total_groups_time += ts - grp->cur_group_ts;
+    duration_dev = (double)(ts - grp->cur_group_ts) -
+                   (double)grp->exp_group_time;
+    grp->squared_dev_sum += duration_dev * duration_dev;
+    grp->cur_group_ts = ts;
+
+    if (grp->gap_hist_len > 0)
+    {
+        bucket = (gap - grp->min_group_delay) / grp->bucket_width;
+        if (bucket >= grp->gap_hist_len)
+            bucket = grp->gap_hist_len - 1;
+
+        grp->gap_hist[bucket]++;
+    }
+
+    return 0;
+}
+
+static int64_t
+recv_pkts_groups(tarpc_net_drv_recv_pkts_groups_in *in,
+                 tarpc_net_drv_recv_pkts_groups_out *out)
+{
+    pkt_groups_stats grp;
+    int64_t result;
+
+    memset(&grp, 0, sizeof(grp));
+    grp.min_group_delay = (uint64_t)in->min_group_delay * 1000;
+    grp.exp_group_time = (uint64_t)in->exp_group_time * 1000;
+    grp.bucket_width = (uint64_t)in->bucket_width * 1000;
+    grp.gap_hist_len = in->buckets_num;
+
+    if (grp.gap_hist_len > 0)
+    {
+        if (grp.bucket_width == 0)
+        {
+            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                             "histogram bucket width must not be zero");
+            return -1;
+        }
+
+        grp.gap_hist = calloc(grp.gap_hist_len, sizeof(*grp.gap_hist));
+        if (grp.gap_hist == NULL)
+        {
+            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                             "failed to allocate histogram");
+            return -1;
+        }
+    }
+
+    result = recv_pkts_ts_gen(in->s, in->time2wait, in->hw_ts_if,
+                              recv_pkts_groups_cb, &grp);
+    if (result < 0)
+    {
+        free(grp.gap_hist);
+        return result;
+    }
+
+    out->n_groups = grp.n_groups;
+    out->skipped_groups = grp.skipped_groups;
+    if (grp.n_groups > 0)
+    {
+        out->avg_group_time = grp.total_groups_time / grp.n_groups;
+        out->group_time_var = grp.squared_dev_sum / grp.n_groups;
+    }
+
+    out->gap_hist.gap_hist_val = grp.gap_hist;
+    out->gap_hist.gap_hist_len = grp.gap_hist_len;
+    return result;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_recv_pkts_groups, {},
+{
+    MAKE_CALL(out->retval = recv_pkts_groups(in, out));
+})
+
+/** Maximum size of a packet sent by net_drv_send_pkts_mt() */
+#define NET_DRV_MT_MAX_PKT_SIZE 65507
+
+/** Context of a sender thread of net_drv_send_pkts_mt() */
+typedef struct send_pkts_mt_thread {
+    pthread_t tid;              /**< Thread ID */
+    te_bool started;            /**< Whether the thread was started */
+    int cpu;                    /**< CPU to which to bind the thread */
+    int s;                      /**< Connected UDP socket */
+    void *pld;                  /**< Payload (shared by all threads) */
+    unsigned int burst;         /**< Number of packets per sendmmsg() */
+    unsigned int pkt_size;      /**< Payload size */
+    uint64_t gap;               /**< Interval between starts of
+                                     subsequent bursts (in ns, @c 0 -
+                                     send bursts back to back) */
+    uint64_t end;               /**< When to stop sending (in ns) */
+    te_errno rc;                /**< Error occurred in the thread */
+
+    /** Where to save packets statistics */
+    tarpc_net_drv_send_thread_stats *stats;
+} send_pkts_mt_thread;
+
+/* Main function of a sender thread of net_drv_send_pkts_mt() */
+static void *
+send_pkts_mt_thread_main(void *arg)
+{
+    send_pkts_mt_thread *th = arg;
+    struct mmsghdr *msgs;
+    struct iovec iov;
+    cpu_set_t cpuset;
+    uint64_t burst_idx = 0;
+    uint64_t start;
+    uint64_t now;
+    unsigned int i;
+    int os_rc;
+
+    if (th->cpu >= 0)
+    {
+        CPU_ZERO(&cpuset);
+        CPU_SET(th->cpu, &cpuset);
+        os_rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset),
+                                       &cpuset);
+        if (os_rc != 0)
+        {
+            th->rc = te_rc_os2te(os_rc);
+            ERROR("%s(): failed to bind thread to CPU %d: %r",
+                  __FUNCTION__, th->cpu, th->rc);
+            return NULL;
+        }
+    }
+
+    /*
+     * sendmmsg() writes msg_len of every message, so messages are
+     * allocated by every thread on its own CPU (after binding to it)
+     * rather than shared. The payload is only read and may be shared.
+     */
+    msgs = calloc(th->burst, sizeof(*msgs));
+    if (msgs == NULL)
+    {
+        th->rc = TE_ENOMEM;
+        ERROR("%s(): failed to allocate messages", __FUNCTION__);
+        return NULL;
+    }
+
+    iov.iov_base = th->pld;
+    iov.iov_len = th->pkt_size;
+    for (i = 0; i < th->burst; i++)
+    {
+        msgs[i].msg_hdr.msg_iov = &iov;
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    start = get_mono_raw_ns();
+    while ((now = get_mono_raw_ns()) < th->end)
+    {
+        /*
+         * If sending rate is limited, send bursts at moments
+         * start + k * gap, skipping missed moments as
+         * send_pkts_burst() does.
+         */
+        if (th->gap > 0)
+        {
+            if (now - start < burst_idx * th->gap)
+                continue;
+
+            burst_idx = (now - start) / th->gap + 1;
+        }
+
+        os_rc = sendmmsg(th->s, msgs, th->burst, 0);
+        if (os_rc < 0)
+        {
+            /*
+             * Errors like ENOBUFS are expected when trying to
+             * saturate a link, just count them.
+             */
+            th->stats->errors++;
+            continue;
+        }
+
+        th->stats->pkts += os_rc;
+        th->stats->bytes += (uint64_t)os_rc * th->pkt_size;
+    }
+
+    free(msgs);
+    return NULL;
+}
+
+/*
+ * Create a connected UDP socket for a sender thread. Source port is
+ * incremented by thread index so that every thread sends its own flow.
+ */
+static int
+send_pkts_mt_socket(const struct sockaddr *src_addr,
+                    const struct sockaddr *dst_addr,
+                    unsigned int idx)
+{
+    struct sockaddr_storage addr;
+    uint16_t port;
+    int s;
+
+    memcpy(&addr, src_addr, te_sockaddr_get_size(src_addr));
+    port = ntohs(te_sockaddr_get_port(src_addr));
+    if (port != 0)
+        te_sockaddr_set_port(SA(&addr), htons(port + idx));
+
+    s = socket(src_addr->sa_family, SOCK_DGRAM, 0);
+    if (s < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to create socket");
+        return -1;
+    }
+
+    if (bind(s, SA(&addr), te_sockaddr_get_size(SA(&addr))) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to bind socket");
+        close(s);
+        return -1;
+    }
+
+    if (connect(s, dst_addr, te_sockaddr_get_size(dst_addr)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to connect socket");
+        close(s);
+        return -1;
+    }
+
+    return s;
+}
+
+/*
+ * Send UDP packets from multiple threads, each bound to its own CPU
+ * and sending over its own socket.
+ */
+static int64_t
+send_pkts_mt(tarpc_net_drv_send_pkts_mt_in *in,
+             tarpc_net_drv_send_pkts_mt_out *out)
+{
+    unsigned int threads_num = in->cpus.cpus_len;
+    send_pkts_mt_thread *threads = NULL;
+    tarpc_net_drv_send_thread_stats *stats = NULL;
+    uint8_t *pld = NULL;
+    uint64_t gap = 0;
+    uint64_t end;
+    int64_t result = 0;
+    unsigned int i;
+    te_errno err;
+    int os_rc;
+
+    struct sockaddr_storage src_addr_st;
+    struct sockaddr_storage dst_addr_st;
+    struct sockaddr *src_addr = SA(&src_addr_st);
+    struct sockaddr *dst_addr = SA(&dst_addr_st);
+
+    if (threads_num == 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "no CPUs specified for sender threads");
+        return -1;
+    }
+
+    if (in->burst == 0 || in->burst > NET_DRV_MAX_BURST)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "burst size must be in range [1, %u]",
+                         NET_DRV_MAX_BURST);
+        return -1;
+    }
+
+    if (in->pkt_size == 0 || in->pkt_size > NET_DRV_MT_MAX_PKT_SIZE)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "packet size must be in range [1, %u]",
+                         NET_DRV_MT_MAX_PKT_SIZE);
+        return -1;
+    }
+
+    err = sockaddr_rpc2h(&in->src_addr, src_addr, sizeof(src_addr_st),
+                         NULL, NULL);
+    if (err == 0)
+    {
+        err = sockaddr_rpc2h(&in->dst_addr, dst_addr, sizeof(dst_addr_st),
+                             NULL, NULL);
+    }
+    if (err != 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, err),
+                         "failed to convert addresses");
+        return -1;
+    }
+
+    threads = calloc(threads_num, sizeof(*threads));
+    stats = calloc(threads_num, sizeof(*stats));
+    pld = calloc(1, in->pkt_size);
+    if (threads == NULL || stats == NULL || pld == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate memory");
+        result = -1;
+        goto finish;
+    }
+
+    for (i = 0; i < threads_num; i++)
+        threads[i].s = -1;
+
+    for (i = 0; i < threads_num; i++)
+    {
+        threads[i].s = send_pkts_mt_socket(src_addr, dst_addr, i);
+        if (threads[i].s < 0)
+        {
+            result = -1;
+            goto finish;
+        }
+    }
+
+    /*
+     * Requested rate is shared equally between threads, every thread
+     * sends a burst once per gap.
+     */
+    if (in->rate > 0)
+        gap = (uint64_t)in->burst * threads_num * 1000000000ULL / in->rate;
+
+    end = get_mono_raw_ns() + (uint64_t)in->time2run * 1000000ULL;
+    for (i = 0; i < threads_num; i++)
+    {
+        threads[i].cpu = in->cpus.cpus_val[i];
+        threads[i].pld = pld;
+        threads[i].burst = in->burst;
+        threads[i].pkt_size = in->pkt_size;
+        threads[i].gap = gap;
+        threads[i].end = end;
+        threads[i].stats = &stats[i];
+
+        os_rc = pthread_create(&threads[i].tid, NULL,
+                               send_pkts_mt_thread_main, &threads[i]);
+        if (os_rc != 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, os_rc),
+                             "failed to create sender thread");
+            result = -1;
+            break;
+        }
+
+        threads[i].started = TRUE;
+    }
+
+finish:
+
+    if (threads != NULL)
+    {
+        for (i = 0; i < threads_num; i++)
+        {
+            if (threads[i].started)
+            {
+                pthread_join(threads[i].tid, NULL);
+                if (threads[i].rc != 0 && result >= 0)
+                {
+                    te_rpc_error_set(TE_RC(TE_TA_UNIX, threads[i].rc),
+                                     "sender thread %u failed", i);
+                    result = -1;
+                }
+            }
+
+            if (threads[i].s >= 0)
+                close(threads[i].s);
+        }
+    }
+
+    if (result >= 0)
+    {
+        for (i = 0; i < threads_num; i++)
+            result += stats[i].pkts;
+
+        out->stats.stats_val = stats;
+        out->stats.stats_len = threads_num;
+        stats = NULL;
+    }
+
+    free(threads);
+    free(stats);
+    free(pld);
+
+    return result;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_send_pkts_mt, {},
+{
+    MAKE_CALL(out->retval = send_pkts_mt(in, out));
+})
+
+/** Size of a block of TPACKET_V3 Rx ring */
+#define NET_DRV_CAPT_BLOCK_SIZE (1 << 20)
+/** Minimum number of blocks in TPACKET_V3 Rx ring */
+#define NET_DRV_CAPT_MIN_BLOCK_NR 4
+/** Maximum number of blocks in TPACKET_V3 Rx ring */
+#define NET_DRV_CAPT_MAX_BLOCK_NR 64
+/**
+ * Number of blocks in TPACKET_V3 Rx ring if number of expected packets
+ * is not known.
+ */
+#define NET_DRV_CAPT_DEF_BLOCK_NR 16
+/**
+ * Space taken in TPACKET_V3 Rx ring by a packet captured with default
+ * snap length (headers added by kernel and packet data).
+ */
+#define NET_DRV_CAPT_PKT_SPACE 512
+/** Frame size of TPACKET_V3 Rx ring */
+#define NET_DRV_CAPT_FRAME_SIZE 2048
+/** Timeout after which a block is passed to user even if not full, ms */
+#define NET_DRV_CAPT_BLOCK_TMO 10
+/**
+ * How many bytes of a packet to capture if no filter is specified
+ * (enough for Ethernet, VLAN, IPv6 and TCP headers with options).
+ */
+#define NET_DRV_CAPT_SNAPLEN 256
+
+/** TPACKET_V3 capture context */
+typedef struct capture_ctx {
+    uint32_t fields;        /**< Fields to collect (see
+                                 tarpc_net_drv_capt_field) */
+    uint32_t max_pkts;      /**< Maximum number of records */
+    uint64_t pkts;          /**< Number of captured packets */
+    te_dbuf records;        /**< Collected records */
+} capture_ctx;
+
+/** Append a field in network byte order to a capture record */
+static void
+capture_append(te_dbuf *dbuf, const void *val, size_t len)
+{
+    te_errno rc;
+
+    rc = te_dbuf_append(dbuf, val, len);
+    if (rc != 0)
+        TE_FATAL_ERROR("failed to append field to capture record: %r", rc);
+}
+
+/**
+ * Parse a captured packet and append requested fields of it to
+ * collected records. Fields are stored in network byte order in the
+ * order of their flags in tarpc_net_drv_capt_field.
+ */
+static void
+capture_process_pkt(capture_ctx *ctx, const struct tpacket3_hdr *hdr)
+{
+    const uint8_t *pkt = (const uint8_t *)hdr + hdr->tp_mac;
+    const uint8_t *end = pkt + hdr->tp_snaplen;
+    const uint8_t *l3;
+    uint16_t eth_type;
+    uint16_t vlan_tci = 0;
+    uint16_t vlan_tpid = 0;
+    uint8_t proto = 0;
+    unsigned int l3_len = 0;
+    const struct tcphdr *tcp = NULL;
+    uint32_t tcp_seq = 0;
+    uint32_t tcp_len = 0;
+    uint8_t tcp_flags = 0;
+    uint64_t ts;
+    uint32_t len;
+    uint16_t val16;
+    uint32_t val32;
+
+    ctx->pkts++;
+    if (ctx->max_pkts != 0 && ctx->pkts > ctx->max_pkts)
+        return;
+
+    if (pkt + ETH_HLEN > end)
+        goto append;
+
+    memcpy(&eth_type, pkt + 2 * ETH_ALEN, sizeof(eth_type));
+    l3 = pkt + ETH_HLEN;
+
+    if (hdr->tp_status & TP_STATUS_VLAN_VALID)
+    {
+        vlan_tci = hdr->hv1.tp_vlan_tci;
+        vlan_tpid = (hdr->tp_status & TP_STATUS_VLAN_TPID_VALID) ?
+                    hdr->hv1.tp_vlan_tpid : ETH_P_8021Q;
+    }
+    else if (eth_type == htons(ETH_P_8021Q) ||
+             eth_type == htons(ETH_P_8021AD))
+    {
+        if (l3 + 4 > end)
+            goto append;
+
+        vlan_tpid = ntohs(eth_type);
+        memcpy(&val16, l3, sizeof(val16));
+        vlan_tci = ntohs(val16);
+        memcpy(&eth_type, l3 + 2, sizeof(eth_type));
+        l3 += 4;
+    }
+
+    if (eth_type == htons(ETH_P_IP))
+    {
+        const struct iphdr *ip4 = (const struct iphdr *)l3;
+
+        if (l3 + sizeof(*ip4) > end)
+            goto append;
+
+        proto = ip4->protocol;
+        l3_len = ntohs(ip4->tot_len);
+        tcp = (const struct tcphdr *)(l3 + ip4->ihl * 4);
+        l3_len = (l3_len > ip4->ihl * 4u) ? l3_len - ip4->ihl * 4 : 0;
+    }
+    else if (eth_type == htons(ETH_P_IPV6))
+    {
+        const struct ip6_hdr *ip6 = (const struct ip6_hdr *)l3;
+
+        /* IPv6 extension headers are not parsed */
+        if (l3 + sizeof(*ip6) > end)
+            goto append;
+
+        proto = ip6->ip6_nxt;
+        l3_len = ntohs(ip6->ip6_plen);
+        tcp = (const struct tcphdr *)(l3 + sizeof(*ip6));
+    }
+
+    if (proto == IPPROTO_TCP &&
+        (const uint8_t *)tcp + sizeof(*tcp) <= end)
+    {
+        tcp_seq = ntohl(tcp->seq);
+        tcp_flags = ((const uint8_t *)tcp)[13];
+        if (l3_len > tcp->doff * 4u)
+            tcp_len = l3_len - tcp->doff * 4;
+    }
+
+append:
+
+    if (ctx->fields & TARPC_NET_DRV_CAPT_TS)
+    {
+        ts = (uint64_t)hdr->tp_sec * 1000000000ULL + hdr->tp_nsec;
+        ts = htobe64(ts);
+        capture_append(&ctx->records, &ts, sizeof(ts));
+    }
+    if (ctx->fields & TARPC_NET_DRV_CAPT_LEN)
+    {
+        len = htonl(hdr->tp_len);
+        capture_append(&ctx->records, &len, sizeof(len));
+    }
+    if (ctx->fields & TARPC_NET_DRV_CAPT_VLAN)
+    {
+        val16 = htons(vlan_tpid);
+        capture_append(&ctx->records, &val16, sizeof(val16));
+        val16 = htons(vlan_tci);
+        capture_append(&ctx->records, &val16, sizeof(val16));
+    }
+    if (ctx->fields & TARPC_NET_DRV_CAPT_TCP_SEQ)
+    {
+        val32 = htonl(tcp_seq);
+        capture_append(&ctx->records, &val32, sizeof(val32));
+    }
+    if (ctx->fields & TARPC_NET_DRV_CAPT_TCP_LEN)
+    {
+        val32 = htonl(tcp_len);
+        capture_append(&ctx->records, &val32, sizeof(val32));
+    }
+    if (ctx->fields & TARPC_NET_DRV_CAPT_TCP_FLAGS)
+        capture_append(&ctx->records, &tcp_flags, sizeof(tcp_flags));
+}
+
+/* Process all packets in a block of TPACKET_V3 Rx ring */
+static void
+capture_process_block(capture_ctx *ctx, struct tpacket_block_desc *block)
+{
+    struct tpacket3_hdr *hdr;
+    uint32_t i;
+
+    hdr = (struct tpacket3_hdr *)((uint8_t *)block +
+                                  block->hdr.bh1.offset_to_first_pkt);
+    for (i = 0; i < block->hdr.bh1.num_pkts; i++)
+    {
+        capture_process_pkt(ctx, hdr);
+        hdr = (struct tpacket3_hdr *)((uint8_t *)hdr + hdr->tp_next_offset);
+    }
+}
+
+/*
+ * Capture packets on an interface with AF_PACKET TPACKET_V3 Rx ring,
+ * collecting only requested fields of every packet.
+ */
+static int64_t
+capture_pkts(tarpc_net_drv_capture_pkts_in *in,
+             tarpc_net_drv_capture_pkts_out *out)
+{
+    struct tpacket_req3 req;
+    struct tpacket_stats_v3 stats;
+    socklen_t stats_len = sizeof(stats);
+    struct sock_filter def_filter = BPF_STMT(BPF_RET | BPF_K,
+                                             NET_DRV_CAPT_SNAPLEN);
+    struct sock_filter *filter = NULL;
+    struct sock_fprog fprog;
+    struct sockaddr_ll ll_addr;
+    struct tpacket_block_desc *block;
+    struct pollfd pfd;
+    capture_ctx ctx = { .records = TE_DBUF_INIT(50) };
+    int version = TPACKET_V3;
+    uint8_t *ring = MAP_FAILED;
+    size_t ring_size = 0;
+    unsigned int cur_block = 0;
+    te_bool draining = FALSE;
+    uint64_t end;
+    uint64_t now;
+    int64_t result = -1;
+    unsigned int i;
+    int ifindex;
+    int s;
+
+    ifindex = if_nametoindex(in->if_name);
+    if (ifindex == 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to get index of interface %s",
+                         in->if_name);
+        return -1;
+    }
+
+    /*
+     * Protocol is not specified here but in bind(), so that the socket
+     * does not receive anything before it is bound to the interface.
+     */
+    s = socket(AF_PACKET, SOCK_RAW, 0);
+    if (s < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to create AF_PACKET socket");
+        return -1;
+    }
+
+    /*
+     * Filter is attached before binding the socket so that no
+     * unfiltered packets get into the ring. Its return value also
+     * limits how many bytes of a packet are copied to the ring.
+     */
+    if (in->filter.filter_len > 0)
+    {
+        filter = calloc(in->filter.filter_len, sizeof(*filter));
+        if (filter == NULL)
+        {
+            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                             "failed to allocate memory for filter");
+            goto finish;
+        }
+
+        for (i = 0; i < in->filter.filter_len; i++)
+        {
+            filter[i].code = in->filter.filter_val[i].code;
+            filter[i].jt = in->filter.filter_val[i].jt;
+            filter[i].jf = in->filter.filter_val[i].jf;
+            filter[i].k = in->filter.filter_val[i].k;
+        }
+
+        fprog.len = in->filter.filter_len;
+        fprog.filter = filter;
+    }
+    else
+    {
+        fprog.len = 1;
+        fprog.filter = &def_filter;
+    }
+
+    if (setsockopt(s, SOL_SOCKET, SO_ATTACH_FILTER,
+                   &fprog, sizeof(fprog)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to attach filter");
+        goto finish;
+    }
+
+    if (setsockopt(s, SOL_PACKET, PACKET_VERSION,
+                   &version, sizeof(version)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to set TPACKET_V3");
+        goto finish;
+    }
+
+    /*
+     * Ring is sized to hold all the expected packets, so that they are
+     * not dropped even if TA does not keep up with them. It is limited
+     * to avoid consuming too much memory, and it is not locked in RAM
+     * since the kernel allocates PACKET_RX_RING pages itself.
+     */
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = NET_DRV_CAPT_BLOCK_SIZE;
+    if (in->max_pkts == 0)
+    {
+        req.tp_block_nr = NET_DRV_CAPT_DEF_BLOCK_NR;
+    }
+    else
+    {
+        req.tp_block_nr = TE_DIV_ROUND_UP((uint64_t)in->max_pkts *
+                                          NET_DRV_CAPT_PKT_SPACE,
+                                          NET_DRV_CAPT_BLOCK_SIZE);
+        req.tp_block_nr = MAX(req.tp_block_nr, NET_DRV_CAPT_MIN_BLOCK_NR);
+        req.tp_block_nr = MIN(req.tp_block_nr, NET_DRV_CAPT_MAX_BLOCK_NR);
+    }
+    req.tp_frame_size = NET_DRV_CAPT_FRAME_SIZE;
+    req.tp_frame_nr = NET_DRV_CAPT_BLOCK_SIZE / NET_DRV_CAPT_FRAME_SIZE *
+                      req.tp_block_nr;
+    req.tp_retire_blk_tov = NET_DRV_CAPT_BLOCK_TMO;
+
+    if (setsockopt(s, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to create Rx ring");
+        goto finish;
+    }
+
+    ring_size = (size_t)req.tp_block_size * req.tp_block_nr;
+    ring = mmap(NULL, ring_size, PROT_READ | PROT_WRITE,
+                MAP_SHARED, s, 0);
+    if (ring == MAP_FAILED)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to map Rx ring");
+        goto finish;
+    }
+
+    memset(&ll_addr, 0, sizeof(ll_addr));
+    ll_addr.sll_family = AF_PACKET;
+    ll_addr.sll_protocol = htons(ETH_P_ALL);
+    ll_addr.sll_ifindex = ifindex;
+    if (bind(s, SA(&ll_addr), sizeof(ll_addr)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to bind AF_PACKET socket");
+        goto finish;
+    }
+
+    ctx.fields = in->fields;
+    ctx.max_pkts = in->max_pkts;
+
+    pfd.fd = s;
+    pfd.events = POLLIN | POLLERR;
+    end = get_mono_raw_ns() + (uint64_t)in->time2run * 1000000ULL;
+
+    while (TRUE)
+    {
+        /*
+         * Deadline is checked on every iteration, otherwise the loop
+         * would never stop while blocks keep being filled.
+         */
+        now = get_mono_raw_ns();
+        if (now >= end)
+        {
+            if (draining)
+                break;
+
+            /*
+             * Give kernel time to retire partially filled
+             * block with the last packets.
+             */
+            draining = TRUE;
+            end = now + 2 * NET_DRV_CAPT_BLOCK_TMO * 1000000ULL;
+        }
+
+        block = (struct tpacket_block_desc *)
+                    (ring + (size_t)cur_block * req.tp_block_size);
+
+        if (!(block->hdr.bh1.block_status & TP_STATUS_USER))
+        {
+            pfd.revents = 0;
+            if (poll(&pfd, 1, (end - now) / 1000000 + 1) < 0)
+            {
+                te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                                 "poll() failed");
+                goto finish;
+            }
+            continue;
+        }
+
+        capture_process_block(&ctx, block);
+
+        block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+        __sync_synchronize();
+        cur_block = (cur_block + 1) % req.tp_block_nr;
+    }
+
+    if (getsockopt(s, SOL_PACKET, PACKET_STATISTICS,
+                   &stats, &stats_len) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to get capture statistics");
+        goto finish;
+    }
+
+    out->drops = stats.tp_drops;
+    out->records.records_val = ctx.records.ptr;
+    out->records.records_len = ctx.records.len;
+    ctx.records.ptr = NULL;
+    result = ctx.pkts;
+
+finish:
+
+    if (ring != MAP_FAILED)
+        munmap(ring, ring_size);
+    close(s);
+    free(filter);
+    te_dbuf_free(&ctx.records);
+
+    return result;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_capture_pkts, {},
+{
+    MAKE_CALL(out->retval = capture_pkts(in, out));
+})
+
+/** How long to wait for remaining zero-copy completions, in ms */
+#define NET_DRV_ZC_COMPL_TIMEOUT 1000
+
+/** Get CPU time (user and system) consumed by the calling thread, in ns */
+static uint64_t
+get_thread_cpu_time_ns(void)
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_THREAD, &usage) != 0)
+        TE_FATAL_ERROR("getrusage() failed: %r", te_rc_os2te(errno));
+
+    return ((uint64_t)usage.ru_utime.tv_sec +
+            usage.ru_stime.tv_sec) * 1000000000ULL +
+           ((uint64_t)usage.ru_utime.tv_usec +
+            usage.ru_stime.tv_usec) * 1000ULL;
+}
+
+#ifdef SO_EE_ORIGIN_ZEROCOPY
+/**
+ * Read all the zero-copy completion notifications currently available
+ * in socket error queue.
+ *
+ * @param s       Socket.
+ * @param out     Where to update completion counters.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+send_zc_read_compl(int s, tarpc_net_drv_send_zc_out *out)
+{
+    uint8_t cmsg_buf[CMSG_SPACE(sizeof(struct sock_extended_err)) + 64];
+    struct msghdr msg;
+    struct cmsghdr *cmsg;
+    struct sock_extended_err *serr;
+    uint32_t num;
+
+    while (TRUE)
+    {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = cmsg_buf;
+        msg.msg_controllen = sizeof(cmsg_buf);
+
+        if (recvmsg(s, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        {
+            if (errno == EAGAIN)
+                return 0;
+
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "failed to read error queue");
+            return -1;
+        }
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if (!((cmsg->cmsg_level == SOL_IP &&
+                   cmsg->cmsg_type == IP_RECVERR) ||
+                  (cmsg->cmsg_level == SOL_IPV6 &&
+                   cmsg->cmsg_type == IPV6_RECVERR)))
+                continue;
+
+            serr = (struct sock_extended_err *)CMSG_DATA(cmsg);
+            if (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                continue;
+
+            /*
+             * Notification reports a range [ee_info, ee_data] of
+             * completed send calls.
+             */
+            num = serr->ee_data - serr->ee_info + 1;
+            out->zc_completed += num;
+            if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                out->zc_copied += num;
+        }
+    }
+}
+#endif
+
+/*
+ * Send data over a connected socket for a given time, with or without
+ * MSG_ZEROCOPY, tracking zero-copy completions and CPU time consumed.
+ */
+static int64_t
+send_zc(tarpc_net_drv_send_zc_in *in, tarpc_net_drv_send_zc_out *out)
+{
+#ifdef SO_EE_ORIGIN_ZEROCOPY
+    uint64_t end;
+    uint64_t cpu_start;
+    int64_t sent = 0;
+    void *buf = NULL;
+    struct pollfd pfd;
+    int flags = 0;
+    int one = 1;
+    ssize_t rc;
+
+    if (in->buf_size == 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "buffer size must be positive");
+        return -1;
+    }
+
+    /*
+     * Pages of a buffer passed with MSG_ZEROCOPY must not be changed
+     * until completion is reported, so the buffer is never modified
+     * after initialization.
+     */
+    buf = calloc(1, in->buf_size);
+    if (buf == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate buffer");
+        return -1;
+    }
+
+    if (in->zerocopy)
+    {
+        if (setsockopt(in->s, SOL_SOCKET, SO_ZEROCOPY,
+                       &one, sizeof(one)) < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "failed to enable SO_ZEROCOPY");
+            free(buf);
+            return -1;
+        }
+        flags = MSG_ZEROCOPY;
+    }
+
+    pfd.fd = in->s;
+    pfd.events = POLLOUT;
+
+    cpu_start = get_thread_cpu_time_ns();
+    end = get_mono_raw_ns() + (uint64_t)in->time2run * 1000000ULL;
+
+    while (get_mono_raw_ns() < end)
+    {
+        rc = send(in->s, buf, in->buf_size, flags);
+        if (rc < 0)
+        {
+            /*
+             * ENOBUFS is returned if too many zero-copy sends are
+             * pending: wait for completions and try again.
+             */
+            if (errno == ENOBUFS && in->zerocopy)
+            {
+                pfd.revents = 0;
+                poll(&pfd, 1, 1);
+                if (send_zc_read_compl(in->s, out) < 0)
+                    goto err;
+                continue;
+            }
+
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno), "send() failed");
+            goto err;
+        }
+
+        sent += rc;
+        out->calls++;
+
+        if (in->zerocopy && send_zc_read_compl(in->s, out) < 0)
+            goto err;
+    }
+
+    if (in->zerocopy)
+    {
+        end = get_mono_raw_ns() + NET_DRV_ZC_COMPL_TIMEOUT * 1000000ULL;
+        while (out->zc_completed < out->calls && get_mono_raw_ns() < end)
+        {
+            pfd.revents = 0;
+            poll(&pfd, 1, 1);
+            if (send_zc_read_compl(in->s, out) < 0)
+                goto err;
+        }
+
+        if (out->zc_completed < out->calls)
+        {
+            ERROR("%s(): only %" TE_PRINTF_64 "u zero-copy completions "
+                  "out of %" TE_PRINTF_64 "u were received", __FUNCTION__,
+                  out->zc_completed, out->calls);
+        }
+    }
+
+    out->cpu_time = get_thread_cpu_time_ns() - cpu_start;
+    free(buf);
+    return sent;
+
+err:
+
+    free(buf);
+    return -1;
+#else
+    UNUSED(out);
+
+    te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EOPNOTSUPP),
+                     "MSG_ZEROCOPY is not supported");
+    return -1;
+#endif
+}
+
+TARPC_FUNC_STANDALONE(net_drv_send_zc, {},
+{
+    MAKE_CALL(out->retval = send_zc(in, out));
+})
+
+/*
+ * Send UDP super-buffers with UDP_SEGMENT control message, so that they
+ * are split into datagrams of a given size by the NIC (or by kernel if
+ * UDP segmentation offload is disabled).
+ */
+static int64_t
+send_udp_gso(tarpc_net_drv_send_udp_gso_in *in,
+             tarpc_net_drv_send_udp_gso_out *out)
+{
+#ifdef UDP_SEGMENT
+    uint8_t cmsg_buf[CMSG_SPACE(sizeof(uint16_t))];
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    struct iovec iov;
+    uint16_t gso_size = in->gso_size;
+    uint64_t cpu_start;
+    uint64_t end;
+    int64_t sent = 0;
+    void *buf;
+    ssize_t rc;
+
+    if (in->buf_len == 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "buffer length must be positive");
+        return -1;
+    }
+
+    buf = calloc(1, in->buf_len);
+    if (buf == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate buffer");
+        return -1;
+    }
+
+    iov.iov_base = buf;
+    iov.iov_len = in->buf_len;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    if (in->gso_size > 0)
+    {
+        memset(cmsg_buf, 0, sizeof(cmsg_buf));
+        msg.msg_control = cmsg_buf;
+        msg.msg_controllen = sizeof(cmsg_buf);
+
+        cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(gso_size));
+        memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+    }
+
+    cpu_start = get_thread_cpu_time_ns();
+    end = get_mono_raw_ns() + (uint64_t)in->time2run * 1000000ULL;
+
+    while (get_mono_raw_ns() < end &&
+           (in->max_calls == 0 || out->calls < in->max_calls))
+    {
+        rc = sendmsg(in->s, &msg, 0);
+        if (rc < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "sendmsg() failed");
+            free(buf);
+            return -1;
+        }
+
+        sent += rc;
+        out->calls++;
+        if (in->gso_size > 0)
+            out->segs += (rc + in->gso_size - 1) / in->gso_size;
+        else
+            out->segs++;
+    }
+
+    out->cpu_time = get_thread_cpu_time_ns() - cpu_start;
+    free(buf);
+
+    return sent;
+#else
+    UNUSED(out);
+
+    te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EOPNOTSUPP),
+                     "UDP_SEGMENT is not supported");
+    return -1;
+#endif
+}
+
+TARPC_FUNC_STANDALONE(net_drv_send_udp_gso, {},
+{
+    MAKE_CALL(out->retval = send_udp_gso(in, out));
+})
+
+/** Maximum size of UDP datagram received by net_drv_recv_udp_gro() */
+#define NET_DRV_MAX_GRO_LEN 65536
+
+/*
+ * Receive UDP datagrams until no new data arrives for a while,
+ * optionally enabling UDP_GRO on the socket and checking how
+ * received datagrams were coalesced.
+ */
+static int64_t
+recv_udp_gro(tarpc_net_drv_recv_udp_gro_in *in,
+             tarpc_net_drv_recv_udp_gro_out *out)
+{
+#ifdef UDP_GRO
+    uint8_t cmsg_buf[CMSG_SPACE(sizeof(int))];
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    struct iovec iov;
+    struct pollfd pfd;
+    int64_t dgrams = 0;
+    uint32_t segs;
+    int gso_size;
+    int one = 1;
+    void *buf;
+    ssize_t rc;
+
+    if (in->gro &&
+        setsockopt(in->s, SOL_UDP, UDP_GRO, &one, sizeof(one)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to enable UDP_GRO");
+        return -1;
+    }
+
+    buf = malloc(NET_DRV_MAX_GRO_LEN);
+    if (buf == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate buffer");
+        return -1;
+    }
+
+    iov.iov_base = buf;
+    iov.iov_len = NET_DRV_MAX_GRO_LEN;
+
+    pfd.fd = in->s;
+    pfd.events = POLLIN;
+
+    while (TRUE)
+    {
+        pfd.revents = 0;
+        rc = poll(&pfd, 1, in->time2wait);
+        if (rc < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno), "poll() failed");
+            dgrams = -1;
+            break;
+        }
+        else if (rc == 0)
+        {
+            break;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = cmsg_buf;
+        msg.msg_controllen = sizeof(cmsg_buf);
+
+        rc = recvmsg(in->s, &msg, 0);
+        if (rc < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "recvmsg() failed");
+            dgrams = -1;
+            break;
+        }
+
+        gso_size = 0;
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+                memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+        }
+
+        dgrams++;
+        out->bytes += rc;
+
+        /*
+         * UDP_GRO control message is attached only if datagram is a
+         * result of coalescing several segments.
+         */
+        if (gso_size > 0)
+        {
+            segs = (rc + gso_size - 1) / gso_size;
+            out->coalesced++;
+            out->max_segs = MAX(out->max_segs, segs);
+            if (out->gso_size != 0 && out->gso_size != (uint32_t)gso_size)
+                out->gso_size_mismatch++;
+            out->gso_size = gso_size;
+        }
+        else
+        {
+            segs = 1;
+        }
+
+        out->segs += segs;
+    }
+
+    free(buf);
+    return dgrams;
+#else
+    UNUSED(out);
+
+    te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EOPNOTSUPP),
+                     "UDP_GRO is not supported");
+    return -1;
+#endif
+}
+
+TARPC_FUNC_STANDALONE(net_drv_recv_udp_gro, {},
+{
+    MAKE_CALL(out->retval = recv_udp_gro(in, out));
+})
+
+/**
+ * Number of bits of a value used to choose a sub-bucket inside
+ * a power-of-two range in RTT histogram.
+ */
+#define NET_DRV_LAT_SUB_BITS 4
+
+/** Number of sub-buckets in every power-of-two range of RTT histogram */
+#define NET_DRV_LAT_SUB_BUCKETS (1 << NET_DRV_LAT_SUB_BITS)
+
+/** Total number of buckets in RTT histogram */
+#define NET_DRV_LAT_BUCKETS \
+    ((64 - NET_DRV_LAT_SUB_BITS + 1) * NET_DRV_LAT_SUB_BUCKETS)
+
+/**
+ * How long to wait for a reply in ping-pong client before considering
+ * all the requests in flight lost, in milliseconds.
+ */
+#define NET_DRV_PINGPONG_TIMEOUT 1000
+
+/**
+ * Get index of RTT histogram bucket for a given value. Buckets are
+ * log-linear: every power-of-two range is split into
+ * NET_DRV_LAT_SUB_BUCKETS buckets of equal width, so that relative
+ * error does not exceed 1 / NET_DRV_LAT_SUB_BUCKETS.
+ */
+static unsigned int
+lat_hist_idx(uint64_t v)
+{
+    unsigned int e;
+
+    if (v < NET_DRV_LAT_SUB_BUCKETS)
+        return v;
+
+    e = 63 - __builtin_clzll(v);
+    return (e - NET_DRV_LAT_SUB_BITS + 1) * NET_DRV_LAT_SUB_BUCKETS +
+           ((v >> (e - NET_DRV_LAT_SUB_BITS)) &
+            (NET_DRV_LAT_SUB_BUCKETS - 1));
+}
+
+/** Get value in the middle of RTT histogram bucket */
+static uint64_t
+lat_hist_value(unsigned int idx)
+{
+    unsigned int shift;
+    uint64_t sub;
+
+    if (idx < NET_DRV_LAT_SUB_BUCKETS)
+        return idx;
+
+    shift = idx / NET_DRV_LAT_SUB_BUCKETS - 1;
+    sub = idx % NET_DRV_LAT_SUB_BUCKETS;
+
+    return ((NET_DRV_LAT_SUB_BUCKETS + sub) << shift) +
+           ((1ULL << shift) >> 1);
+}
+
+/**
+ * Compute percentiles from RTT histogram.
+ *
+ * @param hist          Histogram.
+ * @param count         Number of values in the histogram.
+ * @param max           Maximum value (percentiles are clamped to it).
+ * @param percentiles   Requested percentiles, in thousandths of
+ *                      percent.
+ * @param num           Number of requested percentiles.
+ * @param values        Where to save computed values.
+ */
+static void
+lat_hist_percentiles(const uint64_t *hist, uint64_t count, uint64_t max,
+                     const uint32_t *percentiles, unsigned int num,
+                     uint64_t *values)
+{
+    uint64_t target;
+    uint64_t sum;
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; i < num; i++)
+    {
+        target = (count * percentiles[i] + 99999) / 100000;
+        if (target == 0)
+            target = 1;
+
+        sum = 0;
+        values[i] = max;
+        for (j = 0; j < NET_DRV_LAT_BUCKETS; j++)
+        {
+            sum += hist[j];
+            if (sum >= target)
+            {
+                values[i] = MIN(lat_hist_value(j), max);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Send a ping-pong message, handling partial sends on
+ * stream sockets.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+pingpong_send_msg(int s, const uint8_t *buf, size_t len)
+{
+    size_t pos = 0;
+    ssize_t rc;
+
+    while (pos < len)
+    {
+        rc = send(s, buf + pos, len - pos, 0);
+        if (rc < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "send() failed");
+            return -1;
+        }
+        pos += rc;
+    }
+
+    return 0;
+}
+
+/**
+ * Receive a ping-pong message. On stream sockets reading continues
+ * until the whole message is received.
+ *
+ * @return @c 1 if a message was received, @c 0 if connection was
+ *         closed by peer, @c -1 on failure.
+ */
+static int
+pingpong_recv_msg(int s, te_bool stream, uint8_t *buf, size_t len)
+{
+    size_t pos = 0;
+    ssize_t rc;
+
+    do {
+        rc = recv(s, buf + pos, len - pos, 0);
+        if (rc < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "recv() failed");
+            return -1;
+        }
+        else if (rc == 0 && stream)
+        {
+            return 0;
+        }
+        pos += rc;
+    } while (stream && pos < len);
+
+    return 1;
+}
+
+/**
+ * Prepare socket for ping-pong: check message size and disable Nagle
+ * algorithm on TCP socket.
+ *
+ * @param s         Socket.
+ * @param msg_size  Message size.
+ * @param stream    Will be set to @c TRUE for stream socket.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+pingpong_prepare(int s, unsigned int msg_size, te_bool *stream)
+{
+    socklen_t len = sizeof(int);
+    int type;
+    int one = 1;
+
+    if (msg_size < sizeof(uint64_t))
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "message size must be at least %zu bytes",
+                         sizeof(uint64_t));
+        return -1;
+    }
+
+    if (getsockopt(s, SOL_SOCKET, SO_TYPE, &type, &len) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to get socket type");
+        return -1;
+    }
+
+    *stream = (type == SOCK_STREAM);
+    if (*stream &&
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to set TCP_NODELAY");
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Send requests to ping-pong server keeping a given number of them
+ * in flight, measuring RTT of every request.
+ */
+static int64_t
+pingpong_client(tarpc_net_drv_pingpong_client_in *in,
+                tarpc_net_drv_pingpong_client_out *out)
+{
+    unsigned int pct_num = in->percentiles.percentiles_len;
+    unsigned int in_flight = 0;
+    uint64_t *hist = NULL;
+    uint8_t *tx_buf = NULL;
+    uint8_t *rx_buf = NULL;
+    struct pollfd pfd;
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t last_sent_ts = 0;
+    uint64_t stale_ts = 0;
+    uint64_t end;
+    uint64_t now;
+    uint64_t ts;
+    te_bool stream;
+    int64_t result = -1;
+    int rc;
+
+    if (in->depth == 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "number of requests in flight must be positive");
+        return -1;
+    }
+
+    if (pingpong_prepare(in->s, in->msg_size, &stream) < 0)
+        return -1;
+
+    hist = calloc(NET_DRV_LAT_BUCKETS, sizeof(*hist));
+    tx_buf = calloc(1, in->msg_size);
+    rx_buf = calloc(1, in->msg_size);
+    out->pct_values.pct_values_val = calloc(pct_num + 1,
+                                            sizeof(uint64_t));
+    if (hist == NULL || tx_buf == NULL || rx_buf == NULL ||
+        out->pct_values.pct_values_val == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate memory");
+        goto exit;
+    }
+    out->pct_values.pct_values_len = pct_num;
+
+    pfd.fd = in->s;
+    pfd.events = POLLIN;
+
+    end = get_mono_raw_ns() + (uint64_t)in->time2run * 1000000ULL;
+    out->min = UINT64_MAX;
+
+    do {
+        while (in_flight < in->depth && get_mono_raw_ns() < end)
+        {
+            ts = get_mono_raw_ns();
+            memcpy(tx_buf, &ts, sizeof(ts));
+            if (pingpong_send_msg(in->s, tx_buf, in->msg_size) < 0)
+                goto exit;
+            last_sent_ts = ts;
+            in_flight++;
+        }
+
+        if (in_flight == 0)
+            break;
+
+        pfd.revents = 0;
+        rc = poll(&pfd, 1, NET_DRV_PINGPONG_TIMEOUT);
+        if (rc < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno), "poll() failed");
+            goto exit;
+        }
+        else if (rc == 0)
+        {
+            /*
+             * Requests (or replies) were lost. Replies to them which
+             * arrive later are ignored, they are recognized by
+             * timestamps which serve as increasing request Ids.
+             */
+            out->lost += in_flight;
+            in_flight = 0;
+            stale_ts = last_sent_ts;
+            continue;
+        }
+
+        rc = pingpong_recv_msg(in->s, stream, rx_buf, in->msg_size);
+        if (rc < 0)
+        {
+            goto exit;
+        }
+        else if (rc == 0)
+        {
+            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ECONNRESET),
+                             "connection was closed by peer");
+            goto exit;
+        }
+
+        now = get_mono_raw_ns();
+        memcpy(&ts, rx_buf, sizeof(ts));
+        if (ts > now)
+        {
+            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EBADMSG),
+                             "reply contains invalid timestamp");
+            goto exit;
+        }
+
+        if (ts <= stale_ts)
+            continue;
+
+        now -= ts;
+        hist[lat_hist_idx(now)]++;
+        out->min = MIN(out->min, now);
+        out->max = MAX(out->max, now);
+        sum += now;
+        count++;
+
+        if (in_flight > 0)
+            in_flight--;
+    } while (TRUE);
+
+    if (count == 0)
+    {
+        out->min = 0;
+    }
+    else
+    {
+        out->mean = sum / count;
+        lat_hist_percentiles(hist, count, out->max,
+                             in->percentiles.percentiles_val, pct_num,
+                             out->pct_values.pct_values_val);
+    }
+
+    result = count;
+
+exit:
+
+    free(hist);
+    free(tx_buf);
+    free(rx_buf);
+    return result;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_pingpong_client, {},
+{
+    MAKE_CALL(out->retval = pingpong_client(in, out));
+})
+
+/*
+ * Send back every received message until no new messages arrive
+ * for a while or connection is closed.
+ */
+static int64_t
+pingpong_server(tarpc_net_drv_pingpong_server_in *in,
+                tarpc_net_drv_pingpong_server_out *out)
+{
+    struct sockaddr_storage addr;
+    socklen_t addr_len;
+    struct pollfd pfd;
+    int64_t msgs = 0;
+    uint8_t *buf;
+    te_bool stream;
+    ssize_t len;
+    int rc;
+
+    UNUSED(out);
+
+    if (pingpong_prepare(in->s, in->msg_size, &stream) < 0)
+        return -1;
+
+    buf = malloc(in->msg_size);
+    if (buf == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate buffer");
+        return -1;
+    }
+
+    pfd.fd = in->s;
+    pfd.events = POLLIN;
+
+    while (TRUE)
+    {
+        pfd.revents = 0;
+        rc = poll(&pfd, 1, in->time2wait);
+        if (rc < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno), "poll() failed");
+            msgs = -1;
+            break;
+        }
+        else if (rc == 0)
+        {
+            break;
+        }
+
+        if (stream)
+        {
+            rc = pingpong_recv_msg(in->s, TRUE, buf, in->msg_size);
+            if (rc <= 0)
+            {
+                if (rc < 0)
+                    msgs = -1;
+                break;
+            }
+
+            if (pingpong_send_msg(in->s, buf, in->msg_size) < 0)
+            {
+                msgs = -1;
+                break;
+            }
+        }
+        else
+        {
+            addr_len = sizeof(addr);
+            len = recvfrom(in->s, buf, in->msg_size, 0, SA(&addr),
+                           &addr_len);
+            if (len < 0 ||
+                sendto(in->s, buf, len, 0, SA(&addr), addr_len) < 0)
+            {
+                te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                                 "failed to send back a datagram");
+                msgs = -1;
+                break;
+            }
+        }
+
+        msgs++;
+    }
+
+    free(buf);
+    return msgs;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_pingpong_server, {},
+{
+    MAKE_CALL(out->retval = pingpong_server(in, out));
+})
+
+/*
+ * io_uring is used via raw system calls to avoid dependency on liburing
+ * which may be missing on hosts where agents are built. Multishot recv
+ * together with provided buffer rings appeared in Linux 6.0.
+ */
+#if defined(IORING_RECV_MULTISHOT) && defined(__NR_io_uring_setup)
+
+/** Number of submission queue entries in io_uring */
+#define NET_DRV_URING_ENTRIES 256
+
+/** Buffer group ID used for receive buffers */
+#define NET_DRV_URING_BGID 0
+
+/** How long to wait for completions at once, in milliseconds */
+#define NET_DRV_URING_POLL_TIMEOUT 100
+
+/** io_uring instance mapped to user space */
+typedef struct net_drv_uring {
+    int fd;                         /**< io_uring file descriptor */
+    void *sq_ptr;                   /**< Mapped submission queue ring */
+    size_t sq_len;                  /**< Length of sq_ptr mapping */
+    void *cq_ptr;                   /**< Mapped completion queue ring */
+    size_t cq_len;                  /**< Length of cq_ptr mapping */
+    struct io_uring_sqe *sqes;      /**< Submission queue entries */
+    size_t sqes_len;                /**< Length of sqes mapping */
+
+    unsigned int *sq_head;          /**< SQ head (updated by kernel) */
+    unsigned int *sq_tail;          /**< SQ tail */
+    unsigned int *sq_array;         /**< SQ indirection array */
+    unsigned int sq_mask;           /**< SQ ring mask */
+    unsigned int sq_entries;        /**< Number of SQ entries */
+    unsigned int to_submit;         /**< Number of queued SQEs */
+
+    unsigned int *cq_head;          /**< CQ head */
+    unsigned int *cq_tail;          /**< CQ tail (updated by kernel) */
+    unsigned int cq_mask;           /**< CQ ring mask */
+    struct io_uring_cqe *cqes;      /**< Completion queue entries */
+} net_drv_uring;
+
+/** Release resources of io_uring instance */
+static void
+net_drv_uring_fini(net_drv_uring *ring)
+{
+    if (ring->sqes != NULL)
+        munmap(ring->sqes, ring->sqes_len);
+    if (ring->cq_ptr != NULL && ring->cq_ptr != ring->sq_ptr)
+        munmap(ring->cq_ptr, ring->cq_len);
+    if (ring->sq_ptr != NULL)
+        munmap(ring->sq_ptr, ring->sq_len);
+    /* Requests which are still in flight are cancelled by kernel */
+    if (ring->fd >= 0)
+        close(ring->fd);
+}
+
+/**
+ * Create io_uring instance and map its rings.
+ *
+ * @param ring      Where to save io_uring instance.
+ * @param entries   Number of SQ entries.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+net_drv_uring_init(net_drv_uring *ring, unsigned int entries)
+{
+    struct io_uring_params p;
+    uint8_t *sq;
+    uint8_t *cq;
+
+    memset(ring, 0, sizeof(*ring));
+    memset(&p, 0, sizeof(p));
+
+    ring->fd = syscall(__NR_io_uring_setup, entries, &p);
+    if (ring->fd < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "io_uring_setup() failed");
+        return -1;
+    }
+
+    ring->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+    ring->cq_len = p.cq_off.cqes +
+                   p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        ring->sq_len = ring->cq_len = MAX(ring->sq_len, ring->cq_len);
+
+    ring->sq_ptr = mmap(NULL, ring->sq_len, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring->fd,
+                        IORING_OFF_SQ_RING);
+    if (ring->sq_ptr == MAP_FAILED)
+    {
+        ring->sq_ptr = NULL;
+        goto fail;
+    }
+
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        ring->cq_ptr = ring->sq_ptr;
+    }
+    else
+    {
+        ring->cq_ptr = mmap(NULL, ring->cq_len, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ring->fd,
+                            IORING_OFF_CQ_RING);
+        if (ring->cq_ptr == MAP_FAILED)
+        {
+            ring->cq_ptr = NULL;
+            goto fail;
+        }
+    }
+
+    ring->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd,
+                      IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED)
+    {
+        ring->sqes = NULL;
+        goto fail;
+    }
+
+    sq = ring->sq_ptr;
+    cq = ring->cq_ptr;
+
+    ring->sq_head = (unsigned int *)(sq + p.sq_off.head);
+    ring->sq_tail = (unsigned int *)(sq + p.sq_off.tail);
+    ring->sq_array = (unsigned int *)(sq + p.sq_off.array);
+    ring->sq_mask = *(unsigned int *)(sq + p.sq_off.ring_mask);
+    ring->sq_entries = p.sq_entries;
+
+    ring->cq_head = (unsigned int *)(cq + p.cq_off.head);
+    ring->cq_tail = (unsigned int *)(cq + p.cq_off.tail);
+    ring->cq_mask = *(unsigned int *)(cq + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+
+    return 0;
+
+fail:
+
+    te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                     "failed to map io_uring rings");
+    net_drv_uring_fini(ring);
+    return -1;
+}
+
+/**
+ * Get a free submission queue entry.
+ *
+ * @return Pointer to zeroed SQE or @c NULL if SQ is full.
+ */
+static struct io_uring_sqe *
+net_drv_uring_get_sqe(net_drv_uring *ring)
+{
+    unsigned int head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    unsigned int tail = *ring->sq_tail;
+    unsigned int idx;
+
+    if (tail - head >= ring->sq_entries)
+        return NULL;
+
+    idx = tail & ring->sq_mask;
+    ring->sq_array[idx] = idx;
+    memset(&ring->sqes[idx], 0, sizeof(ring->sqes[idx]));
+
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->to_submit++;
+
+    return &ring->sqes[idx];
+}
+
+/**
+ * Submit queued SQEs and wait for completions for a limited time.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+net_drv_uring_submit_wait(net_drv_uring *ring, int timeout)
+{
+    struct pollfd pfd;
+    int rc;
+
+    while (ring->to_submit > 0)
+    {
+        rc = syscall(__NR_io_uring_enter, ring->fd, ring->to_submit,
+                     0, 0, NULL, 0);
+        if (rc < 0)
+        {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                continue;
+
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "io_uring_enter() failed");
+            return -1;
+        }
+        ring->to_submit -= rc;
+    }
+
+    if (*ring->cq_head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE))
+        return 0;
+
+    pfd.fd = ring->fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, timeout) < 0 && errno != EINTR)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "poll() on io_uring failed");
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Get the next completion queue entry.
+ *
+ * @return Pointer to CQE or @c NULL if CQ is empty. Call
+ *         net_drv_uring_cqe_seen() after processing a CQE.
+ */
+static struct io_uring_cqe *
+net_drv_uring_peek_cqe(net_drv_uring *ring)
+{
+    unsigned int head = *ring->cq_head;
+
+    if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE))
+        return NULL;
+
+    return &ring->cqes[head & ring->cq_mask];
+}
+
+/** Mark the current CQE as processed */
+static void
+net_drv_uring_cqe_seen(net_drv_uring *ring)
+{
+    __atomic_store_n(ring->cq_head, *ring->cq_head + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Send data over a socket with io_uring, keeping a number of writes
+ * from registered buffers in flight.
+ */
+static int64_t
+uring_send(tarpc_net_drv_uring_send_in *in,
+           tarpc_net_drv_uring_send_out *out)
+{
+    net_drv_uring ring;
+    struct io_uring_sqe *sqe;
+    struct io_uring_cqe *cqe;
+    struct iovec *iovs = NULL;
+    uint8_t *bufs = NULL;
+    unsigned int in_flight = 0;
+    unsigned int *free_bufs = NULL;
+    unsigned int free_num;
+    unsigned int idx;
+    unsigned int i;
+    int64_t sent = 0;
+    int64_t result = -1;
+    uint64_t end;
+    int rc;
+
+    if (in->depth == 0 || in->min_size == 0 || in->max_size < in->min_size)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "invalid depth or data size");
+        return -1;
+    }
+
+    if (net_drv_uring_init(&ring, MAX(in->depth,
+                                      NET_DRV_URING_ENTRIES)) < 0)
+        return -1;
+
+    bufs = malloc((size_t)in->depth * in->max_size);
+    iovs = calloc(in->depth, sizeof(*iovs));
+    free_bufs = calloc(in->depth, sizeof(*free_bufs));
+    if (bufs == NULL || iovs == NULL || free_bufs == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate buffers");
+        goto exit;
+    }
+
+    for (i = 0; i < (size_t)in->depth * in->max_size; i++)
+        bufs[i] = rand();
+
+    for (i = 0; i < in->depth; i++)
+    {
+        iovs[i].iov_base = bufs + (size_t)i * in->max_size;
+        iovs[i].iov_len = in->max_size;
+        free_bufs[i] = i;
+    }
+    free_num = in->depth;
+
+    rc = syscall(__NR_io_uring_register, ring.fd, IORING_REGISTER_BUFFERS,
+                 iovs, in->depth);
+    if (rc < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to register buffers");
+        goto exit;
+    }
+
+    end = get_mono_raw_ns() + (uint64_t)in->time2run * 1000000ULL;
+
+    while (get_mono_raw_ns() < end)
+    {
+        while (free_num > 0)
+        {
+            sqe = net_drv_uring_get_sqe(&ring);
+            if (sqe == NULL)
+                break;
+
+            idx = free_bufs[--free_num];
+            sqe->opcode = IORING_OP_WRITE_FIXED;
+            sqe->fd = in->s;
+            sqe->addr = (uintptr_t)iovs[idx].iov_base;
+            sqe->len = in->min_size +
+                       rand() % (in->max_size - in->min_size + 1);
+            sqe->buf_index = idx;
+            sqe->user_data = idx;
+            in_flight++;
+        }
+
+        if (net_drv_uring_submit_wait(&ring,
+                                      NET_DRV_URING_POLL_TIMEOUT) < 0)
+            goto exit;
+
+        while ((cqe = net_drv_uring_peek_cqe(&ring)) != NULL)
+        {
+            if (cqe->res < 0)
+            {
+                if (!in->ignore_err)
+                {
+                    te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, -cqe->res),
+                                     "write via io_uring failed");
+                    goto exit;
+                }
+                out->errors++;
+            }
+            else
+            {
+                sent += cqe->res;
+            }
+
+            out->completions++;
+            free_bufs[free_num++] = cqe->user_data;
+            in_flight--;
+            net_drv_uring_cqe_seen(&ring);
+        }
+    }
+
+    if (in_flight > 0)
+    {
+        VERB("%s(): %u writes are still in flight and will be cancelled",
+             __FUNCTION__, in_flight);
+    }
+
+    result = sent;
+
+exit:
+
+    net_drv_uring_fini(&ring);
+    free(bufs);
+    free(iovs);
+    free(free_bufs);
+    return result;
+}
+
+/** Return a buffer to provided buffer ring */
+static void
+uring_recv_buf_put(struct io_uring_buf_ring *br, unsigned int mask,
+                   uint8_t *bufs, unsigned int buf_size, unsigned int bid)
+{
+    struct io_uring_buf *buf = &br->bufs[br->tail & mask];
+
+    buf->addr = (uintptr_t)(bufs + (size_t)bid * buf_size);
+    buf->len = buf_size;
+    buf->bid = bid;
+    __atomic_store_n(&br->tail, br->tail + 1, __ATOMIC_RELEASE);
+}
+
+/** Queue multishot recv request using provided buffers */
+static int
+uring_recv_arm(net_drv_uring *ring, int s)
+{
+    struct io_uring_sqe *sqe;
+
+    sqe = net_drv_uring_get_sqe(ring);
+    if (sqe == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOSPC),
+                         "io_uring submission queue is full");
+        return -1;
+    }
+
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = s;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = NET_DRV_URING_BGID;
+
+    return 0;
+}
+
+/*
+ * Receive data from a socket with io_uring multishot recv and
+ * a ring of provided buffers.
+ */
+static int64_t
+uring_recv(tarpc_net_drv_uring_recv_in *in,
+           tarpc_net_drv_uring_recv_out *out)
+{
+    struct io_uring_buf_reg reg;
+    struct io_uring_buf_ring *br = NULL;
+    struct io_uring_cqe *cqe;
+    net_drv_uring ring;
+    unsigned int bufs_num;
+    uint8_t *bufs = NULL;
+    size_t br_len = 0;
+    int64_t received = 0;
+    int64_t result = -1;
+    te_bool eof = FALSE;
+    te_bool armed;
+    uint64_t end;
+    unsigned int i;
+    int rc;
+
+    if (in->buf_size == 0 || in->bufs_num == 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "invalid buffer size or number of buffers");
+        return -1;
+    }
+
+    /* Size of provided buffer ring must be a power of 2 */
+    bufs_num = 1;
+    while (bufs_num < in->bufs_num)
+        bufs_num <<= 1;
+
+    if (net_drv_uring_init(&ring, NET_DRV_URING_ENTRIES) < 0)
+        return -1;
+
+    br_len = bufs_num * sizeof(struct io_uring_buf);
+    br = mmap(NULL, br_len, PROT_READ | PROT_WRITE,
+              MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (br == MAP_FAILED)
+    {
+        br = NULL;
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to allocate provided buffer ring");
+        goto exit;
+    }
+
+    bufs = malloc((size_t)bufs_num * in->buf_size);
+    if (bufs == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate buffers");
+        goto exit;
+    }
+
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uintptr_t)br;
+    reg.ring_entries = bufs_num;
+    reg.bgid = NET_DRV_URING_BGID;
+    rc = syscall(__NR_io_uring_register, ring.fd,
+                 IORING_REGISTER_PBUF_RING, &reg, 1);
+    if (rc < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to register provided buffer ring");
+        goto exit;
+    }
+
+    br->tail = 0;
+    for (i = 0; i < bufs_num; i++)
+        uring_recv_buf_put(br, bufs_num - 1, bufs, in->buf_size, i);
+
+    if (uring_recv_arm(&ring, in->s) < 0)
+        goto exit;
+    armed = TRUE;
+
+    end = get_mono_raw_ns() + (uint64_t)in->time2run * 1000000ULL;
+
+    while (!eof && get_mono_raw_ns() < end)
+    {
+        if (!armed)
+        {
+            if (uring_recv_arm(&ring, in->s) < 0)
+                goto exit;
+            armed = TRUE;
+        }
+
+        if (net_drv_uring_submit_wait(&ring,
+                                      NET_DRV_URING_POLL_TIMEOUT) < 0)
+            goto exit;
+
+        while ((cqe = net_drv_uring_peek_cqe(&ring)) != NULL)
+        {
+            out->completions++;
+
+            if (cqe->res > 0)
+            {
+                received += cqe->res;
+                uring_recv_buf_put(br, bufs_num - 1, bufs, in->buf_size,
+                                   cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+            }
+            else if (cqe->res == 0)
+            {
+                eof = TRUE;
+            }
+            else if (cqe->res != -ENOBUFS)
+            {
+                te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, -cqe->res),
+                                 "recv via io_uring failed");
+                goto exit;
+            }
+
+            /*
+             * Multishot recv is terminated if there is no free buffers
+             * (ENOBUFS) or on some errors, it should be armed again.
+             */
+            if (!(cqe->flags & IORING_CQE_F_MORE))
+                armed = FALSE;
+
+            net_drv_uring_cqe_seen(&ring);
+        }
+    }
+
+    result = received;
+
+exit:
+
+    net_drv_uring_fini(&ring);
+    if (br != NULL)
+        munmap(br, br_len);
+    free(bufs);
+    return result;
+}
+
+#else
+
+static int64_t
+uring_send(tarpc_net_drv_uring_send_in *in,
+           tarpc_net_drv_uring_send_out *out)
+{
+    UNUSED(in);
+    UNUSED(out);
+
+    te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EOPNOTSUPP),
+                     "io_uring multishot recv is not supported");
+    return -1;
+}
+
+static int64_t
+uring_recv(tarpc_net_drv_uring_recv_in *in,
+           tarpc_net_drv_uring_recv_out *out)
+{
+    UNUSED(in);
+    UNUSED(out);
+
+    te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EOPNOTSUPP),
+                     "io_uring multishot recv is not supported");
+    return -1;
+}
+
+#endif
+
+TARPC_FUNC_STANDALONE(net_drv_uring_send, {},
+{
+    MAKE_CALL(out->retval = uring_send(in, out));
+})
+
+TARPC_FUNC_STANDALONE(net_drv_uring_recv, {},
+{
+    MAKE_CALL(out->retval = uring_recv(in, out));
+})
+
+/** Prefix of names of threaded NAPI kernel threads */
+#define NET_DRV_NAPI_THREAD_PREFIX "napi/"
+
+/**
+ * Read the first line of a file under /proc/<pid>/.
+ *
+ * @param pid       Process ID.
+ * @param name      File name.
+ * @param buf       Where to save the line.
+ * @param len       Size of @p buf.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+napi_read_proc_line(const char *pid, const char *name, char *buf,
+                    size_t len)
+{
+    char path[PATH_MAX];
+    FILE *f;
+    int rc = 0;
+
+    snprintf(path, sizeof(path), "/proc/%s/%s", pid, name);
+    f = fopen(path, "r");
+    if (f == NULL)
+        return -1;
+
+    if (fgets(buf, len, f) == NULL)
+        rc = -1;
+    else
+        buf[strcspn(buf, "\n")] = '\0';
+
+    fclose(f);
+    return rc;
+}
+
+/**
+ * Get CPU time and the last CPU of a thread from /proc/<pid>/stat.
+ *
+ * @param pid       Process ID.
+ * @param thread    Where to save CPU time and CPU.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+napi_get_thread_stat(const char *pid, tarpc_net_drv_napi_thread *thread)
+{
+    char buf[1024];
+    char *p;
+    unsigned long long utime;
+    unsigned long long stime;
+    long ticks = sysconf(_SC_CLK_TCK);
+    int cpu;
+    int i;
+
+    if (napi_read_proc_line(pid, "stat", buf, sizeof(buf)) != 0 ||
+        ticks <= 0)
+        return -1;
+
+    /* Thread name may contain spaces, fields are counted after it */
+    p = strrchr(buf, ')');
+    if (p == NULL)
+        return -1;
+
+    /* Skip to utime (field 14), fields 1 and 2 are PID and name */
+    for (i = 2; i < 13 && p != NULL; i++)
+        p = strchr(p + 1, ' ');
+    if (p == NULL || sscanf(p, " %llu %llu", &utime, &stime) != 2)
+        return -1;
+
+    /* Skip to processor (field 39) */
+    for (; i < 38 && p != NULL; i++)
+        p = strchr(p + 1, ' ');
+    if (p == NULL || sscanf(p, " %d", &cpu) != 1)
+        return -1;
+
+    thread->cpu_time = (utime + stime) * 1000000000ULL / ticks;
+    thread->cpu = cpu;
+
+    return 0;
+}
+
+static int64_t
+napi_threads(tarpc_net_drv_napi_threads_in *in,
+             tarpc_net_drv_napi_threads_out *out)
+{
+    tarpc_net_drv_napi_thread *threads = NULL;
+    tarpc_net_drv_napi_thread *new_threads;
+    tarpc_net_drv_napi_thread thread;
+    unsigned int threads_num = 0;
+    char prefix[IFNAMSIZ + sizeof(NET_DRV_NAPI_THREAD_PREFIX) + 1];
+    char name[128];
+    struct dirent *ent;
+    cpu_set_t cpuset;
+    DIR *dir;
+    size_t n;
+    int64_t result = 0;
+
+    snprintf(prefix, sizeof(prefix), NET_DRV_NAPI_THREAD_PREFIX "%s-",
+             in->if_name);
+
+    dir = opendir("/proc");
+    if (dir == NULL)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to open /proc");
+        return -1;
+    }
+
+    while ((ent = readdir(dir)) != NULL)
+    {
+        if (!isdigit(ent->d_name[0]))
+            continue;
+
+        /*
+         * Name in "status" is not truncated to TASK_COMM_LEN for kernel
+         * threads on recent kernels, so it is preferred to "comm".
+         */
+        if (napi_read_proc_line(ent->d_name, "status", name,
+                                sizeof(name)) != 0 ||
+            strncmp(name, "Name:", strlen("Name:")) != 0)
+            continue;
+
+        n = strlen("Name:") + strspn(name + strlen("Name:"), " \t");
+        if (strncmp(name + n, prefix, strlen(prefix)) != 0)
+            continue;
+
+        memset(&thread, 0, sizeof(thread));
+        thread.pid = atoi(ent->d_name);
+        thread.napi_id = strtoul(name + n + strlen(prefix), NULL, 10);
+
+        if (in->cpus.cpus_len > 0)
+        {
+            CPU_ZERO(&cpuset);
+            CPU_SET(in->cpus.cpus_val[threads_num % in->cpus.cpus_len],
+                    &cpuset);
+            if (sched_setaffinity(thread.pid, sizeof(cpuset), &cpuset) != 0)
+            {
+                te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                                 "failed to bind %s to a CPU", name + n);
+                result = -1;
+                break;
+            }
+        }
+
+        /* The thread could have exited, it is not an error */
+        if (napi_get_thread_stat(ent->d_name, &thread) != 0)
+            continue;
+        thread.ts = get_mono_raw_ns();
+
+        new_threads = realloc(threads,
+                              (threads_num + 1) * sizeof(*threads));
+        if (new_threads == NULL)
+        {
+            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                             "failed to allocate memory");
+            result = -1;
+            break;
+        }
+        threads = new_threads;
+        threads[threads_num++] = thread;
+    }
+
+    closedir(dir);
+
+    if (result < 0)
+    {
+        free(threads);
+        return result;
+    }
+
+    out->threads.threads_val = threads;
+    out->threads.threads_len = threads_num;
+    return threads_num;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_napi_threads, {},
+{
+    MAKE_CALL(out->retval = napi_threads(in, out));
+})
+
+/*
+ * AF_XDP sockets are used via raw system calls (like io_uring above)
+ * to avoid dependency on libxdp. XDP_USE_NEED_WAKEUP appeared in
+ * Linux 5.4 together with flags field of rings.
+ */
+#if defined(XDP_USE_NEED_WAKEUP) && defined(AF_XDP) && defined(__NR_bpf)
+
+/** Producer/consumer ring of AF_XDP socket mapped to user space */
+typedef struct xsk_ring {
+    uint32_t *producer;     /**< Producer index */
+    uint32_t *consumer;     /**< Consumer index */
+    uint32_t *flags;        /**< Ring flags */
+    void *descs;            /**< Ring entries */
+    uint32_t mask;          /**< Mask applied to indexes */
+    void *map;              /**< Mapped memory */
+    size_t map_len;         /**< Length of mapped memory */
+} xsk_ring;
+
+/** Context of a thread serving a single queue in net_drv_xsk_batch() */
+typedef struct xsk_queue {
+    pthread_t tid;              /**< Thread ID */
+    te_bool started;            /**< Whether the thread was started */
+    int cpu;                    /**< CPU to which to bind the thread */
+    int fd;                     /**< AF_XDP socket */
+    uint8_t *umem;              /**< UMEM memory */
+    size_t umem_len;            /**< Length of UMEM memory */
+    uint32_t frame_size;        /**< Size of UMEM frame */
+    xsk_ring fill;              /**< FILL ring */
+    xsk_ring comp;              /**< COMPLETION ring */
+    xsk_ring rx;                /**< Rx ring */
+    xsk_ring tx;                /**< Tx ring */
+    te_bool need_wakeup;        /**< Whether need_wakeup is enabled */
+    tarpc_net_drv_xsk_mode mode; /**< What to do with received packets */
+    unsigned int batch;         /**< Maximum number of packets processed
+                                     at once */
+    uint64_t tx_pending;        /**< Number of sent but not completed
+                                     packets */
+    uint64_t end;               /**< When to stop (in ns); it is reset
+                                     to stop the thread early */
+    te_errno rc;                /**< Error occurred in the thread */
+
+    /** Where to save queue statistics */
+    tarpc_net_drv_xsk_queue_stats *stats;
+} xsk_queue;
+
+/**
+ * Map a ring of AF_XDP socket.
+ *
+ * @param fd        AF_XDP socket.
+ * @param off       Offsets of ring fields reported by the kernel.
+ * @param size      Number of entries in the ring.
+ * @param desc_size Size of a ring entry.
+ * @param pgoff     Offset passed to mmap() to choose the ring.
+ * @param ring      Where to save mapped ring.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+xsk_ring_map(int fd, const struct xdp_ring_offset *off, uint32_t size,
+             size_t desc_size, off_t pgoff, xsk_ring *ring)
+{
+    uint8_t *map;
+
+    ring->map_len = off->desc + size * desc_size;
+    map = mmap(NULL, ring->map_len, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, fd, pgoff);
+    if (map == MAP_FAILED)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to map AF_XDP ring");
+        return -1;
+    }
+
+    ring->map = map;
+    ring->producer = (uint32_t *)(map + off->producer);
+    ring->consumer = (uint32_t *)(map + off->consumer);
+    ring->flags = (uint32_t *)(map + off->flags);
+    ring->descs = map + off->desc;
+    ring->mask = size - 1;
+
+    return 0;
+}
+
+/** Number of entries available to consumer, not more than @p max */
+static uint32_t
+xsk_ring_cons_avail(xsk_ring *ring, uint32_t max)
+{
+    uint32_t avail = __atomic_load_n(ring->producer, __ATOMIC_ACQUIRE) -
+                     *ring->consumer;
+
+    return MIN(avail, max);
+}
+
+/** Release @p n entries of a ring to producer */
+static void
+xsk_ring_cons_release(xsk_ring *ring, uint32_t n)
+{
+    __atomic_store_n(ring->consumer, *ring->consumer + n, __ATOMIC_RELEASE);
+}
+
+/** Pass @p n entries of a ring to consumer */
+static void
+xsk_ring_prod_submit(xsk_ring *ring, uint32_t n)
+{
+    __atomic_store_n(ring->producer, *ring->producer + n, __ATOMIC_RELEASE);
+}
+
+/** Check whether the kernel should be woken up to process a ring */
+static te_bool
+xsk_ring_needs_wakeup(xsk_ring *ring)
+{
+    return (__atomic_load_n(ring->flags, __ATOMIC_RELAXED) &
+            XDP_RING_NEED_WAKEUP) != 0;
+}
+
+/** Release resources of AF_XDP socket */
+static void
+xsk_queue_close(xsk_queue *q)
+{
+    xsk_ring *rings[] = { &q->fill, &q->comp, &q->rx, &q->tx };
+    unsigned int i;
+
+    for (i = 0; i < TE_ARRAY_LEN(rings); i++)
+    {
+        if (rings[i]->map != NULL)
+            munmap(rings[i]->map, rings[i]->map_len);
+    }
+
+    if (q->fd >= 0)
+        close(q->fd);
+    if (q->umem != NULL)
+        munmap(q->umem, q->umem_len);
+}
+
+/**
+ * Create AF_XDP socket with its own UMEM, put all UMEM frames to its
+ * FILL ring, bind it to an interface queue and insert it to XSK map.
+ *
+ * @param in        RPC input (socket parameters).
+ * @param ifindex   Interface index.
+ * @param idx       Index of the queue in @p in.
+ * @param q         Where to save socket context.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+xsk_queue_open(tarpc_net_drv_xsk_batch_in *in, unsigned int ifindex,
+               unsigned int idx, xsk_queue *q)
+{
+    struct xdp_umem_reg mr;
+    struct xdp_mmap_offsets off;
+    struct sockaddr_xdp sxdp;
+    socklen_t optlen = sizeof(off);
+    union bpf_attr attr;
+    uint32_t queue_id = in->queues.queues_val[idx];
+    uint32_t fd_val;
+    uint64_t *addrs;
+    unsigned int i;
+
+    q->umem_len = (size_t)in->frames_num * in->frame_size;
+    q->umem = mmap(NULL, q->umem_len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (q->umem == MAP_FAILED)
+    {
+        q->umem = NULL;
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to allocate UMEM");
+        return -1;
+    }
+
+    q->fd = socket(AF_XDP, SOCK_RAW, 0);
+    if (q->fd < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to create AF_XDP socket");
+        return -1;
+    }
+
+    memset(&mr, 0, sizeof(mr));
+    mr.addr = (uintptr_t)q->umem;
+    mr.len = q->umem_len;
+    mr.chunk_size = in->frame_size;
+    if (setsockopt(q->fd, SOL_XDP, XDP_UMEM_REG, &mr, sizeof(mr)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to register UMEM");
+        return -1;
+    }
+
+    /*
+     * FILL and COMPLETION rings can hold all the frames, so frames
+     * returned to FILL ring always fit there.
+     */
+    if (setsockopt(q->fd, SOL_XDP, XDP_UMEM_FILL_RING, &in->frames_num,
+                   sizeof(in->frames_num)) < 0 ||
+        setsockopt(q->fd, SOL_XDP, XDP_UMEM_COMPLETION_RING,
+                   &in->frames_num, sizeof(in->frames_num)) < 0 ||
+        setsockopt(q->fd, SOL_XDP, XDP_RX_RING, &in->ring_size,
+                   sizeof(in->ring_size)) < 0 ||
+        setsockopt(q->fd, SOL_XDP, XDP_TX_RING, &in->ring_size,
+                   sizeof(in->ring_size)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to set AF_XDP ring size");
+        return -1;
+    }
+
+    if (getsockopt(q->fd, SOL_XDP, XDP_MMAP_OFFSETS, &off, &optlen) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to get AF_XDP rings offsets");
+        return -1;
+    }
+
+    if (xsk_ring_map(q->fd, &off.fr, in->frames_num, sizeof(uint64_t),
+                     XDP_UMEM_PGOFF_FILL_RING, &q->fill) < 0 ||
+        xsk_ring_map(q->fd, &off.cr, in->frames_num, sizeof(uint64_t),
+                     XDP_UMEM_PGOFF_COMPLETION_RING, &q->comp) < 0 ||
+        xsk_ring_map(q->fd, &off.rx, in->ring_size,
+                     sizeof(struct xdp_desc), XDP_PGOFF_RX_RING,
+                     &q->rx) < 0 ||
+        xsk_ring_map(q->fd, &off.tx, in->ring_size,
+                     sizeof(struct xdp_desc), XDP_PGOFF_TX_RING,
+                     &q->tx) < 0)
+    {
+        return -1;
+    }
+
+    addrs = q->fill.descs;
+    for (i = 0; i < in->frames_num; i++)
+        addrs[i] = (uint64_t)i * in->frame_size;
+    xsk_ring_prod_submit(&q->fill, in->frames_num);
+
+    memset(&sxdp, 0, sizeof(sxdp));
+    sxdp.sxdp_family = AF_XDP;
+    sxdp.sxdp_ifindex = ifindex;
+    sxdp.sxdp_queue_id = queue_id;
+    if (in->flags & TARPC_NET_DRV_XSK_COPY)
+        sxdp.sxdp_flags |= XDP_COPY;
+    if (in->flags & TARPC_NET_DRV_XSK_ZEROCOPY)
+        sxdp.sxdp_flags |= XDP_ZEROCOPY;
+    if (in->flags & TARPC_NET_DRV_XSK_NEED_WAKEUP)
+        sxdp.sxdp_flags |= XDP_USE_NEED_WAKEUP;
+
+    if (bind(q->fd, SA(&sxdp), sizeof(sxdp)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to bind AF_XDP socket to queue %u",
+                         queue_id);
+        return -1;
+    }
+
+    fd_val = q->fd;
+    memset(&attr, 0, sizeof(attr));
+    attr.map_fd = in->map_fd;
+    attr.key = (uintptr_t)&queue_id;
+    attr.value = (uintptr_t)&fd_val;
+    attr.flags = BPF_ANY;
+    if (syscall(__NR_bpf, BPF_MAP_UPDATE_ELEM, &attr, sizeof(attr)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to add AF_XDP socket to XSK map");
+        return -1;
+    }
+
+    q->frame_size = in->frame_size;
+    q->need_wakeup = (in->flags & TARPC_NET_DRV_XSK_NEED_WAKEUP) != 0;
+    q->mode = in->mode;
+    q->batch = in->batch;
+    return 0;
+}
+
+/** Kick the kernel to send packets from Tx ring if it is required */
+static void
+xsk_queue_kick_tx(xsk_queue *q)
+{
+    if (q->need_wakeup && !xsk_ring_needs_wakeup(&q->tx))
+        return;
+
+    /* EAGAIN, EBUSY and ENOBUFS only mean that Tx ring is busy */
+    sendto(q->fd, NULL, 0, MSG_DONTWAIT, NULL, 0);
+    q->stats->wakeups++;
+}
+
+/** Return frames of sent packets from COMPLETION ring to FILL ring */
+static void
+xsk_queue_complete_tx(xsk_queue *q)
+{
+    uint64_t *comp_addrs = q->comp.descs;
+    uint64_t *fill_addrs = q->fill.descs;
+    uint32_t comp_idx = *q->comp.consumer;
+    uint32_t fill_idx = *q->fill.producer;
+    uint32_t n;
+    uint32_t i;
+
+    n = xsk_ring_cons_avail(&q->comp, UINT32_MAX);
+    if (n == 0)
+        return;
+
+    for (i = 0; i < n; i++)
+    {
+        fill_addrs[(fill_idx + i) & q->fill.mask] =
+            comp_addrs[(comp_idx + i) & q->comp.mask];
+    }
+
+    xsk_ring_prod_submit(&q->fill, n);
+    xsk_ring_cons_release(&q->comp, n);
+    q->tx_pending -= n;
+}
+
+/**
+ * Process a batch of received packets: either return their frames
+ * to FILL ring at once or send them back with swapped MAC addresses.
+ *
+ * @return Number of processed packets.
+ */
+static uint32_t
+xsk_queue_process_rx(xsk_queue *q)
+{
+    struct xdp_desc *rx_descs = q->rx.descs;
+    struct xdp_desc *tx_descs = q->tx.descs;
+    uint64_t *fill_addrs = q->fill.descs;
+    uint32_t rx_idx = *q->rx.consumer;
+    uint32_t idx;
+    uint32_t tx_free;
+    uint32_t n;
+    uint32_t i;
+    uint8_t *frame;
+    uint8_t mac[ETH_ALEN];
+
+    n = xsk_ring_cons_avail(&q->rx, q->batch);
+    if (n == 0)
+        return 0;
+
+    if (q->mode == TARPC_NET_DRV_XSK_RX_DROP)
+    {
+        idx = *q->fill.producer;
+        for (i = 0; i < n; i++)
+        {
+            fill_addrs[(idx + i) & q->fill.mask] =
+                rx_descs[(rx_idx + i) & q->rx.mask].addr &
+                ~(uint64_t)(q->frame_size - 1);
+        }
+        xsk_ring_prod_submit(&q->fill, n);
+        xsk_ring_cons_release(&q->rx, n);
+        return n;
+    }
+
+    idx = *q->tx.producer;
+    tx_free = q->tx.mask + 1 -
+              (idx - __atomic_load_n(q->tx.consumer, __ATOMIC_ACQUIRE));
+    n = MIN(n, tx_free);
+
+    for (i = 0; i < n; i++)
+    {
+        tx_descs[(idx + i) & q->tx.mask] =
+            rx_descs[(rx_idx + i) & q->rx.mask];
+
+        frame = q->umem + tx_descs[(idx + i) & q->tx.mask].addr;
+        memcpy(mac, frame, ETH_ALEN);
+        memcpy(frame, frame + ETH_ALEN, ETH_ALEN);
+        memcpy(frame + ETH_ALEN, mac, ETH_ALEN);
+    }
+
+    if (n > 0)
+    {
+        xsk_ring_prod_submit(&q->tx, n);
+        xsk_ring_cons_release(&q->rx, n);
+        q->tx_pending += n;
+        q->stats->tx_pkts += n;
+    }
+
+    return n;
+}
+
+/* Main function of a thread serving a queue in net_drv_xsk_batch() */
+static void *
+xsk_batch_thread_main(void *arg)
+{
+    xsk_queue *q = arg;
+    cpu_set_t cpuset;
+    uint32_t n;
+    int os_rc;
+
+    if (q->cpu >= 0)
+    {
+        CPU_ZERO(&cpuset);
+        CPU_SET(q->cpu, &cpuset);
+        os_rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset),
+                                       &cpuset);
+        if (os_rc != 0)
+        {
+            q->rc = te_rc_os2te(os_rc);
+            ERROR("%s(): failed to bind thread to CPU %d: %r",
+                  __FUNCTION__, q->cpu, q->rc);
+            return NULL;
+        }
+    }
+
+    while (get_mono_raw_ns() < __atomic_load_n(&q->end, __ATOMIC_RELAXED))
+    {
+        if (q->mode == TARPC_NET_DRV_XSK_FWD)
+            xsk_queue_complete_tx(q);
+
+        n = xsk_queue_process_rx(q);
+        q->stats->rx_pkts += n;
+
+        if (q->tx_pending > 0)
+            xsk_queue_kick_tx(q);
+
+        /*
+         * With need_wakeup the driver stops polling FILL ring when it
+         * is empty on its side, it should be woken up explicitly.
+         */
+        if (n == 0 && q->need_wakeup && xsk_ring_needs_wakeup(&q->fill))
+        {
+            recvfrom(q->fd, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+            q->stats->wakeups++;
+        }
+    }
+
+    return NULL;
+}
+
+static int64_t
+xsk_batch(tarpc_net_drv_xsk_batch_in *in,
+          tarpc_net_drv_xsk_batch_out *out)
+{
+    unsigned int queues_num = in->queues.queues_len;
+    xsk_queue *queues = NULL;
+    tarpc_net_drv_xsk_queue_stats *stats = NULL;
+    unsigned int ifindex;
+    uint64_t end;
+    int64_t result = 0;
+    unsigned int i;
+    int os_rc;
+
+    if (queues_num == 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "no queues specified");
+        return -1;
+    }
+
+    if (in->cpus.cpus_len != 0 && in->cpus.cpus_len != queues_num)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "number of CPUs does not match number of queues");
+        return -1;
+    }
+
+    if (in->frame_size == 0 || (in->frame_size & (in->frame_size - 1)) ||
+        in->frames_num == 0 || (in->frames_num & (in->frames_num - 1)) ||
+        in->ring_size == 0 || (in->ring_size & (in->ring_size - 1)))
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "frame size, number of frames and ring size "
+                         "must be powers of 2");
+        return -1;
+    }
+
+    if (in->batch == 0 || in->batch > in->ring_size)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "batch size must be in range [1, %u]",
+                         in->ring_size);
+        return -1;
+    }
+
+    ifindex = if_nametoindex(in->if_name);
+    if (ifindex == 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to get index of %s", in->if_name);
+        return -1;
+    }
+
+    queues = calloc(queues_num, sizeof(*queues));
+    stats = calloc(queues_num, sizeof(*stats));
+    if (queues == NULL || stats == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate memory");
+        result = -1;
+        goto finish;
+    }
+
+    for (i = 0; i < queues_num; i++)
+        queues[i].fd = -1;
+
+    for (i = 0; i < queues_num; i++)
+    {
+        if (xsk_queue_open(in, ifindex, i, &queues[i]) < 0)
+        {
+            result = -1;
+            goto finish;
+        }
+    }
+
+    end = get_mono_raw_ns() + (uint64_t)in->time2run * 1000000ULL;
+    for (i = 0; i < queues_num; i++)
+    {
+        queues[i].cpu = (in->cpus.cpus_len > 0 ?
+                         in->cpus.cpus_val[i] : -1);
+        queues[i].end = end;
+        queues[i].stats = &stats[i];
+
+        os_rc = pthread_create(&queues[i].tid, NULL,
+                               xsk_batch_thread_main, &queues[i]);
+        if (os_rc != 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, os_rc),
+                             "failed to create queue thread");
+            result = -1;
+
+            /* Stop already started threads instead of waiting for end */
+            while (i-- > 0)
+                __atomic_store_n(&queues[i].end, 0, __ATOMIC_RELAXED);
+            break;
+        }
+
+        queues[i].started = TRUE;
+    }
+
+finish:
+
+    if (queues != NULL)
+    {
+        for (i = 0; i < queues_num; i++)
+        {
+            if (queues[i].started)
+            {
+                pthread_join(queues[i].tid, NULL);
+                if (queues[i].rc != 0 && result >= 0)
+                {
+                    te_rpc_error_set(TE_RC(TE_TA_UNIX, queues[i].rc),
+                                     "thread of queue %u failed",
+                                     in->queues.queues_val[i]);
+                    result = -1;
+                }
+            }
+
+            xsk_queue_close(&queues[i]);
+        }
+    }
+
+    if (result >= 0)
+    {
+        for (i = 0; i < queues_num; i++)
+            result += stats[i].rx_pkts;
+
+        out->stats.stats_val = stats;
+        out->stats.stats_len = queues_num;
+        stats = NULL;
+    }
+
+    free(queues);
+    free(stats);
+
+    return result;
+}
+
+#else
+
+static int64_t
+xsk_batch(tarpc_net_drv_xsk_batch_in *in,
+          tarpc_net_drv_xsk_batch_out *out)
+{
+    UNUSED(in);
+    UNUSED(out);
+
+    te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOSYS),
+                     "AF_XDP headers were not available when "
+                     "building Test Agent");
+    return -1;
+}
+
+#endif
+
+TARPC_FUNC_STANDALONE(net_drv_xsk_batch, {},
+{
+    MAKE_CALL(out->retval = xsk_batch(in, out));
+})
+
+/** Timeout of blocking calls on connections of net_drv_cps_*(), in ms */
+#define NET_DRV_CPS_IO_TIMEOUT 2000
+
+/**
+ * Timeout of accept() in net_drv_cps_server() after which a thread
+ * checks whether it should stop, in ms.
+ */
+#define NET_DRV_CPS_ACCEPT_TIMEOUT 100
+
+/** Backlog of listening sockets of net_drv_cps_server() */
+#define NET_DRV_CPS_BACKLOG 4096
+
+/** Context of a client or server thread of net_drv_cps_*() */
+typedef struct cps_thread {
+    pthread_t tid;              /**< Thread ID */
+    te_bool started;            /**< Whether the thread was started */
+    int cpu;                    /**< CPU to which to bind the thread */
+    const struct sockaddr *addr; /**< Server address */
+    int listen_s;               /**< Listening socket (server only) */
+    uint8_t *buf;               /**< Buffer for request and response */
+    size_t req_size;            /**< Size of request */
+    size_t resp_size;           /**< Size of response */
+    uint64_t end;               /**< When to stop (in ns) */
+    te_errno rc;                /**< Error occurred in the thread */
+
+    /** Where to save thread statistics */
+    tarpc_net_drv_cps_thread_stats *stats;
+} cps_thread;
+
+/** Set send and receive timeouts of a socket */
+static int
+cps_set_timeout(int s, unsigned int timeout_ms)
+{
+    struct timeval tv;
+
+    tv.tv_sec = timeout_ms / 1000;
+    tv.tv_usec = (timeout_ms % 1000) * 1000;
+
+    if (setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0 ||
+        setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) < 0)
+        return -1;
+
+    return 0;
+}
+
+/**
+ * Send or receive exactly @p len bytes over a connection.
+ *
+ * @return @c 0 on success, @c -1 on failure or if connection
+ *         was closed by peer.
+ */
+static int
+cps_xfer(int s, uint8_t *buf, size_t len, te_bool send_data)
+{
+    size_t done = 0;
+    ssize_t rc;
+
+    while (done < len)
+    {
+        if (send_data)
+            rc = send(s, buf + done, len - done, MSG_NOSIGNAL);
+        else
+            rc = recv(s, buf + done, len - done, 0);
+
+        if (rc <= 0)
+            return -1;
+
+        done += rc;
+    }
+
+    return 0;
+}
+
+/* Bind the calling thread to a CPU (if it is not negative) */
+static te_errno
+cps_thread_bind_cpu(int cpu)
+{
+    cpu_set_t cpuset;
+    int os_rc;
+
+    if (cpu < 0)
+        return 0;
+
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    os_rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset),
+                                   &cpuset);
+    if (os_rc != 0)
+    {
+        ERROR("%s(): failed to bind thread to CPU %d: %r",
+              __FUNCTION__, cpu, te_rc_os2te(os_rc));
+        return te_rc_os2te(os_rc);
+    }
+
+    return 0;
+}
+
+/*
+ * Main function of a client thread of net_drv_cps_client(): open
+ * a connection, send a request, receive a response, wait until
+ * the server closes the connection and close it too; repeat.
+ */
+static void *
+cps_client_thread_main(void *arg)
+{
+    cps_thread *th = arg;
+    uint8_t byte;
+    int s;
+
+    th->rc = cps_thread_bind_cpu(th->cpu);
+    if (th->rc != 0)
+        return NULL;
+
+    while (get_mono_raw_ns() < th->end)
+    {
+        s = socket(th->addr->sa_family, SOCK_STREAM, 0);
+        if (s < 0)
+        {
+            th->rc = te_rc_os2te(errno);
+            ERROR("%s(): failed to create socket: %r", __FUNCTION__,
+                  th->rc);
+            break;
+        }
+
+        /*
+         * The server closes a connection first, so that TIME_WAIT
+         * sockets do not exhaust ephemeral ports on the client.
+         */
+        if (cps_set_timeout(s, NET_DRV_CPS_IO_TIMEOUT) < 0 ||
+            connect(s, th->addr, te_sockaddr_get_size(th->addr)) < 0 ||
+            cps_xfer(s, th->buf, th->req_size, TRUE) < 0 ||
+            cps_xfer(s, th->buf, th->resp_size, FALSE) < 0 ||
+            recv(s, &byte, sizeof(byte), 0) != 0)
+        {
+            th->stats->errors++;
+        }
+        else
+        {
+            th->stats->conns++;
+        }
+
+        close(s);
+    }
+
+    return NULL;
+}
+
+/*
+ * Main function of a server thread of net_drv_cps_server(): accept
+ * a connection, receive a request, send a response and close
+ * the connection; repeat.
+ */
+static void *
+cps_server_thread_main(void *arg)
+{
+    cps_thread *th = arg;
+    int s;
+
+    th->rc = cps_thread_bind_cpu(th->cpu);
+    if (th->rc != 0)
+        return NULL;
+
+    while (get_mono_raw_ns() < th->end)
+    {
+        s = accept(th->listen_s, NULL, NULL);
+        if (s < 0)
+        {
+            /* Timeout of accept() is reported as EAGAIN */
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                th->stats->errors++;
+            continue;
+        }
+
+        if (cps_set_timeout(s, NET_DRV_CPS_IO_TIMEOUT) < 0 ||
+            cps_xfer(s, th->buf, th->req_size, FALSE) < 0 ||
+            cps_xfer(s, th->buf, th->resp_size, TRUE) < 0)
+        {
+            th->stats->errors++;
+        }
+        else
+        {
+            th->stats->conns++;
+        }
+
+        close(s);
+    }
+
+    return NULL;
+}
+
+/**
+ * Create a listening socket of a server thread. All the threads
+ * listen on the same address with @c SO_REUSEPORT, so that incoming
+ * connections are spread between them.
+ *
+ * @param addr      Address to listen on.
+ *
+ * @return Socket on success, @c -1 on failure.
+ */
+static int
+cps_listen_socket(const struct sockaddr *addr)
+{
+    int on = 1;
+    int s;
+
+    s = socket(addr->sa_family, SOCK_STREAM, 0);
+    if (s < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to create socket");
+        return -1;
+    }
+
+    if (setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) < 0 ||
+        setsockopt(s, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) < 0 ||
+        cps_set_timeout(s, NET_DRV_CPS_ACCEPT_TIMEOUT) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to set socket options");
+        close(s);
+        return -1;
+    }
+
+    if (bind(s, addr, te_sockaddr_get_size(addr)) < 0 ||
+        listen(s, NET_DRV_CPS_BACKLOG) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to bind or listen");
+        close(s);
+        return -1;
+    }
+
+    return s;
+}
+
+/**
+ * Run client or server threads of net_drv_cps_*().
+ *
+ * @param rpc_addr      Server address in RPC format.
+ * @param cpus          CPUs to which to bind threads (one thread is
+ *                      created per element).
+ * @param threads_num   Number of elements in @p cpus.
+ * @param req_size      Size of request.
+ * @param resp_size     Size of response.
+ * @param time2run      How long to run, in ms.
+ * @param server        Whether to run server threads.
+ * @param stats_out     Where to save per-thread statistics.
+ *
+ * @return Total number of completed connections on success,
+ *         @c -1 on failure.
+ */
+static int64_t
+cps_run(struct tarpc_sa *rpc_addr, const tarpc_int *cpus,
+        unsigned int threads_num, uint32_t req_size, uint32_t resp_size,
+        uint32_t time2run, te_bool server,
+        tarpc_net_drv_cps_thread_stats **stats_out)
+{
+    cps_thread *threads = NULL;
+    tarpc_net_drv_cps_thread_stats *stats = NULL;
+    struct sockaddr_storage addr_st;
+    struct sockaddr *addr = SA(&addr_st);
+    uint8_t *bufs = NULL;
+    size_t buf_size = MAX(MAX(req_size, resp_size), 1);
+    uint64_t end;
+    int64_t result = 0;
+    unsigned int i;
+    te_errno err;
+    int os_rc;
+
+    if (threads_num == 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EINVAL),
+                         "no CPUs specified for threads");
+        return -1;
+    }
+
+    err = sockaddr_rpc2h(rpc_addr, addr, sizeof(addr_st), NULL, NULL);
+    if (err != 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, err),
+                         "failed to convert address");
+        return -1;
+    }
+
+    threads = calloc(threads_num, sizeof(*threads));
+    stats = calloc(threads_num, sizeof(*stats));
+    bufs = calloc(threads_num, buf_size);
+    if (threads == NULL || stats == NULL || bufs == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate memory");
+        result = -1;
+        goto finish;
+    }
+
+    for (i = 0; i < threads_num; i++)
+    {
+        threads[i].listen_s = -1;
+        if (server)
+        {
+            threads[i].listen_s = cps_listen_socket(addr);
+            if (threads[i].listen_s < 0)
+            {
+                result = -1;
+                goto finish;
+            }
+        }
+    }
+
+    end = get_mono_raw_ns() + (uint64_t)time2run * 1000000ULL;
+    for (i = 0; i < threads_num; i++)
+    {
+        threads[i].cpu = cpus[i];
+        threads[i].addr = addr;
+        threads[i].buf = bufs + i * buf_size;
+        threads[i].req_size = req_size;
+        threads[i].resp_size = resp_size;
+        threads[i].end = end;
+        threads[i].stats = &stats[i];
+
+        os_rc = pthread_create(&threads[i].tid, NULL,
+                               server ? cps_server_thread_main :
+                                        cps_client_thread_main,
+                               &threads[i]);
+        if (os_rc != 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, os_rc),
+                             "failed to create thread");
+            result = -1;
+            break;
+        }
+
+        threads[i].started = TRUE;
+    }
+
+finish:
+
+    if (threads != NULL)
+    {
+        for (i = 0; i < threads_num; i++)
+        {
+            if (threads[i].started)
+            {
+                pthread_join(threads[i].tid, NULL);
+                if (threads[i].rc != 0 && result >= 0)
+                {
+                    te_rpc_error_set(TE_RC(TE_TA_UNIX, threads[i].rc),
+                                     "thread %u failed", i);
+                    result = -1;
+                }
+            }
+
+            if (threads[i].listen_s >= 0)
+                close(threads[i].listen_s);
+        }
+    }
+
+    if (result >= 0)
+    {
+        for (i = 0; i < threads_num; i++)
+            result += stats[i].conns;
+
+        *stats_out = stats;
+        stats = NULL;
+    }
+
+    free(threads);
+    free(stats);
+    free(bufs);
+
+    return result;
+}
+
+/**
+ * Get value of a TcpExt counter from /proc/net/netstat.
+ *
+ * @param name      Counter name.
+ * @param value     Where to save the value.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+get_tcp_ext_counter(const char *name, uint64_t *value)
+{
+    static const char prefix[] = "TcpExt:";
+    char names[8192];
+    char values[8192];
+    char *name_saveptr = NULL;
+    char *value_saveptr = NULL;
+    char *n;
+    char *v;
+    FILE *f;
+    int rc = -1;
+
+    f = fopen("/proc/net/netstat", "r");
+    if (f == NULL)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to open /proc/net/netstat");
+        return -1;
+    }
+
+    /* Every group of counters is a line of names and a line of values */
+    while (rc != 0 && fgets(names, sizeof(names), f) != NULL &&
+           fgets(values, sizeof(values), f) != NULL)
+    {
+        if (strncmp(names, prefix, strlen(prefix)) != 0)
+            continue;
+
+        n = strtok_r(names + strlen(prefix), " \n", &name_saveptr);
+        v = strtok_r(values + strlen(prefix), " \n", &value_saveptr);
+        while (n != NULL && v != NULL)
+        {
+            if (strcmp(n, name) == 0)
+            {
+                *value = strtoull(v, NULL, 10);
+                rc = 0;
+                break;
+            }
+
+            n = strtok_r(NULL, " \n", &name_saveptr);
+            v = strtok_r(NULL, " \n", &value_saveptr);
+        }
+    }
+
+    fclose(f);
+
+    if (rc != 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOENT),
+                         "TcpExt counter %s is not found", name);
+    }
+
+    return rc;
+}
+
+/*
+ * Open connections to a server from multiple threads, exchanging
+ * a single request and response over every connection.
+ */
+static int64_t
+cps_client(tarpc_net_drv_cps_client_in *in,
+           tarpc_net_drv_cps_client_out *out)
+{
+    tarpc_net_drv_cps_thread_stats *stats = NULL;
+    uint64_t retrans_before;
+    uint64_t retrans_after;
+    int64_t result;
+
+    if (get_tcp_ext_counter("TCPSynRetrans", &retrans_before) < 0)
+        return -1;
+
+    result = cps_run(&in->dst_addr, in->cpus.cpus_val, in->cpus.cpus_len,
+                     in->req_size, in->resp_size, in->time2run, FALSE,
+                     &stats);
+    if (result < 0)
+        return -1;
+
+    if (get_tcp_ext_counter("TCPSynRetrans", &retrans_after) < 0)
+    {
+        free(stats);
+        return -1;
+    }
+
+    out->stats.stats_val = stats;
+    out->stats.stats_len = in->cpus.cpus_len;
+    out->syn_retrans = retrans_after - retrans_before;
+
+    return result;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_cps_client, {},
+{
+    MAKE_CALL(out->retval = cps_client(in, out));
+})
+
+/*
+ * Accept connections in multiple threads, receiving a request and
+ * sending a response over every connection before closing it.
+ */
+static int64_t
+cps_server(tarpc_net_drv_cps_server_in *in,
+           tarpc_net_drv_cps_server_out *out)
+{
+    tarpc_net_drv_cps_thread_stats *stats = NULL;
+    int64_t result;
+
+    result = cps_run(&in->addr, in->cpus.cpus_val, in->cpus.cpus_len,
+                     in->req_size, in->resp_size, in->time2run, TRUE,
+                     &stats);
+    if (result < 0)
+        return -1;
+
+    out->stats.stats_val = stats;
+    out->stats.stats_len = in->cpus.cpus_len;
+
+    return result;
+}
+
+TARPC_FUNC_STANDALONE(net_drv_cps_server, {},
+{
+    MAKE_CALL(out->retval = cps_server(in, out));
+})
+
+/*
+ * Page pools are reported over netdev generic netlink family since
+ * Linux 6.8 (together with "page-pool" multicast group).
+ */
+#ifdef NETDEV_MCGRP_PAGE_POOL
+
+/** Size of buffer for generic netlink messages */
+#define NET_DRV_GENL_BUF_SIZE 32768
+
+/** Maximum attribute type parsed in generic netlink replies */
+#define NET_DRV_GENL_MAX_ATTR 32
+
+/** Generic netlink request with room for a few attributes */
+typedef struct genl_req {
+    struct nlmsghdr nh;     /**< Netlink header */
+    struct genlmsghdr gh;   /**< Generic netlink header */
+    uint8_t attrs[64];      /**< Attributes */
+} genl_req;
+
+/** Callback processing a generic netlink reply message */
+typedef void (*genl_msg_cb)(struct nlattr **tb, unsigned int max,
+                            void *ctx);
+
+/** Initialize generic netlink request */
+static void
+genl_req_init(genl_req *req, uint16_t type, uint16_t flags, uint8_t cmd,
+              uint8_t version)
+{
+    memset(req, 0, sizeof(*req));
+    req->nh.nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN);
+    req->nh.nlmsg_type = type;
+    req->nh.nlmsg_flags = NLM_F_REQUEST | flags;
+    req->gh.cmd = cmd;
+    req->gh.version = version;
+}
+
+/** Append string attribute to generic netlink request */
+static void
+genl_req_add_str(genl_req *req, uint16_t type, const char *str)
+{
+    struct nlattr *nla = (struct nlattr *)((uint8_t *)req +
+                                           NLMSG_ALIGN(req->nh.nlmsg_len));
+
+    nla->nla_type = type;
+    nla->nla_len = NLA_HDRLEN + strlen(str) + 1;
+    memcpy((uint8_t *)nla + NLA_HDRLEN, str, strlen(str) + 1);
+    req->nh.nlmsg_len = NLMSG_ALIGN(req->nh.nlmsg_len) +
+                        NLA_ALIGN(nla->nla_len);
+}
+
+/** Get value of unsigned integer attribute of any size */
+static uint64_t
+genl_attr_uint(const struct nlattr *nla)
+{
+    const uint8_t *data = (const uint8_t *)nla + NLA_HDRLEN;
+    uint64_t val64;
+    uint32_t val32;
+    uint16_t val16;
+
+    switch (nla->nla_len - NLA_HDRLEN)
+    {
+        case sizeof(val64):
+            memcpy(&val64, data, sizeof(val64));
+            return val64;
+
+        case sizeof(val32):
+            memcpy(&val32, data, sizeof(val32));
+            return val32;
+
+        case sizeof(val16):
+            memcpy(&val16, data, sizeof(val16));
+            return val16;
+
+        default:
+            return *data;
+    }
+}
+
+/**
+ * Send generic netlink request and process replies until the last
+ * one (NLMSG_DONE for dump requests).
+ *
+ * @param s         Netlink socket.
+ * @param req       Request.
+ * @param max       Maximum attribute type to parse (not greater than
+ *                  @c NET_DRV_GENL_MAX_ATTR).
+ * @param cb        Callback called for every reply.
+ * @param ctx       Callback context.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+genl_transact(int s, genl_req *req, unsigned int max, genl_msg_cb cb,
+              void *ctx)
+{
+    struct nlattr *tb[NET_DRV_GENL_MAX_ATTR + 1];
+    struct nlmsghdr *nh;
+    struct nlattr *nla;
+    struct nlmsgerr *err;
+    uint8_t *buf;
+    te_bool done = FALSE;
+    ssize_t len;
+    int attrs_len;
+    int rc = 0;
+
+    max = MIN(max, NET_DRV_GENL_MAX_ATTR);
+    buf = malloc(NET_DRV_GENL_BUF_SIZE);
+    if (buf == NULL)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOMEM),
+                         "failed to allocate memory");
+        return -1;
+    }
+
+    if (send(s, req, req->nh.nlmsg_len, 0) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to send netlink request");
+        free(buf);
+        return -1;
+    }
+
+    while (!done && rc == 0)
+    {
+        len = recv(s, buf, NET_DRV_GENL_BUF_SIZE, 0);
+        if (len < 0)
+        {
+            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                             "failed to receive netlink reply");
+            rc = -1;
+            break;
+        }
+
+        for (nh = (struct nlmsghdr *)buf; NLMSG_OK(nh, len);
+             nh = NLMSG_NEXT(nh, len))
+        {
+            if (nh->nlmsg_type == NLMSG_DONE)
+            {
+                done = TRUE;
+                break;
+            }
+
+            if (nh->nlmsg_type == NLMSG_ERROR)
+            {
+                err = NLMSG_DATA(nh);
+                if (err->error != 0)
+                {
+                    te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, -err->error),
+                                     "netlink request failed");
+                    rc = -1;
+                }
+                done = TRUE;
+                break;
+            }
+
+            memset(tb, 0, sizeof(tb));
+            nla = (struct nlattr *)((uint8_t *)NLMSG_DATA(nh) +
+                                    GENL_HDRLEN);
+            attrs_len = nh->nlmsg_len - NLMSG_LENGTH(GENL_HDRLEN);
+            while (attrs_len >= (int)sizeof(*nla) &&
+                   nla->nla_len >= sizeof(*nla) &&
+                   nla->nla_len <= attrs_len)
+            {
+                if ((nla->nla_type & NLA_TYPE_MASK) <= max)
+                    tb[nla->nla_type & NLA_TYPE_MASK] = nla;
+
+                attrs_len -= NLA_ALIGN(nla->nla_len);
+                nla = (struct nlattr *)((uint8_t *)nla +
+                                        NLA_ALIGN(nla->nla_len));
+            }
+
+            cb(tb, max, ctx);
+
+            if (!(nh->nlmsg_flags & NLM_F_MULTI))
+                done = TRUE;
+        }
+    }
+
+    free(buf);
+    return rc;
+}
+
+/** Save ID of generic netlink family from CTRL_CMD_GETFAMILY reply */
+static void
+genl_family_id_cb(struct nlattr **tb, unsigned int max, void *ctx)
+{
+    UNUSED(max);
+
+    if (tb[CTRL_ATTR_FAMILY_ID] != NULL)
+        *(uint16_t *)ctx = genl_attr_uint(tb[CTRL_ATTR_FAMILY_ID]);
+}
+
+/** Totals of page pools of an interface */
+typedef struct page_pools_ctx {
+    unsigned int ifindex;   /**< Interface index */
+    int64_t pools;          /**< Number of page pools */
+    uint64_t inflight;      /**< Pages in flight */
+    uint64_t inflight_mem;  /**< Memory in flight, in bytes */
+} page_pools_ctx;
+
+/** Add a page pool from NETDEV_CMD_PAGE_POOL_GET dump to totals */
+static void
+page_pools_cb(struct nlattr **tb, unsigned int max, void *ctx)
+{
+    page_pools_ctx *pp = ctx;
+
+    UNUSED(max);
+
+    /* Pools of unregistered devices have no ifindex */
+    if (tb[NETDEV_A_PAGE_POOL_IFINDEX] == NULL ||
+        genl_attr_uint(tb[NETDEV_A_PAGE_POOL_IFINDEX]) != pp->ifindex)
+        return;
+
+    pp->pools++;
+    if (tb[NETDEV_A_PAGE_POOL_INFLIGHT] != NULL)
+        pp->inflight += genl_attr_uint(tb[NETDEV_A_PAGE_POOL_INFLIGHT]);
+    if (tb[NETDEV_A_PAGE_POOL_INFLIGHT_MEM] != NULL)
+    {
+        pp->inflight_mem +=
+            genl_attr_uint(tb[NETDEV_A_PAGE_POOL_INFLIGHT_MEM]);
+    }
+}
+
+/*
+ * Get number of page pools of an interface and total number of pages
+ * and bytes they hold (in flight).
+ */
+static int64_t
+page_pools(tarpc_net_drv_page_pools_in *in,
+           tarpc_net_drv_page_pools_out *out)
+{
+    struct sockaddr_nl addr;
+    page_pools_ctx pp;
+    genl_req req;
+    uint16_t family = 0;
+    int64_t result = -1;
+    int s;
+
+    memset(&pp, 0, sizeof(pp));
+    pp.ifindex = if_nametoindex(in->if_name);
+    if (pp.ifindex == 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to get index of %s", in->if_name);
+        return -1;
+    }
+
+    s = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_GENERIC);
+    if (s < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to create netlink socket");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    if (connect(s, SA(&addr), sizeof(addr)) < 0)
+    {
+        te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                         "failed to connect netlink socket");
+        goto finish;
+    }
+
+    genl_req_init(&req, GENL_ID_CTRL, 0, CTRL_CMD_GETFAMILY, 1);
+    genl_req_add_str(&req, CTRL_ATTR_FAMILY_NAME, NETDEV_FAMILY_NAME);
+    if (genl_transact(s, &req, CTRL_ATTR_MAX, genl_family_id_cb,
+                      &family) < 0)
+        goto finish;
+
+    if (family == 0)
+    {
+        te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_ENOENT),
+                         "netdev generic netlink family is not found");
+        goto finish;
+    }
+
+    genl_req_init(&req, family, NLM_F_DUMP, NETDEV_CMD_PAGE_POOL_GET,
+                  NETDEV_FAMILY_VERSION);
+    if (genl_transact(s, &req, NETDEV_A_PAGE_POOL_MAX, page_pools_cb,
+                      &pp) < 0)
+        goto finish;
+
+    out->inflight = pp.inflight;
+    out->inflight_mem = pp.inflight_mem;
+    result = pp.pools;
+
+finish:
+
+    close(s);
+    return result;
+}
+
+#else
+
+static int64_t
+page_pools(tarpc_net_drv_page_pools_in *in,
+           tarpc_net_drv_page_pools_out *out)
+{
+    UNUSED(in);
+    UNUSED(out);
+
+    te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EOPNOTSUPP),
+                     "page pool netlink interface is not supported");
+    return -1;
+}
+
+#endif
+
+TARPC_FUNC_STANDALONE(net_drv_page_pools, {},
+{
+    MAKE_CALL(out->retval = page_pools(in, out));
+})